@@ -0,0 +1,77 @@
+/**
+ * @file I2CRecordService.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Serviço que grava as transações do I2Cdev em RAM e envia o log pela
+ * serial, para reprodução no host (tools/i2c_replay.cpp).
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include "Framing.h"
+#include "I2CLogProtocol.h"
+#include "I2CdevRecorder.h"
+#include "IMUSensorLib.h"
+
+#define I2C_RECORD_SIZE 32768       // Memória do log (bytes): o boot e alguns segundos de FIFO.
+#define I2C_RECORD_BLOCKS_PER_HANDLE 8 // Quadros enviados a cada iteração do serviço (não enche o Logger).
+
+/**
+ * @brief Classe que contém os atributos e métodos
+ * do serviço de gravação do barramento I2C.
+ */
+class I2CRecordClass
+{
+public:
+    /**
+     * @brief Aloca a memória do log. Chamado pelo primeiro start() caso
+     * não tenha sido chamado antes.
+     * @param capacity Tamanho do log (bytes).
+     * @return true - Caso a memória tenha sido alocada.
+     * @return false - Caso contrário.
+     */
+    bool begin(size_t capacity = I2C_RECORD_SIZE);
+
+    /**
+     * @brief Descarta o log anterior e passa a gravar todas as
+     * transações que chegam ao barramento.
+     */
+    void start();
+
+    /**
+     * @brief Para a gravação e imprime o resumo do log.
+     *
+     */
+    void stop();
+
+    /**
+     * @brief Para a gravação e começa a enviar o log em quadros
+     * I2CLOG_FRAME_BLOCK, aos poucos, em handle().
+     */
+    void dump();
+
+    /**
+     * @brief Itera o serviço, enviando os quadros pendentes do log.
+     *
+     */
+    void handle();
+
+private:
+    /**
+     * @brief Tap do I2Cdev: grava a transação com o tempo atual.
+     *
+     */
+    static void tap(uint8_t devAddr, uint8_t regAddr, uint8_t flags, uint16_t length, const void *data, void *context);
+
+    I2Cdev_Recorder m_recorder; // Log das transações.
+    uint8_t *m_buffer = NULL;   // Memória do log.
+    bool m_dumping = false;     // Envio do log em andamento.
+    uint16_t m_nextBlock = 0;   // Próximo bloco a ser enviado.
+};
+
+extern I2CRecordClass I2CRecord;
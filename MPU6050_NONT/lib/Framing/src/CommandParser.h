@@ -0,0 +1,127 @@
+/**
+ * @file CommandParser.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Interpretador incremental dos quadros de comando recebidos pela serial.
+ * Não depende do Arduino para poder ser usado também no host.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Quadro (CRC em little-endian):
+ * [Início 0xA5 (1)] [Tamanho (1)] [Comando (Tamanho)] [CRC-16 (2)]
+ *
+ * O CRC-16/CCITT-FALSE cobre o byte de tamanho e o comando. Bytes recebidos
+ * fora de um quadro são ignorados até o próximo byte de início. Um quadro
+ * incompleto é descartado após COMMAND_FRAME_TIMEOUT de silêncio (ver idle()).
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define COMMAND_START_OF_FRAME 0xA5 // Byte que inicia um quadro de comando.
+#define COMMAND_MAX_PAYLOAD 64      // Tamanho máximo do comando dentro do quadro.
+#define COMMAND_FRAME_TIMEOUT 100   // Silêncio máximo no meio de um quadro, contado a partir da primeira consulta sem bytes novos (ms).
+#define COMMAND_FRAME_OVERHEAD 4    // Início, tamanho e CRC.
+
+/**
+ * @brief Monta o quadro de um comando (ou de uma resposta).
+ *
+ * @param payload Bytes do comando.
+ * @param length Tamanho do comando (1 a COMMAND_MAX_PAYLOAD).
+ * @param output Buffer de saída com pelo menos length + COMMAND_FRAME_OVERHEAD bytes.
+ * @return size_t - Tamanho do quadro (0 caso o tamanho seja inválido).
+ */
+size_t commandEncode(const uint8_t *payload, uint8_t length, uint8_t *output);
+
+/**
+ * @brief Estados do interpretador de quadros.
+ *
+ */
+enum CommandParserState_e
+{
+    // Aguardando o byte de início.
+    PARSER_WAIT_START = 0,
+    // Aguardando o tamanho do comando.
+    PARSER_WAIT_LENGTH,
+    // Recebendo o comando.
+    PARSER_WAIT_PAYLOAD,
+    // Aguardando o byte menos significativo do CRC.
+    PARSER_WAIT_CRC_LOW,
+    // Aguardando o byte mais significativo do CRC.
+    PARSER_WAIT_CRC_HIGH
+};
+
+/**
+ * @brief Classe que monta os quadros de comando byte a byte sobre
+ * um buffer fixo, sem alocação e sem bloqueio.
+ */
+class CommandParser
+{
+public:
+    CommandParser();
+
+    /**
+     * @brief Descarta o quadro parcialmente recebido.
+     *
+     */
+    void reset();
+
+    /**
+     * @brief Processa um byte recebido.
+     *
+     * @param byte Byte recebido.
+     * @return true - Um quadro válido foi concluído (ver getPayload()).
+     * @return false - O quadro ainda não foi concluído ou foi descartado.
+     */
+    bool feed(uint8_t byte);
+
+    /**
+     * @brief Informa que uma consulta à serial não encontrou bytes novos. O tempo
+     * do quadro incompleto só corre a partir da primeira consulta vazia: um quadro
+     * dividido entre duas consultas não é descartado, por maior que seja o intervalo
+     * entre elas.
+     * @param now Tempo atual (ms).
+     */
+    void idle(uint32_t now);
+
+    /**
+     * @brief Retorna o comando do último quadro válido.
+     *
+     * @return const uint8_t* - Bytes do comando.
+     */
+    const uint8_t *getPayload() const;
+
+    /**
+     * @brief Retorna o tamanho do comando do último quadro válido.
+     *
+     * @return uint8_t - Quantidade de bytes do comando.
+     */
+    uint8_t getLength() const;
+
+    /**
+     * @brief Retorna a quantidade de quadros descartados por CRC inválido.
+     *
+     * @return uint32_t - Quadros descartados.
+     */
+    uint32_t getCRCErrors() const;
+
+    /**
+     * @brief Retorna a quantidade de quadros descartados por tamanho
+     * inválido ou por estourarem o tempo entre bytes.
+     * @return uint32_t - Quadros descartados.
+     */
+    uint32_t getFramingErrors() const;
+
+private:
+    uint8_t m_payload[COMMAND_MAX_PAYLOAD]; // Comando em recepção.
+    uint8_t m_length;                       // Tamanho esperado do comando.
+    uint8_t m_received;                     // Bytes do comando já recebidos.
+    uint16_t m_crc;                         // CRC recebido.
+    uint32_t m_idleSince;                   // Tempo da primeira consulta vazia com um quadro incompleto (ms).
+    bool m_idle;                            // Houve uma consulta vazia desde o último byte.
+    uint32_t m_crcErrors;                   // Quadros com CRC inválido.
+    uint32_t m_framingErrors;               // Quadros com tamanho inválido ou incompletos.
+    CommandParserState_e m_state;           // Estado atual do interpretador.
+};
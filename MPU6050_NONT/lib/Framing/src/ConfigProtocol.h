@@ -0,0 +1,100 @@
+/**
+ * @file ConfigProtocol.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Definição do protocolo versionado de configuração, compartilhada
+ * entre o firmware e as ferramentas do host.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Os comandos e as respostas trafegam dentro dos quadros do CommandParser
+ * (inteiros em little-endian):
+ *
+ * Comando:  [60] [Versão (1)] [Operação (1)] [Sequência (1)] [Argumentos...]
+ * Resposta: [61] [Versão (1)] [Operação (1)] [Sequência (1)] [Status (1)] [Dados...]
+ *
+ * A sequência é escolhida pelo host e devolvida na resposta. Toda operação
+ * recebe exatamente uma resposta, mesmo quando falha.
+ *
+ * CONFIG_OP_SET_SETTINGS: argumentos e dados de CONFIG_OP_GET_SETTINGS são uma
+ * lista de pares [Parâmetro (1)] [Valor (int32)]. Os pares são validados antes
+ * de qualquer alteração e aplicados de uma só vez; se algum for inválido nada
+ * é alterado e os dados da resposta contêm o parâmetro rejeitado.
+ *
+ * CONFIG_OP_GET_OFFSETS: 6 x int16 (acelerômetro X, Y, Z e giroscópio X, Y, Z).
+ * CONFIG_OP_GET_RATE:    2 x uint32 (taxa em centésimos de Hz e intervalo mediano em us).
+ * CONFIG_OP_GET_STATS:   CONFIG_STATS_COUNT x uint32, na ordem de IMUHealth_t.
+ * CONFIG_OP_GET_BUS_STATS: argumento opcional [Faixa (1)] (0 se ausente); dados
+ * [Faixas (1)] [Endereço (1)] [Primeiro registrador (1)] [Último registrador (1)]
+ * [Transações, Bytes, Tempo no barramento (us), Erros, Tempos limite: 5 x uint32]
+ * [Utilização do barramento (uint16, centésimos de %)]. A faixa 0 acumula o
+ * tráfego que não pertence a nenhuma outra.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#define CONFIG_COMMAND 0x60          // Primeiro byte de um comando de configuração.
+#define CONFIG_RESPONSE 0x61         // Primeiro byte de uma resposta de configuração.
+#define CONFIG_PROTOCOL_VERSION 0x01 // Versão atual do protocolo.
+
+#define CONFIG_HEADER_SIZE 4   // Comando, versão, operação e sequência.
+#define CONFIG_ITEM_SIZE 5     // Parâmetro e valor.
+#define CONFIG_STATS_COUNT 14  // Contadores retornados por CONFIG_OP_GET_STATS.
+
+#define CONFIG_INTERVAL_SCALE 1000.0 // Intervalos de aceleração em milésimos de g.
+#define CONFIG_ANGLE_SCALE 100.0     // Ângulos em centésimos de grau.
+
+/**
+ * @brief Operações do protocolo de configuração.
+ *
+ */
+enum ConfigOperation_e
+{
+    CONFIG_OP_SET_SETTINGS = 0x01,
+    CONFIG_OP_GET_SETTINGS = 0x02,
+    CONFIG_OP_GET_OFFSETS = 0x03,
+    CONFIG_OP_GET_RATE = 0x04,
+    CONFIG_OP_GET_STATS = 0x05,
+    CONFIG_OP_GET_BUS_STATS = 0x06
+};
+
+/**
+ * @brief Parâmetros de detecção configuráveis.
+ *
+ */
+enum ConfigParameter_e
+{
+    // Amostras mínimas do tombamento (0 a 65535).
+    CONFIG_TIPPING_MIN_SAMPLES = 0x01,
+    // Limiar de início do tombamento (centésimos de grau, 0 a 18000).
+    CONFIG_TIPPING_THRESHOLD = 0x02,
+    // Amostras mínimas do movimento (0 a 255).
+    CONFIG_MOVEMENT_MIN_SAMPLES = 0x03,
+    // Intervalo de aceleração do movimento (milésimos de g, 0 a 1000).
+    CONFIG_MOVEMENT_INTERVAL = 0x04,
+    // Amostras mínimas da parada (0 a 255).
+    CONFIG_STOP_MIN_SAMPLES = 0x05,
+    // Intervalo de aceleração da parada (milésimos de g, 0 a 1000).
+    CONFIG_STOP_INTERVAL = 0x06,
+    // Amostras mínimas do tamper (0 a 255).
+    CONFIG_TAMPER_MIN_SAMPLES = 0x07,
+    // Tempo do tamper (segundos, 0 a 255).
+    CONFIG_TAMPER_TIME = 0x08
+};
+
+/**
+ * @brief Status devolvido nas respostas.
+ *
+ */
+enum ConfigStatus_e
+{
+    CONFIG_STATUS_OK = 0x00,
+    CONFIG_STATUS_UNSUPPORTED_VERSION = 0x01,
+    CONFIG_STATUS_UNKNOWN_OPERATION = 0x02,
+    CONFIG_STATUS_MALFORMED = 0x03,
+    CONFIG_STATUS_UNKNOWN_PARAMETER = 0x04,
+    CONFIG_STATUS_OUT_OF_RANGE = 0x05,
+    CONFIG_STATUS_NOT_READY = 0x06
+};
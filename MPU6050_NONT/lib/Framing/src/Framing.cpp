@@ -0,0 +1,80 @@
+/**
+ * @file Framing.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Arquivo de implementação das funções de enquadramento.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Framing.h"
+
+uint16_t crc16CCITT(const uint8_t *data, size_t length, uint16_t crc)
+{
+    for(size_t i = 0; i < length; i++)
+    {
+        crc ^= (uint16_t)data[i] << 8;
+        for(uint8_t bit = 0; bit < 8; bit++)
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+    }
+
+    return crc;
+}
+
+size_t cobsEncode(const uint8_t *input, size_t length, uint8_t *output)
+{
+    size_t codeIndex = 0;
+    size_t outIndex = 1;
+    uint8_t code = 1;
+
+    for(size_t i = 0; i < length; i++)
+    {
+        if(input[i] != 0)
+        {
+            output[outIndex++] = input[i];
+            code++;
+        }
+
+        if(input[i] == 0 || code == 0xFF)
+        {
+            output[codeIndex] = code;
+            code = 1;
+            codeIndex = outIndex;
+
+            // Um bloco cheio no fim da mensagem não precisa de um novo código.
+            if(input[i] == 0 || (i + 1) < length)
+                outIndex++;
+        }
+    }
+
+    output[codeIndex] = code;
+
+    return outIndex;
+}
+
+size_t cobsDecode(const uint8_t *input, size_t length, uint8_t *output)
+{
+    size_t inIndex = 0;
+    size_t outIndex = 0;
+
+    while(inIndex < length)
+    {
+        uint8_t code = input[inIndex++];
+
+        if(code == 0 || (inIndex + code - 1) > length)
+            return 0;
+
+        for(uint8_t i = 1; i < code; i++)
+        {
+            if(input[inIndex] == 0)
+                return 0;
+            output[outIndex++] = input[inIndex++];
+        }
+
+        if(code != 0xFF && inIndex < length)
+            output[outIndex++] = 0;
+    }
+
+    return outIndex;
+}
@@ -0,0 +1,28 @@
+/**
+ * @file I2CLogProtocol.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Definição do quadro binário que transporta o log de transações I2C
+ * (I2CdevRecorder.h) do firmware para o host.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Quadro (antes da codificação COBS, inteiros em little-endian):
+ * [Tipo (1)] [Bloco (2)] [Blocos (2)] [Dados (até I2CLOG_BLOCK_SIZE)] [CRC-16 (2)]
+ *
+ * O log é enviado em blocos numerados de 0 a (Blocos - 1); concatenados em ordem
+ * eles formam o log completo, com o cabeçalho. O CRC-16/CCITT-FALSE cobre todos os
+ * bytes anteriores a ele. Cada quadro codificado é precedido e seguido pelo
+ * delimitador 0x00, para que o texto do Logger entre dois quadros seja descartado.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#define I2CLOG_FRAME_BLOCK 0x02 // Tipo do quadro (ao lado dos quadros de telemetria, 0x01).
+
+#define I2CLOG_BLOCK_SIZE 128   // Bytes do log por quadro.
+#define I2CLOG_HEADER_SIZE 5    // Tipo, bloco e total de blocos.
+#define I2CLOG_CRC_SIZE 2       // CRC-16 no fim do quadro.
+#define I2CLOG_MAX_FRAME_SIZE (I2CLOG_HEADER_SIZE + I2CLOG_BLOCK_SIZE + I2CLOG_CRC_SIZE)
@@ -0,0 +1,175 @@
+/**
+ * @file I2CdevQueue.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Arquivo de implementação das funções da classe I2Cdev_Queue.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <stddef.h>
+
+#include "I2CdevQueue.h"
+
+/**
+ * @brief Converte palavras da memória para a ordem do barramento (MSB primeiro), no próprio buffer.
+ *
+ */
+static void wordsToBus(void *data, uint16_t length)
+{
+    uint16_t *words = (uint16_t *)data;
+    uint8_t *bytes = (uint8_t *)data;
+    for(uint16_t i = 0; i < length; i++)
+    {
+        uint16_t word = words[i];
+        bytes[2 * i] = (uint8_t)(word >> 8);
+        bytes[2 * i + 1] = (uint8_t)word;
+    }
+}
+
+/**
+ * @brief Converte palavras na ordem do barramento de volta para a memória, no próprio buffer.
+ *
+ */
+static void wordsFromBus(void *data, uint16_t length)
+{
+    uint16_t *words = (uint16_t *)data;
+    uint8_t *bytes = (uint8_t *)data;
+    for(uint16_t i = 0; i < length; i++)
+        words[i] = (uint16_t)((bytes[2 * i] << 8) | bytes[2 * i + 1]);
+}
+
+I2Cdev_Queue::I2Cdev_Queue(I2Cdev_Bus *bus)
+{
+    m_bus = bus;
+    m_head = 0;
+    m_count = 0;
+    m_highWaterMark = 0;
+}
+
+void I2Cdev_Queue::setBus(I2Cdev_Bus *bus)
+{
+    m_bus = bus;
+}
+
+void I2Cdev_Queue::prepare(I2Cdev_Transaction *transaction, uint8_t devAddr, uint8_t regAddr, uint8_t flags,
+                           uint16_t length, void *data, I2Cdev_Callback callback, void *context)
+{
+    transaction->devAddr = devAddr;
+    transaction->regAddr = regAddr;
+    transaction->flags = flags;
+    transaction->length = length;
+    transaction->data = data;
+    transaction->callback = callback;
+    transaction->context = context;
+    transaction->tag = 0;
+    transaction->status = I2CDEV_TRANSACTION_IDLE;
+}
+
+bool I2Cdev_Queue::submit(I2Cdev_Transaction *transaction)
+{
+    if(m_count >= I2CDEV_QUEUE_LENGTH)
+        return false;
+
+    if(transaction->status == I2CDEV_TRANSACTION_PENDING || transaction->status == I2CDEV_TRANSACTION_RUNNING)
+        return false;
+
+    transaction->status = I2CDEV_TRANSACTION_PENDING;
+    m_ring[(m_head + m_count) % I2CDEV_QUEUE_LENGTH] = transaction;
+    m_count++;
+    if(m_count > m_highWaterMark)
+        m_highWaterMark = m_count;
+
+    return true;
+}
+
+I2Cdev_Transaction *I2Cdev_Queue::next()
+{
+    while(m_count > 0)
+    {
+        I2Cdev_Transaction *transaction = m_ring[m_head];
+        m_head = (m_head + 1) % I2CDEV_QUEUE_LENGTH;
+        m_count--;
+
+        if(transaction != NULL)
+        {
+            transaction->status = I2CDEV_TRANSACTION_RUNNING;
+            return transaction;
+        }
+    }
+
+    return NULL;
+}
+
+bool I2Cdev_Queue::execute(I2Cdev_Transaction *transaction)
+{
+    if(m_bus == NULL)
+        return false;
+
+    bool read = (transaction->flags & I2CDEV_TRANSACTION_READ) != 0;
+    bool words = (transaction->flags & I2CDEV_TRANSACTION_WORDS) != 0;
+    uint16_t bytes = words ? transaction->length * 2 : transaction->length;
+
+    if(words && !read)
+        wordsToBus(transaction->data, transaction->length);
+
+    bool success = m_bus->transfer(transaction->devAddr, transaction->regAddr, read, (uint8_t *)transaction->data, bytes);
+
+    // Na escrita o buffer de quem enviou é restaurado; na leitura, convertido se a leitura foi completa.
+    if(words && (!read || success))
+        wordsFromBus(transaction->data, transaction->length);
+
+    return success;
+}
+
+void I2Cdev_Queue::complete(I2Cdev_Transaction *transaction, bool success)
+{
+    transaction->status = success ? I2CDEV_TRANSACTION_DONE : I2CDEV_TRANSACTION_FAILED;
+    if(transaction->callback != NULL)
+        transaction->callback(transaction, transaction->context);
+}
+
+bool I2Cdev_Queue::cancel(I2Cdev_Transaction *transaction)
+{
+    if(transaction->status != I2CDEV_TRANSACTION_PENDING)
+        return false;
+
+    // A posição fica vazia até next() passar por ela: a transação (e o buffer) já podem ser liberados.
+    for(uint8_t i = 0; i < m_count; i++)
+    {
+        uint8_t index = (m_head + i) % I2CDEV_QUEUE_LENGTH;
+        if(m_ring[index] == transaction)
+        {
+            m_ring[index] = NULL;
+            transaction->status = I2CDEV_TRANSACTION_CANCELED;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+uint16_t I2Cdev_Queue::service(uint16_t maxTransactions)
+{
+    uint16_t executed = 0;
+    I2Cdev_Transaction *transaction;
+
+    while(executed < maxTransactions && (transaction = next()) != NULL)
+    {
+        complete(transaction, execute(transaction));
+        executed++;
+    }
+
+    return executed;
+}
+
+uint8_t I2Cdev_Queue::pending()
+{
+    return m_count;
+}
+
+uint8_t I2Cdev_Queue::getHighWaterMark()
+{
+    return m_highWaterMark;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file I2CdevQueue.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Fila de transações I2C do backend assíncrono do I2Cdev (I2CDEV_ESP32_ASYNC).
+ * Não depende do Arduino, do FreeRTOS nem do driver: o barramento é uma interface
+ * (I2Cdev_Bus), o que permite executar a fila no host contra um barramento simulado.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * As transações pertencem a quem as envia: a fila guarda apenas ponteiros, e a
+ * transação e o seu buffer precisam continuar válidos até a conclusão. A fila é
+ * atendida em ordem de envio; a sincronização entre tasks fica a cargo de quem a
+ * usa (ver I2CdevAsync.h).
+ */
+#ifndef _I2CDEV_QUEUE_H_
+#define _I2CDEV_QUEUE_H_
+
+#include <stdint.h>
+
+#ifndef I2CDEV_QUEUE_LENGTH
+#define I2CDEV_QUEUE_LENGTH 8 // Transações aguardando o barramento.
+#endif
+
+#define I2CDEV_TRANSACTION_READ  0x01 // Leitura (caso contrário, escrita).
+#define I2CDEV_TRANSACTION_WORDS 0x02 // Dados em palavras de 16 bits, MSB primeiro no barramento.
+
+/**
+ * @brief Estados de uma transação.
+ *
+ */
+enum I2Cdev_TransactionStatus
+{
+    I2CDEV_TRANSACTION_IDLE = 0, // Ainda não enviada.
+    I2CDEV_TRANSACTION_PENDING,  // Na fila.
+    I2CDEV_TRANSACTION_RUNNING,  // No barramento.
+    I2CDEV_TRANSACTION_DONE,     // Concluída com sucesso.
+    I2CDEV_TRANSACTION_FAILED,   // Sem ACK, erro ou tempo limite do barramento.
+    I2CDEV_TRANSACTION_CANCELED  // Retirada da fila antes de ir para o barramento.
+};
+
+struct I2Cdev_Transaction;
+
+/**
+ * @brief Função chamada ao fim de uma transação, no contexto de quem atende a fila.
+ *
+ */
+typedef void (*I2Cdev_Callback)(I2Cdev_Transaction *transaction, void *context);
+
+/**
+ * @brief Transação I2C: escrita ou leitura de registradores consecutivos.
+ *
+ */
+struct I2Cdev_Transaction
+{
+    uint8_t devAddr;          // Endereço do dispositivo.
+    uint8_t regAddr;          // Primeiro registrador.
+    uint8_t flags;            // I2CDEV_TRANSACTION_READ / I2CDEV_TRANSACTION_WORDS.
+    uint16_t length;          // Quantidade de bytes ou de palavras.
+    void *data;               // Buffer de origem (escrita) ou destino (leitura).
+    I2Cdev_Callback callback; // Chamada ao concluir (opcional).
+    void *context;            // Repassado ao callback.
+    uint32_t tag;             // Livre para quem atende a fila (ex.: bit de conclusão).
+    volatile uint8_t status;  // I2Cdev_TransactionStatus.
+};
+
+/**
+ * @brief Interface do barramento que executa as transações.
+ *
+ */
+class I2Cdev_Bus
+{
+public:
+    virtual ~I2Cdev_Bus() {}
+
+    /**
+     * @brief Executa uma transação completa, bloqueando até o fim.
+     *
+     * @param devAddr Endereço do dispositivo.
+     * @param regAddr Primeiro registrador.
+     * @param read Leitura (true) ou escrita (false).
+     * @param data Bytes na ordem do barramento.
+     * @param length Quantidade de bytes.
+     * @return true - Caso a transação tenha sido reconhecida e concluída.
+     * @return false - Caso contrário.
+     */
+    virtual bool transfer(uint8_t devAddr, uint8_t regAddr, bool read, uint8_t *data, uint16_t length) = 0;
+};
+
+/**
+ * @brief Fila circular de transações atendida em ordem de envio.
+ *
+ */
+class I2Cdev_Queue
+{
+public:
+    I2Cdev_Queue(I2Cdev_Bus *bus = 0);
+
+    /**
+     * @brief Define o barramento que executa as transações.
+     *
+     * @param bus Barramento real ou simulado.
+     */
+    void setBus(I2Cdev_Bus *bus);
+
+    /**
+     * @brief Prepara uma transação de leitura ou escrita.
+     *
+     */
+    static void prepare(I2Cdev_Transaction *transaction, uint8_t devAddr, uint8_t regAddr, uint8_t flags,
+                        uint16_t length, void *data, I2Cdev_Callback callback = 0, void *context = 0);
+
+    /**
+     * @brief Coloca uma transação no fim da fila.
+     *
+     * @param transaction Transação preparada (status IDLE ou já concluída).
+     * @return true - Caso a transação tenha entrado na fila.
+     * @return false - Caso a fila esteja cheia ou a transação ainda esteja em andamento.
+     */
+    bool submit(I2Cdev_Transaction *transaction);
+
+    /**
+     * @brief Retira a próxima transação da fila e a marca como RUNNING.
+     * Posições de transações canceladas são descartadas.
+     * @return I2Cdev_Transaction* - Próxima transação ou NULL se a fila estiver vazia.
+     */
+    I2Cdev_Transaction *next();
+
+    /**
+     * @brief Executa no barramento uma transação obtida por next().
+     *
+     * @param transaction Transação em RUNNING.
+     * @return true - Caso a transação tenha sido concluída.
+     * @return false - Caso contrário.
+     */
+    bool execute(I2Cdev_Transaction *transaction);
+
+    /**
+     * @brief Registra o resultado de uma transação e chama o callback.
+     *
+     * @param transaction Transação em RUNNING.
+     * @param success Resultado de execute().
+     */
+    void complete(I2Cdev_Transaction *transaction, bool success);
+
+    /**
+     * @brief Retira uma transação que ainda não foi para o barramento.
+     *
+     * @param transaction Transação enviada.
+     * @return true - Caso tenha sido cancelada (o buffer pode ser liberado).
+     * @return false - Caso já esteja no barramento ou concluída.
+     */
+    bool cancel(I2Cdev_Transaction *transaction);
+
+    /**
+     * @brief Atende a fila no contexto atual: next(), execute() e complete().
+     *
+     * @param maxTransactions Máximo de transações atendidas.
+     * @return uint16_t - Transações executadas.
+     */
+    uint16_t service(uint16_t maxTransactions = 0xFFFF);
+
+    /**
+     * @brief Retorna a quantidade de transações na fila.
+     *
+     * @return uint8_t - Transações aguardando o barramento.
+     */
+    uint8_t pending();
+
+    /**
+     * @brief Retorna o maior número de transações já visto na fila.
+     *
+     * @return uint8_t - Pico de ocupação da fila.
+     */
+    uint8_t getHighWaterMark();
+
+private:
+    I2Cdev_Bus *m_bus;                                  // Barramento que executa as transações.
+    I2Cdev_Transaction *m_ring[I2CDEV_QUEUE_LENGTH];    // Transações em ordem de envio.
+    uint8_t m_head;                                     // Próxima posição a ser atendida.
+    uint8_t m_count;                                    // Transações na fila.
+    uint8_t m_highWaterMark;                            // Pico de ocupação.
+};
+
+#endif /* _I2CDEV_QUEUE_H_ */
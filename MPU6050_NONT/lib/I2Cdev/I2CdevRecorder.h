@@ -0,0 +1,254 @@
+/**
+ * @file I2CdevRecorder.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Gravação das transações do I2Cdev em um log binário compacto e reprodução
+ * desse log como barramento (I2Cdev_Bus). Não depende do Arduino: o mesmo código grava
+ * no firmware (pelo tap do I2Cdev) e reproduz no host.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Log (inteiros de tamanho variável em LEB128, 7 bits por byte, menos significativos primeiro):
+ * Cabeçalho: ['I'] ['2'] ['C'] ['R'] [Versão (1)]
+ * Registro:  [Flags (1)] [Delta de tempo em us (var)] [Endereço (1)] [Registrador (1)]
+ *            [Tamanho em bytes (var)] [Dados (Tamanho)]
+ *
+ * Os dados estão na ordem do barramento (palavras com o MSB primeiro): são os bytes
+ * escritos ou os lidos, inclusive em transações que falharam. O primeiro registro tem
+ * o delta em relação ao início da gravação.
+ */
+#ifndef _I2CDEV_RECORDER_H_
+#define _I2CDEV_RECORDER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "I2CdevQueue.h"
+
+#define I2CDEV_LOG_VERSION 1     // Versão atual do formato do log.
+#define I2CDEV_LOG_HEADER_SIZE 5 // Assinatura e versão.
+
+// Mesmos valores de I2CDEV_TAP_*, para que as flags do tap sejam repassadas diretamente.
+#define I2CDEV_LOG_READ 0x01   // Leitura (caso contrário, escrita).
+#define I2CDEV_LOG_FAILED 0x02 // Sem ACK, leitura incompleta ou tempo limite.
+#define I2CDEV_LOG_WORDS 0x04  // Apenas em record(): dados em palavras de 16 bits (não vai para o log).
+
+/**
+ * @brief Uma transação lida do log.
+ *
+ */
+struct I2Cdev_LogRecord
+{
+    uint32_t time;       // Tempo desde o início da gravação (us).
+    uint8_t flags;       // I2CDEV_LOG_READ / I2CDEV_LOG_FAILED.
+    uint8_t devAddr;     // Endereço do dispositivo.
+    uint8_t regAddr;     // Primeiro registrador.
+    uint16_t length;     // Quantidade de bytes.
+    const uint8_t *data; // Dados dentro do log.
+};
+
+/**
+ * @brief Grava as transações em um buffer fornecido por quem usa. Quando o buffer
+ * enche a gravação para, e o log continua válido até a última transação completa.
+ */
+class I2Cdev_Recorder
+{
+public:
+    I2Cdev_Recorder();
+
+    /**
+     * @brief Define o buffer do log e escreve o cabeçalho.
+     *
+     * @param buffer Memória do log.
+     * @param capacity Tamanho do buffer (bytes).
+     */
+    void begin(uint8_t *buffer, size_t capacity);
+
+    /**
+     * @brief Descarta o log atual e começa uma nova gravação.
+     *
+     * @param time Tempo atual (us), origem dos deltas.
+     */
+    void start(uint32_t time);
+
+    /**
+     * @brief Para a gravação, mantendo o log.
+     *
+     */
+    void stop();
+
+    /**
+     * @brief Retorna se a gravação está ativa.
+     *
+     * @return true - Caso as transações estejam sendo gravadas.
+     * @return false - Caso contrário.
+     */
+    bool isRecording();
+
+    /**
+     * @brief Grava uma transação. Com a gravação parada não faz nada.
+     *
+     * @param time Tempo da transação (us).
+     * @param flags I2CDEV_LOG_* (palavras são convertidas para a ordem do barramento).
+     * @param length Quantidade de bytes ou de palavras.
+     * @param data Dados escritos ou lidos.
+     */
+    void record(uint32_t time, uint8_t devAddr, uint8_t regAddr, uint8_t flags, uint16_t length, const void *data);
+
+    /**
+     * @brief Retorna o log gravado (cabeçalho incluído).
+     *
+     */
+    const uint8_t *getData();
+
+    /**
+     * @brief Retorna o tamanho do log gravado (bytes).
+     *
+     */
+    size_t getSize();
+
+    /**
+     * @brief Retorna a capacidade do buffer (bytes).
+     *
+     */
+    size_t getCapacity();
+
+    /**
+     * @brief Retorna a quantidade de transações gravadas.
+     *
+     */
+    uint32_t getRecords();
+
+    /**
+     * @brief Retorna se a gravação parou porque o buffer encheu.
+     *
+     * @return true - Caso uma transação não tenha cabido no buffer.
+     * @return false - Caso contrário.
+     */
+    bool isFull();
+
+private:
+    uint8_t *m_buffer;          // Memória do log.
+    size_t m_capacity;          // Tamanho do buffer.
+    size_t m_size;              // Bytes já gravados.
+    uint32_t m_lastTime;        // Tempo da última transação gravada.
+    uint32_t m_records;         // Transações gravadas.
+    bool m_full;                // Transação descartada por falta de espaço.
+    volatile bool m_recording;  // Gravação ativa.
+};
+
+/**
+ * @brief Percorre os registros de um log.
+ *
+ */
+class I2Cdev_LogReader
+{
+public:
+    I2Cdev_LogReader();
+
+    /**
+     * @brief Abre um log.
+     *
+     * @param data Log completo (cabeçalho incluído).
+     * @param size Tamanho do log.
+     * @return true - Caso o cabeçalho seja válido.
+     * @return false - Caso contrário.
+     */
+    bool begin(const uint8_t *data, size_t size);
+
+    /**
+     * @brief Lê o próximo registro.
+     *
+     * @param record Registro lido (os dados apontam para dentro do log).
+     * @return true - Caso haja um registro completo.
+     * @return false - Caso o log tenha acabado (ou esteja truncado, ver isTruncated()).
+     */
+    bool next(I2Cdev_LogRecord *record);
+
+    /**
+     * @brief Volta para o primeiro registro.
+     *
+     */
+    void rewind();
+
+    /**
+     * @brief Retorna se o último registro estava incompleto.
+     *
+     */
+    bool isTruncated();
+
+private:
+    const uint8_t *m_data;  // Log.
+    size_t m_size;          // Tamanho do log.
+    size_t m_position;      // Próximo byte a ser lido.
+    uint32_t m_time;        // Tempo do último registro.
+    bool m_truncated;       // Registro incompleto no fim do log.
+};
+
+/**
+ * @brief Barramento que reproduz um log: cada transação recebe a resposta do próximo
+ * registro. Leituras devolvem os bytes gravados; escritas são conferidas com o log.
+ */
+class I2Cdev_Replayer : public I2Cdev_Bus
+{
+public:
+    /**
+     * @brief Prepara a reprodução de um log.
+     *
+     * @param data Log completo; deve permanecer válido durante a reprodução.
+     * @param size Tamanho do log.
+     */
+    I2Cdev_Replayer(const uint8_t *data, size_t size);
+
+    bool transfer(uint8_t devAddr, uint8_t regAddr, bool read, uint8_t *data, uint16_t length) override;
+
+    /**
+     * @brief Retorna se o log foi aberto corretamente.
+     *
+     */
+    bool isValid();
+
+    /**
+     * @brief Retorna se todas as transações do log já foram reproduzidas.
+     *
+     */
+    bool isExhausted();
+
+    /**
+     * @brief Retorna o registro reproduzido por último.
+     *
+     */
+    const I2Cdev_LogRecord &getLastRecord();
+
+    /**
+     * @brief Retorna quantas transações foram reproduzidas.
+     *
+     */
+    uint32_t getReplayed();
+
+    /**
+     * @brief Retorna quantas transações divergiram do log (endereço, registrador,
+     * direção, tamanho ou bytes escritos). A primeira divergência indica onde o código
+     * reproduzido deixou de seguir a captura.
+     */
+    uint32_t getMismatches();
+
+    /**
+     * @brief Retorna o índice (a partir de 0) da primeira transação divergente.
+     *
+     * @return uint32_t - Índice, ou UINT32_MAX se não houve divergência.
+     */
+    uint32_t getFirstMismatch();
+
+private:
+    I2Cdev_LogReader m_reader;      // Registros do log.
+    I2Cdev_LogRecord m_last;        // Último registro reproduzido.
+    bool m_valid;                   // Cabeçalho válido.
+    bool m_exhausted;               // Log acabou.
+    uint32_t m_replayed;            // Transações reproduzidas.
+    uint32_t m_mismatches;          // Transações divergentes.
+    uint32_t m_firstMismatch;       // Primeira divergência.
+};
+
+#endif /* _I2CDEV_RECORDER_H_ */
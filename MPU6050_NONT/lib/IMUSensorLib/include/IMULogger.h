@@ -0,0 +1,125 @@
+/**
+ * @file IMULogger.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Saída serial não bloqueante: as mensagens são copiadas para um buffer
+ * circular pré-alocado e enviadas por uma task de escrita de baixa prioridade.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include "IMUSensorEnums.h"
+
+#define LOGGER_BUFFER_SIZE 4096  // Tamanho do buffer circular de transmissão (bytes).
+#define LOGGER_LINE_SIZE 256     // Tamanho máximo de uma mensagem formatada por printf().
+#define LOGGER_CHUNK_SIZE 128    // Bytes enviados à serial por vez pela task de escrita.
+#define LOGGER_TASK_STACK 3072   // Tamanho da pilha da task de escrita (bytes).
+#define LOGGER_TASK_PRIORITY 1   // Menor prioridade acima da task ociosa.
+
+/**
+ * @brief Classe que desacopla os produtores de mensagens da
+ * serial. Nenhum produtor espera pela UART: sem espaço no buffer,
+ * a política configurada decide o que é descartado.
+ */
+class LoggerClass : public Print
+{
+public:
+    /**
+     * @brief Inicia o buffer e a task de escrita.
+     * 
+     * @param output Saída onde as mensagens serão escritas.
+     * @param policy Política de descarte com o buffer cheio.
+     * @return true - Caso a task seja criada.
+     * @return false - Caso contrário.
+     */
+    bool begin(Print *output, LoggerPolicy_e policy = LOGGER_DROP_NEWEST);
+
+    /**
+     * @brief Formata uma mensagem e a coloca no buffer. Mensagens
+     * maiores que LOGGER_LINE_SIZE são truncadas.
+     * @param format Formato no padrão do printf.
+     * @return size_t - Bytes aceitos pelo buffer.
+     */
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+    /**
+     * @brief Coloca um byte no buffer.
+     * 
+     * @param data Byte.
+     * @return size_t - Bytes aceitos pelo buffer.
+     */
+    size_t write(uint8_t data) override;
+
+    /**
+     * @brief Coloca um bloco de bytes no buffer. Com a política
+     * LOGGER_DROP_NEWEST o bloco é aceito inteiro ou descartado inteiro.
+     * @param data Bytes.
+     * @param size Quantidade de bytes.
+     * @return size_t - Bytes aceitos pelo buffer.
+     */
+    size_t write(const uint8_t *data, size_t size) override;
+    using Print::write;
+
+    /**
+     * @brief Altera a política de descarte.
+     * 
+     * @param policy Nova política.
+     */
+    void setPolicy(LoggerPolicy_e policy);
+
+    /**
+     * @brief Retorna quantos bytes foram descartados.
+     * 
+     * @return uint32_t - Bytes descartados.
+     */
+    uint32_t getDroppedBytes();
+
+    /**
+     * @brief Retorna quantas escritas perderam dados.
+     * 
+     * @return uint32_t - Escritas com descarte.
+     */
+    uint32_t getDroppedMessages();
+
+    /**
+     * @brief Retorna a maior ocupação do buffer já registrada.
+     * 
+     * @return uint32_t - Ocupação máxima (bytes).
+     */
+    uint32_t getHighWaterMark();
+
+private:
+    /**
+     * @brief Task que esvazia o buffer na saída.
+     * 
+     * @param parameter Instância do Logger.
+     */
+    static void writerTask(void *parameter);
+
+    /**
+     * @brief Retira bytes do início do buffer.
+     * 
+     * @param data Destino.
+     * @param size Quantidade máxima de bytes.
+     * @return size_t - Bytes retirados.
+     */
+    size_t pop(uint8_t *data, size_t size);
+
+    uint8_t m_buffer[LOGGER_BUFFER_SIZE]; // Buffer circular de transmissão.
+    size_t m_head;                        // Posição da próxima escrita.
+    size_t m_tail;                        // Posição da próxima leitura.
+    size_t m_used;                        // Bytes aguardando envio.
+    Print *m_output;                      // Saída das mensagens.
+    TaskHandle_t m_task;                  // Task de escrita.
+    LoggerPolicy_e m_policy;              // Política de descarte.
+    uint32_t m_droppedBytes;              // Bytes descartados.
+    uint32_t m_droppedMessages;           // Escritas que perderam dados.
+    uint32_t m_highWaterMark;             // Maior ocupação do buffer.
+};
+
+extern LoggerClass Logger;
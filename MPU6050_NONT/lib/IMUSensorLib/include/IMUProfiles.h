@@ -0,0 +1,29 @@
+/**
+ * @file IMUProfiles.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Tabela constante (em flash) dos perfis de detecção pré-definidos.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include "IMUSensorStructs.h"
+
+/**
+ * @brief Perfil de detecção nomeado.
+ *
+ */
+struct IMUProfile_t
+{
+public:
+    const char *Name;                // Nome do perfil.
+    IMUDetectionSettings_t Settings; // Configurações de todos os detectores.
+};
+
+extern const IMUProfile_t g_profiles[IMU_PROFILE_COUNT]; // Perfis indexados por IMUProfile_e.
+
@@ -19,9 +19,17 @@
 
 #include "CircularBuffer.h"
 #include "I2Cdev.h"
+#include "IMUProfiler.h"
+#include "IMUProfiles.h"
 #include "IMUSensorStructs.h"
 
+#ifdef IMU_BENCHMARK
+#include "IMUBenchmark.h"
+#endif
+
 const int g_historySize = 100; // Tamanho do histórico de leituras do sensor.
+const int g_stateCount = STATE_TAMPER + 1; // Quantidade de estados do dispositivo.
+const int g_jitterWindow = 128; // Quantidade de intervalos entre amostras usada no cálculo do jitter.
 
 /**
  * @brief Superclasse de sensores IMU
@@ -96,10 +104,17 @@ protected:
      */
     bool checkConfigurations();
 
+    /**
+     * @brief Registra a chegada de um novo pacote para o
+     * cálculo do intervalo entre amostras.
+     */
+    void registerSample();
+
     bool m_tipped;                    // Flag de tombamento.
     bool m_moving;                    // Flag de movimento.
     bool m_tamper;                    // Flag de tamper.
     DeviceState_e m_devState;         // Estado atual do automóvel.
+    uint32_t m_samples;               // Pacotes lidos desde a inicialização.
 
 public:
     /**
@@ -136,6 +151,44 @@ public:
      * @param settings Configurações do detector de tamper.
      */
     void configureTamperDetection(IMUTamperSettings_t settings);
+
+    /**
+     * @brief Configurar todos os detectores de uma só vez, sem que a
+     * leitura observe uma configuração parcial.
+     * @param settings Configurações dos detectores.
+     */
+    void configure(const IMUDetectionSettings_t &settings);
+
+    /**
+     * @brief Retorna as configurações atuais dos detectores.
+     * 
+     * @return IMUDetectionSettings_t - Configurações dos detectores.
+     */
+    IMUDetectionSettings_t getSettings();
+
+    /**
+     * @brief Aplica um perfil de detecção da tabela em flash. O perfil
+     * passa a ser o perfil base, usado nos estados sem perfil associado,
+     * e descarta os ajustes feitos pelos configure*().
+     * @param profile Perfil de detecção.
+     */
+    void applyProfile(IMUProfile_e profile);
+
+    /**
+     * @brief Retorna o perfil de detecção em uso.
+     * 
+     * @return IMUProfile_e - Perfil em uso (IMU_PROFILE_NONE caso nenhum tenha sido aplicado).
+     */
+    IMUProfile_e getProfile();
+
+    /**
+     * @brief Associa um perfil a um estado do dispositivo. Ao entrar no
+     * estado o perfil é trocado automaticamente; ao sair, volta o perfil base.
+     * A troca fica suspensa após um configure*() até o próximo applyProfile().
+     * @param state Estado do dispositivo.
+     * @param profile Perfil do estado (IMU_PROFILE_NONE para usar o perfil base).
+     */
+    void setStateProfile(DeviceState_e state, IMUProfile_e profile);
     
     /**
      * @brief Retornar a última leitura dos eixos do acelerômetro
@@ -225,7 +278,22 @@ public:
      */
     virtual void setOffsets(IMUOffsets_t newOffsets) = 0;
 
+    /**
+     * @brief Retorna os contadores de saúde da leitura do sensor.
+     * A implementação base preenche a quantidade de amostras e os
+     * percentis do intervalo entre amostras.
+     * @param health Struct que armazenará os contadores.
+     */
+    virtual void getHealth(IMUHealth_t &health);
+
 private: 
+    /**
+     * @brief Troca o perfil em uso sem alterar o perfil base.
+     * 
+     * @param profile Perfil de detecção.
+     */
+    void selectProfile(IMUProfile_e profile);
+
     IMUTippingSettings_t m_tippingSettings;   // Configurações para a detecção de tombamento.
     IMUMovementSettings_t m_movementSettings; // Configurações para a detecção de movimento.
     IMUStopSettings_t m_stopSettings;         // Configurações para a detecção de parada.
@@ -235,4 +303,11 @@ private:
     IMUStopData_t m_stopData;           // Dados de parada.
     IMUTamperData_t m_tamperData;       // Dados de tamper.
     CircularBuffer <IMUAxisData_t, g_historySize> m_axisData; // Buffer circular com dados históricos das medidas do sensor.
+    uint32_t m_sampleIntervals[g_jitterWindow]; // Janela circular de intervalos entre amostras (us).
+    uint16_t m_intervalIndex;                   // Próxima posição da janela de intervalos.
+    unsigned long m_lastSampleTime;             // Micros() do último pacote registrado.
+    IMUProfile_e m_baseProfile;                 // Perfil escolhido em applyProfile().
+    IMUProfile_e m_activeProfile;               // Perfil em uso.
+    IMUProfile_e m_stateProfiles[g_stateCount]; // Perfil associado a cada estado do dispositivo.
+    bool m_settingsOverride;                    // Flag de ajustes feitos pelos configure*() sobre o perfil.
 };
\ No newline at end of file
@@ -11,11 +11,26 @@
 #pragma once
 
 #include "IMUSensor.h"
+#include "IMUGyroBias.h"
+#include "IMUOffsetStore.h"
+
+// Firmware do DMP escolhido na compilação. O MotionApps 6.12 (IMU_DMP_MOTIONAPPS612) entrega
+// pacotes de 28 bytes com acelerômetro e giroscópio brutos; o 2.0 (padrão), pacotes de 42 bytes.
+#ifdef IMU_DMP_MOTIONAPPS612
+#include "MPU6050_6Axis_MotionApps612.h"
+#define MPU6050_DMP_FIRMWARE "MotionApps 6.12"
+#else
 #include "MPU6050_6Axis_MotionApps20.h"
+#define MPU6050_DMP_FIRMWARE "MotionApps 2.0"
+#endif
 
 #define MPU6050_PIN_SDA GPIO_NUM_33 // Pino de comunicação com MPU6050
 #define MPU6050_PIN_SCL GPIO_NUM_32 // Pino de comunicação com MPU6050
 #define MPU6050_FREQUENCY 400000    // Frequência de comunicação com MPU6050
+#define MPU6050_FIFO_WAIT_TIMEOUT 50 // Espera máxima por um pacote do DMP antes de contar a amostra como falha (ms).
+#define MPU6050_RECOVERY_THRESHOLD 3 // Amostras seguidas com falha que disparam a recuperação do sensor.
+#define MPU6050_RECOVERY_INTERVAL 100 // Intervalo entre as tentativas de recuperação (ms).
+#define MPU6050_LOOP_TASK_STACK 8192 // Pilha da loopTask do Arduino, onde a leitura é feita (bytes)
 
 /**
  * @brief Classe com os métodos para o sensor
@@ -77,10 +92,104 @@ public:
      */
     void setOffsets(IMUOffsets_t newOffsets);
 
+    /**
+     * @brief Indica se os offsets em uso foram restaurados da NVS
+     * (ou salvos pela última calibração).
+     * @return true - Caso o sensor possua offsets salvos.
+     * @return false - Caso esteja usando os offsets padrão.
+     */
+    bool hasStoredOffsets();
+
+    /**
+     * @brief Retorna os contadores de saúde da leitura, incluindo
+     * os contadores do FIFO, do barramento I2C e o uso da pilha
+     * da task que realiza a leitura.
+     * @param health Struct que armazenará os contadores.
+     */
+    void getHealth(IMUHealth_t &health);
+
+    /**
+     * @brief Ativa ou desativa a correção do bias do giroscópio
+     * durante as paradas (ativada por padrão).
+     * @param enable Nova configuração.
+     */
+    void setGyroBiasTracking(bool enable);
+
+    /**
+     * @brief Retorna os contadores e a última estimativa do bias
+     * do giroscópio.
+     * @param data Struct que armazenará os dados.
+     */
+    void getGyroBiasData(IMUGyroBiasData_t &data);
+
+    /**
+     * @brief Retorna o modelo de temperatura do giroscópio aprendido.
+     *
+     * @param model Objeto que armazenará uma cópia do modelo.
+     */
+    void getGyroModel(GyroTemperatureModel &model);
+
 private:
+    /**
+     * @brief Acumula a amostra no estimador de bias enquanto o dispositivo
+     * está parado, alimentando o modelo de temperatura e aplicando os ajustes
+     * calculados; fora da parada aplica o modelo de temperatura.
+     * @param gyro Leituras brutas do giroscópio (X, Y, Z).
+     * @param temperature Temperatura do sensor (°C).
+     */
+    void trackGyroBias(const int16_t *gyro, float temperature);
+
+    /**
+     * @brief Soma um ajuste aos offsets do giroscópio.
+     *
+     * @param step Ajuste de cada eixo (LSB do offset).
+     */
+    void adjustGyroOffsets(const int16_t *step);
+
+    /**
+     * @brief Conta uma amostra com falha (erro no barramento ou sem pacote
+     * dentro do tempo) e, após MPU6050_RECOVERY_THRESHOLD seguidas, passa a
+     * recuperar o sensor em vez de ler.
+     */
+    void sampleFailed();
+
+    /**
+     * @brief Faz uma tentativa de recuperação, no máximo a cada
+     * MPU6050_RECOVERY_INTERVAL: libera o barramento, confirma o sensor e
+     * restaura o DMP e os offsets pelo caminho mais curto.
+     * @return true - Caso o sensor tenha voltado.
+     * @return false - Caso contrário (ou se ainda não for hora de tentar).
+     */
+    bool recoverSensor();
+
+    /**
+     * @brief Libera o barramento de um escravo que segura o SDA: até 9
+     * pulsos de SCL seguidos de um STOP, e reinicia a interface I2C.
+     */
+    void clearBus();
+
     MPU6050 m_mpu;               // Objeto da classe MPU6050 utilizado para acessar os métodos da lib.          
     uint8_t m_deviceStatus;      // Status de funcionamento dispositivo (== 0 -> Funcionando).
     bool m_dmpStatus;            // Status de funcionamento do DMP.
+    uint32_t m_fifoOverflows;    // Vezes em que o FIFO estourou antes da leitura.
+    uint32_t m_dmpInitTime;      // Duração da inicialização do DMP no boot (us).
+    bool m_warmStart;            // Flag que indica se o DMP foi reaproveitado no boot.
+    bool m_storedOffsets;        // Flag que indica se os offsets vieram da NVS.
+    bool m_gyroBiasTracking;     // Flag que ativa a correção do bias do giroscópio nas paradas.
+    GyroBiasEstimator m_gyroBias; // Estimador do bias do giroscópio.
+    GyroTemperatureModel m_gyroModel; // Offset ideal do giroscópio em função da temperatura.
+    uint32_t m_lastModelUpdate;  // Millis() da última aplicação do modelo de temperatura.
+    uint32_t m_lastModelSave;    // Millis() da última gravação do modelo na NVS.
+    TwoWire *m_wire;             // Interface I2C, reiniciada na recuperação do barramento.
+    IMUOffsets_t m_offsets;      // Offsets aplicados, restaurados se o sensor reiniciar.
+    uint8_t m_failedSamples;     // Amostras seguidas com falha.
+    bool m_recovering;           // Flag que indica que o sensor está sendo recuperado.
+    uint32_t m_outageStart;      // Millis() da primeira amostra com falha.
+    uint32_t m_lastRecoveryAttempt; // Millis() da última tentativa de recuperação.
+    uint32_t m_recoveryAttempts; // Tentativas da recuperação em andamento.
+    uint32_t m_recoveries;       // Recuperações concluídas.
+    uint32_t m_lastOutage;       // Duração da última perda do sensor (ms).
+    uint32_t m_totalOutage;      // Soma das durações das perdas (ms).
     int16_t m_deviceOffsets[6];  // Offsets configurados para o dispositivo [aX, aY, aZ, gX, gY, gZ].
 };
 
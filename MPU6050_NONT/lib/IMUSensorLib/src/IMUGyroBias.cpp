@@ -0,0 +1,218 @@
+/**
+ * @file IMUGyroBias.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Arquivo de implementação das funções das classes GyroBiasEstimator
+ * e GyroTemperatureModel.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <math.h>
+#include <string.h>
+
+#include "IMUGyroBias.h"
+
+GyroBiasEstimator::GyroBiasEstimator()
+{
+    memset(&m_data, 0, sizeof(m_data));
+    m_newWindow = false;
+    setRange(0);
+}
+
+void GyroBiasEstimator::setRange(uint8_t range)
+{
+    float lsbPerDps = GYRO_BIAS_LSB_PER_DPS / (1 << range);
+
+    m_offsetScale = GYRO_BIAS_OFFSET_SCALE / (1 << range);
+    m_noiseLimit = lroundf(GYRO_BIAS_NOISE_LIMIT * lsbPerDps);
+    m_deadband = GYRO_BIAS_DEADBAND * lsbPerDps;
+    reset();
+}
+
+float GyroBiasEstimator::getOffsetScale()
+{
+    return m_offsetScale;
+}
+
+void GyroBiasEstimator::reset()
+{
+    for(int i = 0; i < 3; i++)
+    {
+        m_sum[i] = 0;
+        m_min[i] = INT16_MAX;
+        m_max[i] = INT16_MIN;
+    }
+    m_temperatureSum = 0;
+    m_temperatureMin = 1000;
+    m_temperatureMax = -1000;
+    m_count = 0;
+    m_windowStart = 0;
+}
+
+bool GyroBiasEstimator::addSample(const int16_t *gyro, float temperature, uint32_t now, int16_t *step)
+{
+    if(m_count == 0)
+        m_windowStart = now;
+
+    for(int i = 0; i < 3; i++)
+    {
+        m_sum[i] += gyro[i];
+        if(gyro[i] < m_min[i]) m_min[i] = gyro[i];
+        if(gyro[i] > m_max[i]) m_max[i] = gyro[i];
+    }
+    m_temperatureSum += temperature;
+    if(temperature < m_temperatureMin) m_temperatureMin = temperature;
+    if(temperature > m_temperatureMax) m_temperatureMax = temperature;
+
+    if(++m_count < GYRO_BIAS_MIN_SAMPLES || now - m_windowStart < GYRO_BIAS_WINDOW_TIME)
+        return false;
+
+    bool still = (m_temperatureMax - m_temperatureMin) <= GYRO_BIAS_TEMPERATURE_LIMIT;
+    for(int i = 0; i < 3; i++)
+        still = still && (m_max[i] - m_min[i]) <= m_noiseLimit;
+
+    if(!still)
+    {
+        m_data.Rejected++;
+        reset();
+        return false;
+    }
+
+    m_data.Windows++;
+    for(int i = 0; i < 3; i++)
+        m_data.Bias[i] = (float)m_sum[i] / m_count;
+    m_data.Temperature = m_temperatureSum / m_count;
+    m_newWindow = true;
+    reset();
+
+    if(m_data.Corrections > 0 && (now - m_data.LastCorrection) < GYRO_BIAS_MIN_INTERVAL)
+        return false;
+
+    bool correct = false;
+    for(int i = 0; i < 3; i++)
+    {
+        step[i] = 0;
+        if(fabsf(m_data.Bias[i]) < m_deadband)
+            continue;
+
+        // O offset é somado à leitura: bias positivo pede offset menor.
+        int16_t value = (int16_t)lroundf(-m_data.Bias[i] / m_offsetScale);
+        if(value == 0) value = (m_data.Bias[i] > 0) ? -1 : 1;
+        if(value > GYRO_BIAS_MAX_STEP) value = GYRO_BIAS_MAX_STEP;
+        if(value < -GYRO_BIAS_MAX_STEP) value = -GYRO_BIAS_MAX_STEP;
+
+        step[i] = value;
+        correct = true;
+    }
+
+    if(correct)
+    {
+        m_data.Corrections++;
+        m_data.LastCorrection = now;
+    }
+
+    return correct;
+}
+
+IMUGyroBiasData_t GyroBiasEstimator::getData()
+{
+    return m_data;
+}
+
+bool GyroBiasEstimator::takeWindow()
+{
+    bool newWindow = m_newWindow;
+    m_newWindow = false;
+    return newWindow;
+}
+
+void GyroBiasEstimator::countModelCorrection()
+{
+    m_data.ModelCorrections++;
+}
+
+GyroTemperatureModel::GyroTemperatureModel()
+{
+    clear();
+}
+
+void GyroTemperatureModel::clear()
+{
+    memset(Nodes, 0, sizeof(Nodes));
+    m_dirty = false;
+}
+
+void GyroTemperatureModel::learn(float temperature, const float *offset)
+{
+    int index = (int)lroundf((temperature - GYRO_MODEL_MIN_TEMPERATURE) / GYRO_MODEL_NODE_SPACING);
+    if(index < 0 || index >= GYRO_MODEL_NODES)
+        return;
+
+    GyroModelNode_t &node = Nodes[index];
+    if(node.Weight < GYRO_MODEL_MAX_WEIGHT)
+        node.Weight++;
+
+    // Média das janelas até GYRO_MODEL_MAX_WEIGHT; depois, média móvel que acompanha o envelhecimento.
+    float weight = 1.0f / node.Weight;
+    node.Temperature += (temperature - node.Temperature) * weight;
+    for(int i = 0; i < 3; i++)
+        node.Offset[i] += (offset[i] - node.Offset[i]) * weight;
+
+    m_dirty = true;
+}
+
+bool GyroTemperatureModel::predict(float temperature, float *offset)
+{
+    const GyroModelNode_t *below = NULL;
+    const GyroModelNode_t *above = NULL;
+
+    for(int i = 0; i < GYRO_MODEL_NODES; i++)
+    {
+        if(Nodes[i].Weight == 0)
+            continue;
+
+        if(Nodes[i].Temperature <= temperature)
+            below = &Nodes[i];
+        else if(above == NULL)
+            above = &Nodes[i];
+    }
+
+    if(below == NULL && above == NULL)
+        return false;
+
+    if(below == NULL || above == NULL)
+    {
+        const GyroModelNode_t *node = (below != NULL) ? below : above;
+        for(int i = 0; i < 3; i++)
+            offset[i] = node->Offset[i];
+        return true;
+    }
+
+    float ratio = (temperature - below->Temperature) / (above->Temperature - below->Temperature);
+    for(int i = 0; i < 3; i++)
+        offset[i] = below->Offset[i] + (above->Offset[i] - below->Offset[i]) * ratio;
+
+    return true;
+}
+
+uint8_t GyroTemperatureModel::getNodeCount()
+{
+    uint8_t count = 0;
+    for(int i = 0; i < GYRO_MODEL_NODES; i++)
+        if(Nodes[i].Weight > 0)
+            count++;
+
+    return count;
+}
+
+bool GyroTemperatureModel::isDirty()
+{
+    return m_dirty;
+}
+
+void GyroTemperatureModel::setSaved()
+{
+    m_dirty = false;
+}
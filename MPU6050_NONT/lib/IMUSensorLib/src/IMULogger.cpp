@@ -0,0 +1,174 @@
+/**
+ * @file IMULogger.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Arquivo de implementação das funções da classe LoggerClass.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "IMULogger.h"
+
+portMUX_TYPE g_loggerMux = portMUX_INITIALIZER_UNLOCKED; // Proteção do buffer entre produtores e a task de escrita.
+
+bool LoggerClass::begin(Print *output, LoggerPolicy_e policy)
+{
+    m_output = output;
+    m_policy = policy;
+    m_head = m_tail = m_used = 0;
+    m_droppedBytes = m_droppedMessages = m_highWaterMark = 0;
+
+    if(m_task == NULL)
+        xTaskCreate(writerTask, "[Logger]writerTask", LOGGER_TASK_STACK, this, LOGGER_TASK_PRIORITY, &m_task);
+
+    return m_task != NULL;
+}
+
+size_t LoggerClass::printf(const char *format, ...)
+{
+    char line[LOGGER_LINE_SIZE];
+    va_list args;
+
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+
+    if(length <= 0)
+        return 0;
+
+    if(length >= (int)sizeof(line))
+        length = sizeof(line) - 1;
+
+    return write((const uint8_t *)line, length);
+}
+
+size_t LoggerClass::write(uint8_t data)
+{
+    return write(&data, 1);
+}
+
+size_t LoggerClass::write(const uint8_t *data, size_t size)
+{
+    // Antes do begin() não há task de escrita, então a saída é direta.
+    if(m_task == NULL)
+        return Serial.write(data, size);
+
+    size_t accepted = size;
+
+    portENTER_CRITICAL(&g_loggerMux);
+
+    if(size > (LOGGER_BUFFER_SIZE - m_used))
+    {
+        if(m_policy == LOGGER_DROP_NEWEST)
+        {
+            m_droppedBytes += size;
+            m_droppedMessages++;
+            accepted = 0;
+        }
+        else
+        {
+            // Apenas o final de um bloco maior que o buffer pode ser mantido.
+            if(size > LOGGER_BUFFER_SIZE)
+            {
+                m_droppedBytes += size - LOGGER_BUFFER_SIZE;
+                data += size - LOGGER_BUFFER_SIZE;
+                accepted = size = LOGGER_BUFFER_SIZE;
+            }
+
+            size_t overwrite = size - (LOGGER_BUFFER_SIZE - m_used);
+            if(overwrite > 0)
+            {
+                m_tail = (m_tail + overwrite) % LOGGER_BUFFER_SIZE;
+                m_used -= overwrite;
+                m_droppedBytes += overwrite;
+            }
+            m_droppedMessages++;
+        }
+    }
+
+    if(accepted > 0)
+    {
+        size_t first = LOGGER_BUFFER_SIZE - m_head;
+        if(first > size)
+            first = size;
+
+        memcpy(&m_buffer[m_head], data, first);
+        memcpy(m_buffer, data + first, size - first);
+        m_head = (m_head + size) % LOGGER_BUFFER_SIZE;
+        m_used += size;
+
+        if(m_used > m_highWaterMark)
+            m_highWaterMark = m_used;
+    }
+
+    portEXIT_CRITICAL(&g_loggerMux);
+
+    if(accepted > 0)
+        xTaskNotifyGive(m_task);
+
+    return accepted;
+}
+
+void LoggerClass::setPolicy(LoggerPolicy_e policy)
+{
+    m_policy = policy;
+}
+
+uint32_t LoggerClass::getDroppedBytes()
+{
+    return m_droppedBytes;
+}
+
+uint32_t LoggerClass::getDroppedMessages()
+{
+    return m_droppedMessages;
+}
+
+uint32_t LoggerClass::getHighWaterMark()
+{
+    return m_highWaterMark;
+}
+
+size_t LoggerClass::pop(uint8_t *data, size_t size)
+{
+    portENTER_CRITICAL(&g_loggerMux);
+
+    if(size > m_used)
+        size = m_used;
+
+    size_t first = LOGGER_BUFFER_SIZE - m_tail;
+    if(first > size)
+        first = size;
+
+    memcpy(data, &m_buffer[m_tail], first);
+    memcpy(data + first, m_buffer, size - first);
+    m_tail = (m_tail + size) % LOGGER_BUFFER_SIZE;
+    m_used -= size;
+
+    portEXIT_CRITICAL(&g_loggerMux);
+
+    return size;
+}
+
+void LoggerClass::writerTask(void *parameter)
+{
+    LoggerClass *logger = static_cast<LoggerClass*>(parameter);
+    uint8_t chunk[LOGGER_CHUNK_SIZE];
+
+    for(;;)
+    {
+        size_t size = logger->pop(chunk, sizeof(chunk));
+
+        if(size == 0)
+        {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        // Apenas esta task espera pela UART.
+        logger->m_output->write(chunk, size);
+    }
+}
+
+LoggerClass Logger;
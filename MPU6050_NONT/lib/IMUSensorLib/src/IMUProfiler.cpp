@@ -0,0 +1,78 @@
+/**
+ * @file IMUProfiler.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Arquivo de implementação das funções da classe ProfilerClass.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "IMUProfiler.h"
+
+portMUX_TYPE g_profilerMux = portMUX_INITIALIZER_UNLOCKED; // Proteção das estatísticas entre tasks.
+
+const char *g_stageNames[STAGE_COUNT] = {
+    "fifo_wait",
+    "fifo_read",
+    "raw_read",
+    "dmp_math",
+    "add_measurement",
+    "detect_tipping",
+    "detect_tamper",
+    "detect_movement",
+    "detect_stop",
+    "update_state"
+};
+
+uint32_t ProfilerClass::record(IMUStage_e stage, uint32_t startCycles)
+{
+    uint32_t now = ESP.getCycleCount();
+    uint32_t cycles = now - startCycles;
+
+    // Faixa do histograma a partir da posição do bit mais significativo do tempo em us.
+    uint32_t micros = cycles / ESP.getCpuFreqMHz();
+    uint8_t bucket = (micros == 0) ? 0 : (32 - __builtin_clz(micros));
+    if(bucket >= IMU_PROFILER_BUCKETS)
+        bucket = IMU_PROFILER_BUCKETS - 1;
+
+    portENTER_CRITICAL(&g_profilerMux);
+    IMUStageStats_t &stats = m_stats[stage];
+    if(cycles < stats.Min)
+        stats.Min = cycles;
+    if(cycles > stats.Max)
+        stats.Max = cycles;
+    stats.Sum += cycles;
+    stats.Count++;
+    stats.Histogram[bucket]++;
+    portEXIT_CRITICAL(&g_profilerMux);
+
+    return now;
+}
+
+void ProfilerClass::getStats(IMUStage_e stage, IMUStageStats_t &stats)
+{
+    portENTER_CRITICAL(&g_profilerMux);
+    stats = m_stats[stage];
+    portEXIT_CRITICAL(&g_profilerMux);
+}
+
+void ProfilerClass::reset()
+{
+    portENTER_CRITICAL(&g_profilerMux);
+    for(uint8_t i = 0; i < STAGE_COUNT; i++)
+        m_stats[i].reset();
+    portEXIT_CRITICAL(&g_profilerMux);
+}
+
+const char *ProfilerClass::stageName(IMUStage_e stage)
+{
+    return (stage < STAGE_COUNT) ? g_stageNames[stage] : "unknown";
+}
+
+float ProfilerClass::toMicros(uint64_t cycles)
+{
+    return (float)cycles / ESP.getCpuFreqMHz();
+}
+
+ProfilerClass Profiler;
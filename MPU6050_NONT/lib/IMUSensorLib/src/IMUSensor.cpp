@@ -22,6 +22,14 @@ unsigned long g_firstMovingTip = 0; // Millis() em que é identificado um tombam
 
 bool IMUSensor::begin(TwoWire &wire)
 {
+    m_samples = 0;
+    m_intervalIndex = 0;
+    m_lastSampleTime = 0;
+    m_baseProfile = m_activeProfile = IMU_PROFILE_NONE;
+    m_settingsOverride = false;
+    for(int i = 0; i < g_stateCount; i++)
+        m_stateProfiles[i] = IMU_PROFILE_NONE;
+
     return true;
 }
 
@@ -29,24 +37,84 @@ void IMUSensor::configureTipping(IMUTippingSettings_t settings)
 {
     m_tippingSettings.MinimumSamples = settings.MinimumSamples;
     m_tippingSettings.TippingStartThreshold = settings.TippingStartThreshold;
+    m_settingsOverride = true;
 }
 
 void IMUSensor::configureMovementDetection(IMUMovementSettings_t settings)
 {
     m_movementSettings.MinimumSamples = settings.MinimumSamples;
     m_movementSettings.MovementInterval = settings.MovementInterval;
+    m_settingsOverride = true;
 }
 
 void IMUSensor::configureStopDetection(IMUStopSettings_t settings)
 {
     m_stopSettings.MinimumSamples = settings.MinimumSamples;
     m_stopSettings.StopInterval = settings.StopInterval;
+    m_settingsOverride = true;
 }
 
 void IMUSensor::configureTamperDetection(IMUTamperSettings_t settings)
 {
     m_tamperSettings.MinimumSamples = settings.MinimumSamples;
     m_tamperSettings.TamperTime = settings.TamperTime;
+    m_settingsOverride = true;
+}
+
+void IMUSensor::configure(const IMUDetectionSettings_t &settings)
+{
+    m_tippingSettings = settings.Tipping;
+    m_movementSettings = settings.Movement;
+    m_stopSettings = settings.Stop;
+    m_tamperSettings = settings.Tamper;
+    m_settingsOverride = true;
+}
+
+IMUDetectionSettings_t IMUSensor::getSettings()
+{
+    IMUDetectionSettings_t settings;
+
+    settings.Tipping = m_tippingSettings;
+    settings.Movement = m_movementSettings;
+    settings.Stop = m_stopSettings;
+    settings.Tamper = m_tamperSettings;
+
+    return settings;
+}
+
+void IMUSensor::applyProfile(IMUProfile_e profile)
+{
+    if(profile >= IMU_PROFILE_COUNT)
+        return;
+
+    // Um perfil escolhido explicitamente descarta os ajustes feitos em funcionamento.
+    m_baseProfile = profile;
+    m_settingsOverride = false;
+    selectProfile(profile);
+}
+
+IMUProfile_e IMUSensor::getProfile()
+{
+    return m_activeProfile;
+}
+
+void IMUSensor::setStateProfile(DeviceState_e state, IMUProfile_e profile)
+{
+    if(state >= g_stateCount || (profile >= IMU_PROFILE_COUNT && profile != IMU_PROFILE_NONE))
+        return;
+
+    m_stateProfiles[state] = profile;
+}
+
+void IMUSensor::selectProfile(IMUProfile_e profile)
+{
+    const IMUDetectionSettings_t &settings = g_profiles[profile].Settings;
+
+    m_activeProfile = profile;
+    m_tippingSettings = settings.Tipping;
+    m_movementSettings = settings.Movement;
+    m_stopSettings = settings.Stop;
+    m_tamperSettings = settings.Tamper;
 }
 
 IMUAxisData_t IMUSensor::getAxisData()
@@ -63,14 +131,31 @@ void IMUSensor::handle()
 {
     acquireData();
 
+    uint32_t stageStart = Profiler.start();
     detectTipping();
+    stageStart = Profiler.record(STAGE_DETECT_TIPPING, stageStart);
+
     detectTamper();
+    stageStart = Profiler.record(STAGE_DETECT_TAMPER, stageStart);
+
     if(m_moving)
+    {
         detectStop();
+        stageStart = Profiler.record(STAGE_DETECT_STOP, stageStart);
+    }
     else
+    {
         detectMovement();
+        stageStart = Profiler.record(STAGE_DETECT_MOVEMENT, stageStart);
+    }
 
     updateState();
+    Profiler.record(STAGE_UPDATE_STATE, stageStart);
+
+#ifdef IMU_BENCHMARK
+    Benchmark.stateUpdated();
+    Benchmark.sampleProcessed();
+#endif
 }
 
 bool IMUSensor::getTippedState()
@@ -267,6 +352,15 @@ void IMUSensor::updateState()
 
     if(!(m_moving && m_tipped))
         g_firstMovingTip = 0;
+
+    // Troca de perfil pelo estado: apenas a publicação de um bloco já pronto em flash.
+    // Suspensa enquanto houver ajustes feitos em funcionamento.
+    IMUProfile_e profile = m_stateProfiles[m_devState];
+    if(profile == IMU_PROFILE_NONE)
+        profile = m_baseProfile;
+
+    if(profile != IMU_PROFILE_NONE && profile != m_activeProfile && !m_settingsOverride)
+        selectProfile(profile);
 }
 
 bool IMUSensor::checkConfigurations()
@@ -276,4 +370,37 @@ bool IMUSensor::checkConfigurations()
     bool StopSetted = m_stopSettings.MinimumSamples != 0; 
     bool TamperSetted = m_tamperSettings.MinimumSamples != 0; 
     return (TipSetted || MovementSetted || StopSetted || TamperSetted);
+}
+
+void IMUSensor::getHealth(IMUHealth_t &health)
+{
+    uint32_t intervals[g_jitterWindow];
+    uint32_t samples = m_samples;
+    uint16_t count = (samples > g_jitterWindow) ? g_jitterWindow : ((samples > 0) ? samples - 1 : 0);
+
+    memcpy(intervals, m_sampleIntervals, count * sizeof(uint32_t));
+    health.Samples = samples;
+
+    if(count == 0)
+        return;
+
+    std::sort(intervals, intervals + count);
+    health.IntervalP50 = intervals[(count - 1) * 50 / 100];
+    health.IntervalP90 = intervals[(count - 1) * 90 / 100];
+    health.IntervalP99 = intervals[(count - 1) * 99 / 100];
+    health.IntervalMax = intervals[count - 1];
+}
+
+void IMUSensor::registerSample()
+{
+    unsigned long now = micros();
+
+    if(m_samples > 0)
+    {
+        m_sampleIntervals[m_intervalIndex] = now - m_lastSampleTime;
+        m_intervalIndex = (m_intervalIndex + 1) % g_jitterWindow;
+    }
+
+    m_lastSampleTime = now;
+    m_samples++;
 }
\ No newline at end of file
@@ -9,8 +9,10 @@
  * 
  */
 #include "MPU6050_IMU.h"
+#include "IMULogger.h"
+#include "I2CdevAsync.h"
 
-uint16_t g_fifoPacketSize;          // Tamanho esperado do pacote do DMP (Padrão: 42 bytes)
+uint16_t g_fifoPacketSize;          // Tamanho esperado do pacote do DMP (42 bytes no MotionApps 2.0, 28 no 6.12)
 uint16_t g_fifoCount;               // Quantos bytes o FIFO possui atualmente.
 uint8_t g_fifoBuffer[64];           // Buffer para armezamento do FIFO.
 VectorFloat g_gravity;              // [x, y, z]    Vetor para informações da gravidade.
@@ -19,10 +21,36 @@ const float g_degreeRad = 180/M_PI; // Termo de conversão de radianos para grau
 float g_YPR[3];                     // Buffer de leitura do Yaw, Pitch e Roll
 unsigned long g_timeLastRead = 0;   // Millis() em que foi feito último registro de leitura no histórico.
 
+/**
+ * @brief Soma dos contadores de erro do I2Cdev. Comparada antes e depois de uma
+ * amostra, indica falha no barramento sem nenhuma transação extra.
+ * @return uint32_t - Leituras e escritas com falha até agora.
+ */
+static uint32_t busErrorCount()
+{
+    return I2Cdev::readFailures + I2Cdev::readTimeouts + I2Cdev::writeFailures;
+}
+
 MPU6050IMU::MPU6050IMU()
 {
     m_deviceStatus = 0;
     m_dmpStatus = false;
+    m_fifoOverflows = 0;
+    m_dmpInitTime = 0;
+    m_warmStart = false;
+    m_storedOffsets = false;
+    m_gyroBiasTracking = true;
+    m_lastModelUpdate = 0;
+    m_lastModelSave = 0;
+    m_wire = NULL;
+    m_failedSamples = 0;
+    m_recovering = false;
+    m_outageStart = 0;
+    m_lastRecoveryAttempt = 0;
+    m_recoveryAttempts = 0;
+    m_recoveries = 0;
+    m_lastOutage = 0;
+    m_totalOutage = 0;
     m_moving = false;
     m_tipped = false;
     m_tamper = false;
@@ -33,29 +61,72 @@ bool MPU6050IMU::begin(TwoWire &wire)
 {
     IMUOffsets_t offsets = IMUOffsets_t(-2314, 777, 1054, 144, 24, 16);
 
+    // Offsets salvos pela última calibração deste sensor têm prioridade sobre os padrão.
+    m_storedOffsets = OffsetStore.load(IMU_MODEL_MPU6050, offsets);
+    OffsetStore.loadGyroModel(IMU_MODEL_MPU6050, m_gyroModel);
+
     return begin(wire, offsets);
 }
 
 bool MPU6050IMU::begin(TwoWire &wire, IMUOffsets_t offsets)
 {
+    m_wire = &wire;
+
+#ifdef IMU_BENCHMARK
+    // No benchmark o sensor é simulado, então o barramento não é utilizado.
+    m_dmpStatus = true;
+    return IMUSensor::begin(wire);
+#endif
+
+#if I2CDEV_IMPLEMENTATION == I2CDEV_ESP32_ASYNC
+    // Backend assíncrono: o driver do ESP-IDF ocupa a porta no lugar do Wire.
+    if(!I2CdevAsync.begin(I2C_NUM_0, MPU6050_PIN_SDA, MPU6050_PIN_SCL, MPU6050_FREQUENCY))
+        return false;
+#else
     wire.begin(MPU6050_PIN_SDA, MPU6050_PIN_SCL, MPU6050_FREQUENCY);
-    m_mpu.initialize();
+#endif
 
     if(!m_mpu.testConnection())
         return false;
 
-    m_deviceStatus = m_mpu.dmpInitialize();
+    // Registradores de configuração espelhados em RAM: setters de bits sem a leitura prévia
+    // e getters de configuração sem acesso ao barramento.
+    m_mpu.setShadowRegistersEnabled(true);
+
+    // Contadores de uso do barramento por faixa de registradores (as faixas mais estreitas
+    // primeiro, pois a primeira que contém o registrador é a utilizada).
+    if(I2Cdev::getStatsRangeCount() == 1)
+    {
+        I2Cdev::addStatsRange(MPU6050_DEFAULT_ADDRESS, MPU6050_RA_FIFO_COUNTH, MPU6050_RA_FIFO_R_W, "fifo");
+        I2Cdev::addStatsRange(MPU6050_DEFAULT_ADDRESS, MPU6050_RA_BANK_SEL, MPU6050_RA_MEM_R_W, "dmp mem");
+        I2Cdev::addStatsRange(MPU6050_DEFAULT_ADDRESS, MPU6050_RA_ACCEL_XOUT_H, MPU6050_RA_EXT_SENS_DATA_23, "dados");
+        I2Cdev::addStatsRange(MPU6050_DEFAULT_ADDRESS, 0x00, 0xFF, "config");
+    }
+    I2Cdev::setStatsEnabled(true);
+
+    // Após ESP.restart() ou watchdog o sensor continua alimentado: se o DMP e a configuração
+    // ainda estiverem lá, basta rearmar o FIFO em vez de reiniciar o chip e recarregar o firmware.
+    uint32_t initStart = micros();
+    m_warmStart = (m_mpu.dmpWarmStart() == 0);
+    if(m_warmStart)
+        m_deviceStatus = 0;
+    else
+    {
+        m_mpu.initialize();
+        m_deviceStatus = m_mpu.dmpInitialize();
+    }
+    m_dmpInitTime = micros() - initStart;
+    Logger.printf("\n[MPU6050IMU] DMP (%s) %s em %u us (status %u).", MPU6050_DMP_FIRMWARE,
+                  m_warmStart ? "reaproveitado" : "inicializado", m_dmpInitTime, m_deviceStatus);
 
-    m_mpu.setXAccelOffset(offsets.XAccelOffset);
-    m_mpu.setYAccelOffset(offsets.YAccelOffset);
-    m_mpu.setZAccelOffset(offsets.ZAccelOffset);
-    m_mpu.setXGyroOffset(offsets.XGyroOffset);
-    m_mpu.setYGyroOffset(offsets.YGyroOffset);
-    m_mpu.setZGyroOffset(offsets.ZGyroOffset);
+    setOffsets(offsets);
 
     if(m_deviceStatus != 0)
         return false;
 
+    // Os limites do estimador de bias acompanham a faixa do giroscópio (±2000 °/s com o DMP).
+    m_gyroBias.setRange(m_mpu.getFullScaleGyroRange());
+
     m_mpu.setDMPEnabled(true);
     m_dmpStatus = true;
     g_fifoPacketSize = m_mpu.dmpGetFIFOPacketSize();
@@ -68,8 +139,21 @@ bool MPU6050IMU::begin(TwoWire &wire, IMUOffsets_t offsets)
 
 IMUOffsets_t MPU6050IMU::calibrate()
 {
-    m_mpu.CalibrateAccel(10);
-    m_mpu.CalibrateGyro(10);
+    MPU6050_CalibrationResult result;
+
+    // Seis eixos juntos, parando assim que convergem; a rotina antiga fica como reserva.
+    if(m_mpu.CalibrateFast(result))
+    {
+        Logger.printf("\n[MPU6050IMU] Calibracao concluida em %u iteracoes (residuo acel %.1f, giro %.1f LSB).",
+                      result.iterations, result.accelResidual, result.gyroResidual);
+    }
+    else
+    {
+        Logger.printf("\n[MPU6050IMU] Calibracao rapida nao convergiu em %u iteracoes (residuo acel %.1f, giro %.1f LSB).",
+                      result.iterations, result.accelResidual, result.gyroResidual);
+        m_mpu.CalibrateAccel(6);
+        m_mpu.CalibrateGyro(6);
+    }
 
     IMUOffsets_t newOffsets = IMUOffsets_t();
 
@@ -80,48 +164,118 @@ IMUOffsets_t MPU6050IMU::calibrate()
     newOffsets.YGyroOffset = m_mpu.getYGyroOffset();
     newOffsets.ZGyroOffset = m_mpu.getZGyroOffset();
 
+    m_offsets = newOffsets;
+    m_storedOffsets = OffsetStore.save(IMU_MODEL_MPU6050, newOffsets);
+
     return newOffsets;
 }
 
 void MPU6050IMU::acquireData()
 {
-    if(!m_dmpStatus || !checkConfigurations() || !m_mpu.testConnection())
+    IMUAxisData_t data;
+
+#ifdef IMU_BENCHMARK
+    if(!m_dmpStatus || !checkConfigurations())
         return;
+
+    Benchmark.readSample(data);
+    registerSample();
+#else
+    if(!m_dmpStatus || !checkConfigurations())
+        return;
+
+    // Nenhuma verificação de conexão por amostra: os contadores de erro do I2Cdev (em RAM)
+    // indicam se alguma transação da amostra falhou.
+    if(m_recovering)
+    {
+        recoverSensor();
+        return;
+    }
+
+    uint32_t busErrors = busErrorCount();
+    uint32_t stageStart = Profiler.start();
     
     g_fifoCount = m_mpu.getFIFOCount();
 
-    if(g_fifoCount > 1023)
+    if(busErrorCount() == busErrors && g_fifoCount > 1023)
     {
         m_mpu.resetFIFO();
-        Serial.printf("\nFIFO Overflow!");
+        m_fifoOverflows++;
         g_fifoCount = m_mpu.getFIFOCount();
     }
 
-    while (g_fifoCount < g_fifoPacketSize) 
+    // Espera limitada: um sensor que reiniciou (sem DMP) nunca enche o FIFO.
+    uint32_t waitStart = millis();
+    while (g_fifoCount < g_fifoPacketSize && busErrorCount() == busErrors && millis() - waitStart <= MPU6050_FIFO_WAIT_TIMEOUT) 
         g_fifoCount = m_mpu.getFIFOCount();
 
+    if(g_fifoCount < g_fifoPacketSize || busErrorCount() != busErrors)
+    {
+        sampleFailed();
+        return;
+    }
+
+    stageStart = Profiler.record(STAGE_FIFO_WAIT, stageStart);
+
     g_fifoCount -= g_fifoPacketSize;
-    m_mpu.dmpGetCurrentFIFOPacket(g_fifoBuffer);
+    if(!m_mpu.dmpGetCurrentFIFOPacket(g_fifoBuffer))
+    {
+        if(busErrorCount() != busErrors)
+            sampleFailed();
+        return;
+    }
+
+    registerSample();
+    stageStart = Profiler.record(STAGE_FIFO_READ, stageStart);
 
     m_mpu.dmpGetQuaternion(&g_quart, g_fifoBuffer);
     m_mpu.dmpGetGravity(&g_gravity, &g_quart);
     m_mpu.dmpGetYawPitchRoll(g_YPR, &g_quart, &g_gravity);
     
-    IMUAxisData_t data;
     data.Yaw  = g_YPR[0] * g_degreeRad;
     data.Pitch = g_YPR[1] * g_degreeRad;
     data.Roll = g_YPR[2] * g_degreeRad;
-    data.Acc_X = (double) m_mpu.getAccelerationX()/16384;
-    data.Acc_Y = (double) m_mpu.getAccelerationY()/16384;
-    data.Acc_Z = (double) m_mpu.getAccelerationZ()/16384;
-    data.Gyro_X = (double) m_mpu.getRotationX()/131;
-    data.Gyro_Y = (double) m_mpu.getRotationY()/131;
-    data.Gyro_Z = (double) m_mpu.getRotationZ()/131;
+
+    stageStart = Profiler.record(STAGE_DMP_MATH, stageStart);
+
+#ifdef IMU_DMP_MOTIONAPPS612
+    // O pacote do 6.12 já traz acelerômetro e giroscópio brutos (mesma escala dos registradores):
+    // fora do FIFO só a temperatura é lida.
+    int16_t accel[3], gyro[3];
+    m_mpu.dmpGetAccel(accel, g_fifoBuffer);
+    m_mpu.dmpGetGyro(gyro, g_fifoBuffer);
+#else
+    // No pacote do 2.0 acelerômetro e giroscópio estão na escala do DMP: as leituras brutas
+    // continuam vindo dos registradores.
+    int16_t accel[3] = {m_mpu.getAccelerationX(), m_mpu.getAccelerationY(), m_mpu.getAccelerationZ()};
+    int16_t gyro[3] = {m_mpu.getRotationX(), m_mpu.getRotationY(), m_mpu.getRotationZ()};
+#endif
+    data.Acc_X = (double) accel[0]/16384;
+    data.Acc_Y = (double) accel[1]/16384;
+    data.Acc_Z = (double) accel[2]/16384;
+    data.Gyro_X = (double) gyro[0]/131;
+    data.Gyro_Y = (double) gyro[1]/131;
+    data.Gyro_Z = (double) gyro[2]/131;
     data.Temperature = ((double) m_mpu.getTemperature()/340) + 36.53;
     data.Time = millis();
 
+    // Leituras brutas com erro não viram amostra.
+    if(busErrorCount() != busErrors)
+    {
+        sampleFailed();
+        return;
+    }
+    m_failedSamples = 0;
+
+    Profiler.record(STAGE_RAW_READ, stageStart);
+
+    trackGyroBias(gyro, data.Temperature);
+#endif
+
+    uint32_t measurementStart = Profiler.start();
     g_timeLastRead = millis();
     addMeasurement(data);
+    Profiler.record(STAGE_ADD_MEASUREMENT, measurementStart);
 }
 
 IMUOffsets_t MPU6050IMU::getCurrentOffsets()
@@ -140,6 +294,7 @@ IMUOffsets_t MPU6050IMU::getCurrentOffsets()
 
 void MPU6050IMU::setOffsets(IMUOffsets_t newOffsets)
 {
+    m_offsets = newOffsets;
     m_mpu.setXAccelOffset(newOffsets.XAccelOffset);
     m_mpu.setYAccelOffset(newOffsets.YAccelOffset);
     m_mpu.setZAccelOffset(newOffsets.ZAccelOffset);
@@ -148,4 +303,221 @@ void MPU6050IMU::setOffsets(IMUOffsets_t newOffsets)
     m_mpu.setZGyroOffset(newOffsets.ZGyroOffset);
 }
 
+void MPU6050IMU::getHealth(IMUHealth_t &health)
+{
+    IMUSensor::getHealth(health);
+
+    health.FifoOverflows = m_fifoOverflows;
+    health.FifoResets = m_mpu.getFIFOResetCount();
+    health.FifoTimeouts = m_mpu.getFIFOTimeoutCount();
+    health.TrashBytes = m_mpu.getFIFOTrashCount();
+    health.I2CReadFailures = I2Cdev::readFailures;
+    health.I2CReadTimeouts = I2Cdev::readTimeouts;
+    health.I2CWriteFailures = I2Cdev::writeFailures;
+    health.I2CShadowHits = I2Cdev::shadowHits;
+    health.SensorRecoveries = m_recoveries;
+    health.LastOutage = m_lastOutage;
+    health.TotalOutage = m_totalOutage;
+
+    // A leitura é feita na própria loopTask, que também atende a consulta.
+    health.StackSize = MPU6050_LOOP_TASK_STACK;
+    health.StackHighWaterMark = uxTaskGetStackHighWaterMark(NULL);
+
+    health.DmpInitTime = m_dmpInitTime;
+    health.DmpWarmStart = m_warmStart;
+
+    IMUGyroBiasData_t gyroBias = m_gyroBias.getData();
+    health.GyroBiasWindows = gyroBias.Windows;
+    health.GyroBiasCorrections = gyroBias.Corrections;
+    health.GyroModelCorrections = gyroBias.ModelCorrections;
+    health.GyroModelNodes = m_gyroModel.getNodeCount();
+}
+
+void MPU6050IMU::setGyroBiasTracking(bool enable)
+{
+    m_gyroBiasTracking = enable;
+}
+
+void MPU6050IMU::getGyroBiasData(IMUGyroBiasData_t &data)
+{
+    data = m_gyroBias.getData();
+}
+
+void MPU6050IMU::getGyroModel(GyroTemperatureModel &model)
+{
+    model = m_gyroModel;
+}
+
+void MPU6050IMU::trackGyroBias(const int16_t *gyro, float temperature)
+{
+    if(!m_gyroBiasTracking)
+        return;
+
+    uint32_t now = millis();
+    int16_t step[3];
+
+    // Fora da parada a janela em andamento é descartada e o modelo de temperatura assume.
+    if(m_moving || m_devState != DeviceState_e::STATE_STOPPED)
+    {
+        m_gyroBias.reset();
+
+        float target[3];
+        if(now - m_lastModelUpdate < GYRO_MODEL_UPDATE_INTERVAL || !m_gyroModel.predict(temperature, target))
+            return;
+        m_lastModelUpdate = now;
+
+        const int16_t current[3] = {m_mpu.getXGyroOffset(), m_mpu.getYGyroOffset(), m_mpu.getZGyroOffset()};
+        bool adjust = false;
+        for(int i = 0; i < 3; i++)
+        {
+            step[i] = (int16_t)constrain(lroundf(target[i] - current[i]), -GYRO_BIAS_MAX_STEP, GYRO_BIAS_MAX_STEP);
+            adjust = adjust || step[i] != 0;
+        }
+
+        if(adjust)
+        {
+            adjustGyroOffsets(step);
+            m_gyroBias.countModelCorrection();
+        }
+        return;
+    }
+
+    bool correct = m_gyroBias.addSample(gyro, temperature, now, step);
+
+    if(m_gyroBias.takeWindow())
+    {
+        // Offset ideal = offset atual menos o bias residual da janela, convertido da faixa
+        // em uso para a escala do offset (bias * 2 em ±2000 °/s).
+        IMUGyroBiasData_t data = m_gyroBias.getData();
+        const int16_t current[3] = {m_mpu.getXGyroOffset(), m_mpu.getYGyroOffset(), m_mpu.getZGyroOffset()};
+        float ideal[3];
+        for(int i = 0; i < 3; i++)
+            ideal[i] = current[i] - data.Bias[i] / m_gyroBias.getOffsetScale();
+
+        m_gyroModel.learn(data.Temperature, ideal);
+
+        // A gravação só acontece parado e com intervalo mínimo, poupando a flash.
+        if(m_gyroModel.isDirty() && (m_lastModelSave == 0 || now - m_lastModelSave > GYRO_MODEL_SAVE_INTERVAL))
+        {
+            if(OffsetStore.saveGyroModel(IMU_MODEL_MPU6050, m_gyroModel))
+                m_gyroModel.setSaved();
+            m_lastModelSave = now;
+        }
+    }
+
+    if(correct)
+        adjustGyroOffsets(step);
+}
+
+void MPU6050IMU::adjustGyroOffsets(const int16_t *step)
+{
+    m_offsets.XGyroOffset += step[0];
+    m_offsets.YGyroOffset += step[1];
+    m_offsets.ZGyroOffset += step[2];
+
+    m_mpu.setXGyroOffset(m_offsets.XGyroOffset);
+    m_mpu.setYGyroOffset(m_offsets.YGyroOffset);
+    m_mpu.setZGyroOffset(m_offsets.ZGyroOffset);
+}
+
+void MPU6050IMU::sampleFailed()
+{
+    if(m_failedSamples == 0)
+        m_outageStart = millis();
+
+    if(++m_failedSamples < MPU6050_RECOVERY_THRESHOLD)
+        return;
+
+    m_recovering = true;
+    m_recoveryAttempts = 0;
+    Logger.printf("\n[MPU6050IMU] Sensor sem resposta, iniciando a recuperacao.");
+}
+
+bool MPU6050IMU::recoverSensor()
+{
+    if(m_recoveryAttempts > 0 && millis() - m_lastRecoveryAttempt < MPU6050_RECOVERY_INTERVAL)
+        return false;
+
+    m_lastRecoveryAttempt = millis();
+    m_recoveryAttempts++;
+
+    clearBus();
+
+    // O sensor pode ter reiniciado: a cópia dos registradores em RAM deixa de valer
+    // (e o dmpWarmStart() precisa ler o chip, não a cópia).
+    m_mpu.setShadowRegistersEnabled(false);
+    m_mpu.setShadowRegistersEnabled(true);
+
+    uint32_t busErrors = busErrorCount();
+    if(!m_mpu.testConnection())
+        return false;
+
+    // Caminho mais curto: só o barramento travou, o DMP e os offsets continuam no chip e
+    // basta rearmar o FIFO. Se o sensor reiniciou (queda de tensão) o DMP é recarregado.
+    bool warm = (m_mpu.dmpWarmStart() == 0);
+    if(!warm)
+    {
+        m_mpu.initialize();
+        if(m_mpu.dmpInitialize() != 0)
+            return false;
+
+        setOffsets(m_offsets);
+    }
+
+    // Os dois caminhos deixam o DMP desligado (como em begin()).
+    m_mpu.setDMPEnabled(true);
+
+    if(busErrorCount() != busErrors)
+        return false;
+
+    m_lastOutage = millis() - m_outageStart;
+    m_totalOutage += m_lastOutage;
+    m_recoveries++;
+    m_failedSamples = 0;
+    m_recovering = false;
+
+    Logger.printf("\n[MPU6050IMU] Sensor recuperado apos %u ms (%s, %u tentativa(s)).", m_lastOutage, 
+                  warm ? "DMP reaproveitado" : "DMP recarregado", m_recoveryAttempts);
+    return true;
+}
+
+void MPU6050IMU::clearBus()
+{
+#if I2CDEV_IMPLEMENTATION == I2CDEV_ESP32_ASYNC
+    // O driver do ESP-IDF reinicia o periférico sozinho após um tempo limite e é dono dos pinos.
+#else
+    if(m_wire == NULL)
+        return;
+
+    m_wire->end();
+
+    // Um escravo interrompido no meio de um byte segura o SDA em nível baixo até receber
+    // os clocks que faltam: no máximo 8 bits e o ACK.
+    pinMode(MPU6050_PIN_SDA, INPUT_PULLUP);
+    pinMode(MPU6050_PIN_SCL, OUTPUT_OPEN_DRAIN);
+    digitalWrite(MPU6050_PIN_SCL, HIGH);
+    for(uint8_t i = 0; i < 9 && digitalRead(MPU6050_PIN_SDA) == LOW; i++)
+    {
+        digitalWrite(MPU6050_PIN_SCL, LOW);
+        delayMicroseconds(5);
+        digitalWrite(MPU6050_PIN_SCL, HIGH);
+        delayMicroseconds(5);
+    }
+
+    // STOP: SDA sobe com o SCL em nível alto.
+    pinMode(MPU6050_PIN_SDA, OUTPUT_OPEN_DRAIN);
+    digitalWrite(MPU6050_PIN_SDA, LOW);
+    delayMicroseconds(5);
+    digitalWrite(MPU6050_PIN_SDA, HIGH);
+    delayMicroseconds(5);
+
+    m_wire->begin(MPU6050_PIN_SDA, MPU6050_PIN_SCL, MPU6050_FREQUENCY);
+#endif
+}
+
+bool MPU6050IMU::hasStoredOffsets()
+{
+    return m_storedOffsets;
+}
+
 MPU6050IMU MPU;
\ No newline at end of file
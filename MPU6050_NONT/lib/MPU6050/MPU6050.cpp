@@ -47,6 +47,65 @@ THE SOFTWARE.
 MPU6050_Base::MPU6050_Base(uint8_t address, void *wireObj):devAddr(address), wireObj(wireObj) {
 }
 
+/** Destructor. Detaches the register shadow, if enabled.
+ */
+MPU6050_Base::~MPU6050_Base() {
+    if (shadowEnabled) I2Cdev::detachShadow(&shadow);
+}
+
+/** Writable configuration registers kept in the shadow (bitmap, bit n = register n):
+ * offsets and trims (0x00-0x0B, 0x13-0x18), SMPLRT_DIV to I2C_SLV4_CTRL (0x19-0x34),
+ * INT_PIN_CFG, INT_ENABLE, I2C_SLVx_DO, I2C_MST_DELAY_CTRL, MOT_DETECT_CTRL,
+ * USER_CTRL, PWR_MGMT_1/2 and DMP_CFG_1/2. Data, status, FIFO, SIGNAL_PATH_RESET
+ * and the DMP memory window (BANK_SEL, MEM_START_ADDR, MEM_R_W) are always read
+ * from the device.
+ */
+static const uint8_t shadowCacheable[32] = {
+    0xFF, 0x0F, 0xF8, 0xFF, 0xFF, 0xFF, 0x9F, 0x01, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x1E, 0x03, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+/** Bits the device clears by itself after acting on them; never cached as set.
+ */
+static const uint8_t shadowSelfClearing[][2] = {
+    { MPU6050_RA_I2C_SLV4_CTRL, 1 << MPU6050_I2C_SLV4_EN_BIT },
+    { MPU6050_RA_USER_CTRL, (1 << MPU6050_USERCTRL_DMP_RESET_BIT) | (1 << MPU6050_USERCTRL_FIFO_RESET_BIT) |
+                            (1 << MPU6050_USERCTRL_I2C_MST_RESET_BIT) | (1 << MPU6050_USERCTRL_SIG_COND_RESET_BIT) }
+};
+
+/** Enable or disable the RAM shadow of the configuration registers.
+ * While enabled, bit-field writes (writeBit/writeBits) skip the read half of
+ * read-modify-write and configuration getters are answered from RAM once each
+ * register has been read or written. The shadow is cleared on enable and on
+ * every DEVICE_RESET write; it assumes nothing else writes these registers
+ * behind this object.
+ * @param enabled New shadow state
+ * @see getShadowRegistersEnabled()
+ */
+void MPU6050_Base::setShadowRegistersEnabled(bool enabled) {
+    if (enabled) {
+        shadow.devAddr = devAddr;
+        shadow.wireObj = wireObj;
+        shadow.cacheable = shadowCacheable;
+        shadow.selfClearing = shadowSelfClearing;
+        shadow.selfClearingCount = sizeof(shadowSelfClearing) / sizeof(shadowSelfClearing[0]);
+        shadow.resetReg = MPU6050_RA_PWR_MGMT_1; // DEVICE_RESET, from reset() or a direct write
+        shadow.resetMask = 1 << MPU6050_PWR1_DEVICE_RESET_BIT;
+        I2Cdev::attachShadow(&shadow);
+    } else if (shadowEnabled) {
+        I2Cdev::detachShadow(&shadow);
+    }
+    shadowEnabled = enabled;
+}
+
+/** Get the register shadow state.
+ * @return True if configuration registers are shadowed in RAM
+ * @see setShadowRegistersEnabled()
+ */
+bool MPU6050_Base::getShadowRegistersEnabled() {
+    return shadowEnabled;
+}
+
 /** Power on and prepare for general usage.
  * This will activate the device and take it out of sleep mode (which must be done
  * after start-up). This function also sets both the accelerometer and the gyroscope
@@ -2762,6 +2821,30 @@ void MPU6050_Base::setFIFOTimeout(uint32_t fifoTimeout) {
 	this->fifoTimeout = fifoTimeout;
 }
 
+/** Get how many times GetCurrentFIFOPacket() reset the FIFO buffer to recover
+ * from an overflow.
+ * @return FIFO resets since power-up
+ */
+uint32_t MPU6050_Base::getFIFOResetCount() {
+	return fifoResetCount;
+}
+
+/** Get how many stale bytes GetCurrentFIFOPacket() discarded to reach the
+ * latest packet.
+ * @return Discarded FIFO bytes since power-up
+ */
+uint32_t MPU6050_Base::getFIFOTrashCount() {
+	return fifoTrashCount;
+}
+
+/** Get how many times GetCurrentFIFOPacket() gave up without a valid packet.
+ * @return FIFO packet timeouts since power-up
+ * @see getFIFOTimeout()
+ */
+uint32_t MPU6050_Base::getFIFOTimeoutCount() {
+	return fifoTimeoutCount;
+}
+
 /** Get latest byte from FIFO buffer no matter how much time has passed.
  * ===                  GetCurrentFIFOPacket                    ===
  * ================================================================
@@ -2779,6 +2862,7 @@ void MPU6050_Base::setFIFOTimeout(uint32_t fifoTimeout) {
 
              if (fifoC > 200) { // if you waited to get the FIFO buffer to > 200 bytes it will take longer to get the last packet in the FIFO Buffer than it will take to  reset the buffer and wait for the next to arrive
                  resetFIFO(); // Fixes any overflow corruption
+                 fifoResetCount++;
                  fifoC = 0;
                  while (!(fifoC = getFIFOCount()) && ((micros() - BreakTimer) <= (getFIFOTimeout()))); // Get Next New Packet
                  } else { //We have more than 1 packet but less than 200 bytes of data in the FIFO Buffer
@@ -2789,15 +2873,22 @@ void MPU6050_Base::setFIFOTimeout(uint32_t fifoTimeout) {
                      while (fifoC) { // fifo count will reach zero so this is safe
                          RemoveBytes = (fifoC < I2CDEVLIB_WIRE_BUFFER_LENGTH) ? fifoC : I2CDEVLIB_WIRE_BUFFER_LENGTH; // Buffer Length is different than the packet length this will efficiently clear the buffer
                          getFIFOBytes(Trash, (uint8_t)RemoveBytes);
+                         fifoTrashCount += RemoveBytes;
                          fifoC -= RemoveBytes;
                      }
                  }
              }
          }
-         if (!fifoC) return 0; // Called too early no data or we timed out after FIFO Reset
+         if (!fifoC) { // Called too early no data or we timed out after FIFO Reset
+             fifoTimeoutCount++;
+             return 0;
+         }
          // We have 1 packet
          packetReceived = fifoC == length;
-         if (!packetReceived && (micros() - BreakTimer) > (getFIFOTimeout())) return 0;
+         if (!packetReceived && (micros() - BreakTimer) > (getFIFOTimeout())) {
+             fifoTimeoutCount++;
+             return 0;
+         }
      } while (!packetReceived);
      getFIFOBytes(data, length); //Get 1 packet
      return 1;
@@ -3175,6 +3266,91 @@ bool MPU6050_Base::writeMemoryBlock(const uint8_t *data, uint16_t dataSize, uint
 bool MPU6050_Base::writeProgMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank, uint8_t address, bool verify) {
     return writeMemoryBlock(data, dataSize, bank, address, verify, true);
 }
+/** Upload a block to DMP memory in the largest chunks the Wire buffer allows.
+ * No heap allocation: PROGMEM data is staged through a stack buffer. Instead of
+ * reading back every chunk, the whole block is verified at the end by comparing
+ * the CRC-16 of the source with the CRC-16 of the memory contents.
+ * @param verify Compare the CRC of the written block (one read-back pass)
+ * @return Status of operation (true = success)
+ */
+bool MPU6050_Base::writeMemoryBlockFast(const uint8_t *data, uint16_t dataSize, uint8_t bank, uint8_t address, bool verify, bool useProgMem) {
+    uint8_t chunk[MPU6050_DMP_MEMORY_FAST_CHUNK_SIZE];
+    uint8_t startBank = bank;
+    uint8_t startAddress = address;
+    uint8_t chunkSize;
+    bool success = true;
+
+    for (uint16_t i = 0; i < dataSize;) {
+        chunkSize = MPU6050_DMP_MEMORY_FAST_CHUNK_SIZE;
+
+        // make sure we don't go past the data size
+        if (i + chunkSize > dataSize) chunkSize = dataSize - i;
+
+        // make sure this chunk doesn't go past the bank boundary (256 bytes)
+        if (chunkSize > 256 - address) chunkSize = 256 - address;
+
+        const uint8_t *source = data + i;
+        if (useProgMem) {
+            for (uint8_t j = 0; j < chunkSize; j++) chunk[j] = pgm_read_byte(data + i + j);
+            source = chunk;
+        }
+
+        setMemoryBank(bank);
+        setMemoryStartAddress(address);
+        success &= I2Cdev::writeBytes(devAddr, MPU6050_RA_MEM_R_W, chunkSize, (uint8_t *)source, wireObj);
+
+        i += chunkSize;
+
+        // uint8_t automatically wraps to 0 at 256
+        address += chunkSize;
+        if (address == 0) bank++;
+    }
+
+    if (!success) return false;
+    if (!verify) return true;
+
+    return readMemoryCRC(dataSize, startBank, startAddress) == memoryCRC(data, dataSize, useProgMem);
+}
+bool MPU6050_Base::writeProgMemoryBlockFast(const uint8_t *data, uint16_t dataSize, uint8_t bank, uint8_t address, bool verify) {
+    return writeMemoryBlockFast(data, dataSize, bank, address, verify, true);
+}
+/** Compute the CRC-16/CCITT-FALSE of a block of DMP memory, read in large chunks.
+ * @return CRC of the memory contents
+ */
+uint16_t MPU6050_Base::readMemoryCRC(uint16_t dataSize, uint8_t bank, uint8_t address) {
+    uint8_t chunk[MPU6050_DMP_MEMORY_FAST_CHUNK_SIZE];
+    uint16_t crc = MPU6050_DMP_MEMORY_CRC_INIT;
+    uint8_t chunkSize;
+
+    for (uint16_t i = 0; i < dataSize;) {
+        chunkSize = MPU6050_DMP_MEMORY_FAST_CHUNK_SIZE;
+        if (i + chunkSize > dataSize) chunkSize = dataSize - i;
+        if (chunkSize > 256 - address) chunkSize = 256 - address;
+
+        setMemoryBank(bank);
+        setMemoryStartAddress(address);
+        I2Cdev::readBytes(devAddr, MPU6050_RA_MEM_R_W, chunkSize, chunk, I2Cdev::readTimeout, wireObj);
+        crc = memoryCRC(chunk, chunkSize, false, crc);
+
+        i += chunkSize;
+        address += chunkSize;
+        if (address == 0) bank++;
+    }
+
+    return crc;
+}
+/** CRC-16/CCITT-FALSE (polynomial 0x1021) of a buffer in RAM or PROGMEM.
+ * @param crc Running CRC, to continue a previous block
+ * @return Updated CRC
+ */
+uint16_t MPU6050_Base::memoryCRC(const uint8_t *data, uint16_t dataSize, bool useProgMem, uint16_t crc) {
+    for (uint16_t i = 0; i < dataSize; i++) {
+        crc ^= (uint16_t)(useProgMem ? pgm_read_byte(data + i) : data[i]) << 8;
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
 bool MPU6050_Base::writeDMPConfigurationSet(const uint8_t *data, uint16_t dataSize, bool useProgMem) {
     uint8_t *progBuffer = 0;
 	uint8_t success, special;
@@ -3368,6 +3544,62 @@ void MPU6050_Base::PID(uint8_t ReadAddress, float kP,float kI, uint8_t Loops){
 	resetDMP();
 }
 
+/**
+  @brief      Calibrate Accel and Gyro together with one 14-byte burst read per iteration.
+              Runs at 1 kHz with the sample rate divider at 0 and stops as soon as all six
+              axes stay within tolerance (see MPU6050_Calibration.h).
+  @return     true if the calibration converged before maxIterations
+*/
+bool MPU6050_Base::CalibrateFast(MPU6050_CalibrationResult &result, uint16_t maxIterations) {
+	bool packed = getDeviceID() < 0x38;
+	uint8_t accelAddress = packed ? MPU6050_RA_XA_OFFS_H : 0x77;
+	uint8_t savedRate = getRate();
+	int16_t offsets[MPU6050_CALIBRATION_AXES];
+	int16_t reading[MPU6050_CALIBRATION_AXES];
+	MPU6050_Calibrator calibrator;
+
+	setRate(0); // 1 kHz, so every iteration sees a new sample
+
+	if (packed) I2Cdev::readWords(devAddr, accelAddress, 3, (uint16_t *)offsets, I2Cdev::readTimeout, wireObj);
+	else for (int i = 0; i < 3; i++)
+		I2Cdev::readWords(devAddr, accelAddress + (i * 3), 1, (uint16_t *)&offsets[i], I2Cdev::readTimeout, wireObj);
+	I2Cdev::readWords(devAddr, 0x13, 3, (uint16_t *)&offsets[3], I2Cdev::readTimeout, wireObj);
+
+	calibrator.begin(offsets, 16384 >> getFullScaleAccelRange(), true);
+
+	uint32_t next = micros();
+	for (uint16_t n = 0; n < maxIterations; n++) {
+		while ((int32_t)(micros() - next) < 0);
+		next += MPU6050_CALIBRATION_PERIOD_US;
+
+		if (I2Cdev::readBytes(devAddr, MPU6050_RA_ACCEL_XOUT_H, 14, buffer, I2Cdev::readTimeout, wireObj) != 14) continue;
+		for (int i = 0; i < 3; i++) {
+			reading[i] = (((int16_t)buffer[i * 2]) << 8) | buffer[i * 2 + 1];          // Accel 0-5
+			reading[i + 3] = (((int16_t)buffer[i * 2 + 8]) << 8) | buffer[i * 2 + 9];  // Gyro 8-13
+		}
+
+		bool done = calibrator.update(reading, offsets);
+		if (packed) I2Cdev::writeWords(devAddr, accelAddress, 3, (uint16_t *)offsets, wireObj);
+		else for (int i = 0; i < 3; i++)
+			I2Cdev::writeWords(devAddr, accelAddress + (i * 3), 1, (uint16_t *)&offsets[i], wireObj);
+		I2Cdev::writeWords(devAddr, 0x13, 3, (uint16_t *)&offsets[3], wireObj);
+		if (done) break;
+	}
+
+	calibrator.getOffsets(offsets); // Integral term only
+	if (packed) I2Cdev::writeWords(devAddr, accelAddress, 3, (uint16_t *)offsets, wireObj);
+	else for (int i = 0; i < 3; i++)
+		I2Cdev::writeWords(devAddr, accelAddress + (i * 3), 1, (uint16_t *)&offsets[i], wireObj);
+	I2Cdev::writeWords(devAddr, 0x13, 3, (uint16_t *)&offsets[3], wireObj);
+
+	setRate(savedRate);
+	resetFIFO();
+	resetDMP();
+
+	result = calibrator.getResult();
+	return result.converged;
+}
+
 void MPU6050_Base::PrintActiveOffsets() {
 	uint8_t AOffsetRegister = (getDeviceID() < 0x38 )? MPU6050_RA_XA_OFFS_H:0x77;
 	int16_t Data[3];
@@ -40,6 +40,7 @@ THE SOFTWARE.
 
 #include "I2Cdev.h"
 #include "helper_3dmath.h"
+#include "MPU6050_Calibration.h"
 
 // supporting link:  http://forum.arduino.cc/index.php?&topic=143444.msg1079517#msg1079517
 // also: http://forum.arduino.cc/index.php?&topic=141571.msg1062899#msg1062899s
@@ -434,12 +435,16 @@ THE SOFTWARE.
 #define MPU6050_DMP_MEMORY_BANKS        8
 #define MPU6050_DMP_MEMORY_BANK_SIZE    256
 #define MPU6050_DMP_MEMORY_CHUNK_SIZE   16
+// Largest chunk one Wire transaction carries (the register address takes one byte of the buffer)
+#define MPU6050_DMP_MEMORY_FAST_CHUNK_SIZE  ((I2CDEVLIB_WIRE_BUFFER_LENGTH - 1) < 255 ? (I2CDEVLIB_WIRE_BUFFER_LENGTH - 1) : 255)
+#define MPU6050_DMP_MEMORY_CRC_INIT     0xFFFF // CRC-16/CCITT-FALSE
 
 #define MPU6050_FIFO_DEFAULT_TIMEOUT 11000
 
 class MPU6050_Base {
     public:
         MPU6050_Base(uint8_t address=MPU6050_DEFAULT_ADDRESS, void *wireObj=0);
+        ~MPU6050_Base();
 
         void initialize();
         bool testConnection();
@@ -723,6 +728,9 @@ class MPU6050_Base {
         void getFIFOBytes(uint8_t *data, uint8_t length);
         void setFIFOTimeout(uint32_t fifoTimeout);
         uint32_t getFIFOTimeout();
+        uint32_t getFIFOResetCount();
+        uint32_t getFIFOTrashCount();
+        uint32_t getFIFOTimeoutCount();
 
         // WHO_AM_I register
         uint8_t getDeviceID();
@@ -815,6 +823,10 @@ class MPU6050_Base {
         void readMemoryBlock(uint8_t *data, uint16_t dataSize, uint8_t bank=0, uint8_t address=0);
         bool writeMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank=0, uint8_t address=0, bool verify=true, bool useProgMem=false);
         bool writeProgMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank=0, uint8_t address=0, bool verify=true);
+        bool writeMemoryBlockFast(const uint8_t *data, uint16_t dataSize, uint8_t bank=0, uint8_t address=0, bool verify=true, bool useProgMem=false);
+        bool writeProgMemoryBlockFast(const uint8_t *data, uint16_t dataSize, uint8_t bank=0, uint8_t address=0, bool verify=true);
+        uint16_t readMemoryCRC(uint16_t dataSize, uint8_t bank=0, uint8_t address=0);
+        static uint16_t memoryCRC(const uint8_t *data, uint16_t dataSize, bool useProgMem=false, uint16_t crc=MPU6050_DMP_MEMORY_CRC_INIT);
 
         bool writeDMPConfigurationSet(const uint8_t *data, uint16_t dataSize, bool useProgMem=false);
         bool writeProgDMPConfigurationSet(const uint8_t *data, uint16_t dataSize);
@@ -831,13 +843,23 @@ class MPU6050_Base {
 		void CalibrateGyro(uint8_t Loops = 15); // Fine tune after setting offsets with less Loops.
 		void CalibrateAccel(uint8_t Loops = 15);// Fine tune after setting offsets with less Loops.
 		void PID(uint8_t ReadAddress, float kP,float kI, uint8_t Loops);  // Does the math
+		bool CalibrateFast(MPU6050_CalibrationResult &result, uint16_t maxIterations = MPU6050_CALIBRATION_MAX_ITERATIONS); // All six axes together, stops on convergence
 		void PrintActiveOffsets(); // See the results of the Calibration
 
+        // Register shadow
+        void setShadowRegistersEnabled(bool enabled);
+        bool getShadowRegistersEnabled();
+
     protected:
         uint8_t devAddr;
         void *wireObj;
         uint8_t buffer[14];
         uint32_t fifoTimeout = MPU6050_FIFO_DEFAULT_TIMEOUT;
+        uint32_t fifoResetCount = 0;
+        uint32_t fifoTrashCount = 0;
+        uint32_t fifoTimeoutCount = 0;
+        I2Cdev_Shadow shadow;
+        bool shadowEnabled = false;
 };
 
 #ifndef I2CDEVLIB_MPU6050_TYPEDEF
@@ -0,0 +1,90 @@
+/**
+ * @file MPU6050_Calibration.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Arquivo de implementação das funções da classe MPU6050_Calibrator.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <math.h>
+
+#include "MPU6050_Calibration.h"
+
+// Mesmos ganhos de MPU6050_Base::CalibrateAccel/CalibrateGyro.
+static const float g_calibrationKP[2] = {0.3f, 0.3f};    // Acelerômetro, giroscópio.
+static const float g_calibrationKI[2] = {20.0f, 90.0f};  // Acelerômetro, giroscópio.
+static const float g_calibrationScale[2] = {8.0f, 4.0f}; // LSB de leitura por LSB de offset.
+
+void MPU6050_Calibrator::begin(const int16_t *offsets, uint16_t gravity, bool keepAccelBitZero) {
+    for (int i = 0; i < MPU6050_CALIBRATION_AXES; i++) {
+        uint8_t sensor = (i < 3) ? 0 : 1;
+        iTerm[i] = offsets[i] * g_calibrationScale[sensor];
+        pTerm[i] = 0;
+        average[i] = 0;
+    }
+    for (int i = 0; i < 3; i++) bitZero[i] = offsets[i] & 1;
+    keepBitZero = keepAccelBitZero;
+    this->gravity = gravity;
+    iterations = 0;
+    settled = 0;
+}
+
+bool MPU6050_Calibrator::update(const int16_t *reading, int16_t *offsets) {
+    float accelResidual = 0;
+    float gyroResidual = 0;
+
+    for (int i = 0; i < MPU6050_CALIBRATION_AXES; i++) {
+        uint8_t sensor = (i < 3) ? 0 : 1;
+        float error = reading[i];
+        if (i == 2) error -= gravity; // Remove a gravidade do eixo Z.
+
+        average[i] += (error - average[i]) * MPU6050_CALIBRATION_AVERAGE_WEIGHT;
+        pTerm[i] = -error * g_calibrationKP[sensor];
+        iTerm[i] += -error * 0.001f * g_calibrationKI[sensor]; // 1000 iterações por segundo.
+
+        float residual = fabsf(average[i]);
+        if (sensor == 0 && residual > accelResidual) accelResidual = residual;
+        if (sensor == 1 && residual > gyroResidual) gyroResidual = residual;
+    }
+
+    iterations++;
+    computeOffsets(true, offsets);
+
+    if (iterations >= MPU6050_CALIBRATION_MIN_ITERATIONS &&
+        accelResidual < MPU6050_CALIBRATION_ACCEL_TOLERANCE &&
+        gyroResidual < MPU6050_CALIBRATION_GYRO_TOLERANCE) settled++;
+    else settled = 0;
+
+    return settled >= MPU6050_CALIBRATION_SETTLE_ITERATIONS;
+}
+
+void MPU6050_Calibrator::getOffsets(int16_t *offsets) {
+    computeOffsets(false, offsets);
+}
+
+MPU6050_CalibrationResult MPU6050_Calibrator::getResult() {
+    MPU6050_CalibrationResult result;
+
+    result.iterations = iterations;
+    result.accelResidual = 0;
+    result.gyroResidual = 0;
+    for (int i = 0; i < MPU6050_CALIBRATION_AXES; i++) {
+        float residual = fabsf(average[i]);
+        if (i < 3 && residual > result.accelResidual) result.accelResidual = residual;
+        if (i >= 3 && residual > result.gyroResidual) result.gyroResidual = residual;
+    }
+    result.converged = settled >= MPU6050_CALIBRATION_SETTLE_ITERATIONS;
+
+    return result;
+}
+
+void MPU6050_Calibrator::computeOffsets(bool withProportional, int16_t *offsets) {
+    for (int i = 0; i < MPU6050_CALIBRATION_AXES; i++) {
+        uint8_t sensor = (i < 3) ? 0 : 1;
+        float output = iTerm[i] + (withProportional ? pTerm[i] : 0);
+        offsets[i] = (int16_t)lroundf(output / g_calibrationScale[sensor]);
+        if (sensor == 0 && keepBitZero) offsets[i] = (offsets[i] & 0xFFFE) | bitZero[i]; // Bit 0 reservado.
+    }
+}
@@ -11,12 +11,14 @@
 
 #include "DebugService.h"
 
-unsigned long g_lastMemUse = 0; // Millis() em que foi mostrado o uso de memória pela última vez.
+unsigned long g_lastMemUse = 0;      // Millis() em que foi mostrado o uso de memória pela última vez.
+unsigned long g_lastStageTiming = 0; // Millis() em que foi mostrado o tempo das etapas pela última vez.
 
 void DebugClass::begin(HardwareSerial *newSerial)
 {
     m_serial = newSerial;
     m_serial->begin(115200);
+    Logger.begin(m_serial);
 
     m_showYPR = true;
     m_showAcc = true;
@@ -24,6 +26,7 @@ void DebugClass::begin(HardwareSerial *newSerial)
     m_showDevState = true;
     m_showMemUsage = false;
     m_showTemperature = false;
+    m_showStageTiming = false;
 }
 
 void DebugClass::handle()
@@ -61,7 +64,7 @@ void DebugClass::handle()
     }
 
     if(m_showAcc || m_showDevState || m_showGyro || m_showYPR)
-        m_serial->printf("\n");
+        Logger.printf("\n");
         
     YPR();
     Acc();
@@ -69,6 +72,7 @@ void DebugClass::handle()
     DeviceState();
     memUsage();
     Temperature();
+    StageTiming();
 }
 
 void DebugClass::setDevice(IMUSensor *device)
@@ -106,12 +110,73 @@ void DebugClass::setShowTemperature(bool newValue)
     m_showTemperature = newValue;
 }
 
+void DebugClass::setShowStageTiming(bool newValue)
+{
+    m_showStageTiming = newValue;
+}
+
+void DebugClass::printStageTiming()
+{
+    IMUStageStats_t stats;
+
+    Logger.printf("\nStage timing (us) >> min/avg/max | hist: <1, <2, <4, ...");
+    for(uint8_t i = 0; i < STAGE_COUNT; i++)
+    {
+        Profiler.getStats((IMUStage_e)i, stats);
+
+        float average = (stats.Count == 0) ? 0 : ProfilerClass::toMicros(stats.Sum / stats.Count);
+        float minimum = (stats.Count == 0) ? 0 : ProfilerClass::toMicros(stats.Min);
+        Logger.printf("\n%-16s n: %u | %.1f/%.1f/%.1f |", ProfilerClass::stageName((IMUStage_e)i), stats.Count, 
+                                                             minimum, average, ProfilerClass::toMicros(stats.Max));
+
+        for(uint8_t j = 0; j < IMU_PROFILER_BUCKETS; j++)
+            Logger.printf(" %u", stats.Histogram[j]);
+    }
+}
+
+void DebugClass::printHealth()
+{
+    IMUHealth_t health;
+    m_device->getHealth(health);
+
+    Logger.printf("\nHealth >> Samples: %u", health.Samples);
+    Logger.printf("\nFIFO >> Overflows: %u | Resets: %u | Timeouts: %u | Trash bytes: %u", health.FifoOverflows, health.FifoResets, 
+                                                                                            health.FifoTimeouts, health.TrashBytes);
+    Logger.printf("\nI2C >> Read failures: %u | Read timeouts: %u | Write failures: %u | Shadow hits: %u", health.I2CReadFailures, 
+                  health.I2CReadTimeouts, health.I2CWriteFailures, health.I2CShadowHits);
+    Logger.printf("\nInterval (us) >> p50: %u | p90: %u | p99: %u | max: %u", health.IntervalP50, health.IntervalP90, 
+                                                                                 health.IntervalP99, health.IntervalMax);
+    Logger.printf("\nStack >> Free (min): %u | Size: %u", health.StackHighWaterMark, health.StackSize);
+    Logger.printf("\nBoot >> DMP init: %u us | Warm start: %s", health.DmpInitTime, health.DmpWarmStart ? "yes" : "no");
+    Logger.printf("\nRecovery >> Count: %u | Last outage: %u ms | Total outage: %u ms", health.SensorRecoveries, health.LastOutage, 
+                  health.TotalOutage);
+    Logger.printf("\nGyro bias >> Windows: %u | Corrections: %u | Model nodes: %u | Model corrections: %u", health.GyroBiasWindows, 
+                  health.GyroBiasCorrections, health.GyroModelNodes, health.GyroModelCorrections);
+    Logger.printf("\nLog >> Dropped bytes: %u | Dropped writes: %u | Buffer peak: %u/%u", Logger.getDroppedBytes(), Logger.getDroppedMessages(), 
+                                                                                        Logger.getHighWaterMark(), LOGGER_BUFFER_SIZE);
+}
+
+void DebugClass::printBusStats()
+{
+    I2Cdev_StatsRange range;
+    uint16_t utilization = I2Cdev::getBusUtilization();
+
+    Logger.printf("\nBus >> Utilization: %u.%02u%% | Enabled: %s", utilization / 100, utilization % 100, 
+                  I2Cdev::getStatsEnabled() ? "yes" : "no");
+    for(uint8_t i = 0; i < I2Cdev::getStatsRangeCount(); i++)
+    {
+        I2Cdev::getStatsRange(i, &range);
+        Logger.printf("\n%-8s 0x%02X [%02X-%02X] n: %u | bytes: %u | bus: %u us | errors: %u | timeouts: %u", range.name, range.devAddr, 
+                      range.firstReg, range.lastReg, range.transactions, range.bytes, range.busTime, range.errors, range.timeouts);
+    }
+}
+
 void DebugClass::YPR()
 {
     if(m_showYPR)
     {
         IMUAxisData_t newData = m_device->getAxisData();
-        m_serial->printf(" | YPR: %.2f, %.2f, %.2f", newData.Yaw, newData.Pitch, newData.Roll);
+        Logger.printf(" | YPR: %.2f, %.2f, %.2f", newData.Yaw, newData.Pitch, newData.Roll);
     }
 }
 
@@ -121,7 +186,7 @@ void DebugClass::Acc()
     {
         IMUAxisData_t newData = m_device->getAxisData();
         double geralAccel = sqrt(pow(newData.Acc_X, 2) + pow(newData.Acc_Y, 2) + pow(newData.Acc_Z, 2));
-        m_serial->printf(" | Acc: %.2f, %.2f, %.2f, geral: %.4f", newData.Acc_X, newData.Acc_Y, newData.Acc_Z, geralAccel);
+        Logger.printf(" | Acc: %.2f, %.2f, %.2f, geral: %.4f", newData.Acc_X, newData.Acc_Y, newData.Acc_Z, geralAccel);
     }
 }
 
@@ -130,7 +195,7 @@ void DebugClass::Gyro()
     if(m_showGyro)
     {
         IMUAxisData_t newData = m_device->getAxisData();
-        m_serial->printf(" | Gyro: %.2f, %.2f, %.2f", newData.Gyro_X, newData.Gyro_Y, newData.Gyro_Z);
+        Logger.printf(" | Gyro: %.2f, %.2f, %.2f", newData.Gyro_X, newData.Gyro_Y, newData.Gyro_Z);
     }
 }
 
@@ -141,19 +206,19 @@ void DebugClass::DeviceState()
         switch (m_devState)
         {
         case DeviceState_e::STATE_STOPPED:
-            m_serial->printf(" | parado |");
+            Logger.printf(" | parado |");
             break;
         case DeviceState_e::STATE_MOVING:
-            m_serial->printf(" | em movimento |");
+            Logger.printf(" | em movimento |");
             break;
         case DeviceState_e::STATE_TIPPED:
-            m_serial->printf(" | tombado |");
+            Logger.printf(" | tombado |");
             break;
         case DeviceState_e::STATE_TAMPER:
-            m_serial->printf(" | tamper |");
+            Logger.printf(" | tamper |");
             break;
         default:
-            m_serial->printf(" | estado do dispositivo nao reconhecido |");
+            Logger.printf(" | estado do dispositivo nao reconhecido |");
             break;
         }
     }
@@ -165,7 +230,7 @@ void DebugClass::memUsage()
     {
         if((millis() - g_lastMemUse) > 10000)
         {
-            m_serial->printf("\nFree heap: %d | PSRam: %d", ESP.getFreeHeap(), ESP.getFreePsram());
+            Logger.printf("\nFree heap: %d | PSRam: %d", ESP.getFreeHeap(), ESP.getFreePsram());
             g_lastMemUse = millis();
         }
     }
@@ -176,7 +241,19 @@ void DebugClass::Temperature()
     if(m_showTemperature)
     {
         IMUAxisData_t newData = m_device->getAxisData();
-        m_serial->printf("\nTemperature: %.2f", newData.Temperature);
+        Logger.printf("\nTemperature: %.2f", newData.Temperature);
+    }
+}
+
+void DebugClass::StageTiming()
+{
+    if(m_showStageTiming)
+    {
+        if((millis() - g_lastStageTiming) > 10000)
+        {
+            printStageTiming();
+            g_lastStageTiming = millis();
+        }
     }
 }
 
@@ -0,0 +1,106 @@
+/**
+ * @file I2CRecordService.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Arquivo de implementação das funções da classe I2CRecordClass.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "I2CRecordService.h"
+
+bool I2CRecordClass::begin(size_t capacity)
+{
+    if(m_buffer != NULL)
+        return true;
+
+    m_buffer = (uint8_t *)malloc(capacity);
+    if(m_buffer == NULL)
+        return false;
+
+    m_recorder.begin(m_buffer, capacity);
+    return true;
+}
+
+void I2CRecordClass::start()
+{
+    if(!begin())
+    {
+        Logger.printf("\n[I2CRecord] Sem memoria para o log!");
+        return;
+    }
+
+    // O log não pode mudar enquanto está sendo enviado.
+    m_dumping = false;
+    I2Cdev::setTap(NULL);
+    m_recorder.start(micros());
+    I2Cdev::setTap(tap, this);
+}
+
+void I2CRecordClass::stop()
+{
+    I2Cdev::setTap(NULL);
+    m_recorder.stop();
+
+    Logger.printf("\nI2C log >> Records: %u | Size: %u/%u bytes | Full: %s", m_recorder.getRecords(), (unsigned)m_recorder.getSize(), 
+                  (unsigned)m_recorder.getCapacity(), m_recorder.isFull() ? "yes" : "no");
+}
+
+void I2CRecordClass::dump()
+{
+    I2Cdev::setTap(NULL);
+    m_recorder.stop();
+
+    if(m_recorder.getSize() == 0)
+        return;
+
+    m_nextBlock = 0;
+    m_dumping = true;
+}
+
+void I2CRecordClass::handle()
+{
+    if(!m_dumping)
+        return;
+
+    size_t size = m_recorder.getSize();
+    uint16_t blocks = (size + I2CLOG_BLOCK_SIZE - 1) / I2CLOG_BLOCK_SIZE;
+    uint8_t frame[I2CLOG_MAX_FRAME_SIZE];
+    uint8_t encoded[FRAMING_COBS_MAX_SIZE(I2CLOG_MAX_FRAME_SIZE) + 2];
+
+    for(uint8_t i = 0; i < I2C_RECORD_BLOCKS_PER_HANDLE && m_nextBlock < blocks; i++, m_nextBlock++)
+    {
+        size_t offset = (size_t)m_nextBlock * I2CLOG_BLOCK_SIZE;
+        size_t length = (size - offset < I2CLOG_BLOCK_SIZE) ? size - offset : I2CLOG_BLOCK_SIZE;
+        size_t index = 0;
+
+        frame[index++] = I2CLOG_FRAME_BLOCK;
+        frame[index++] = m_nextBlock & 0xFF;
+        frame[index++] = m_nextBlock >> 8;
+        frame[index++] = blocks & 0xFF;
+        frame[index++] = blocks >> 8;
+        memcpy(&frame[index], m_recorder.getData() + offset, length);
+        index += length;
+
+        uint16_t crc = crc16CCITT(frame, index);
+        frame[index++] = crc & 0xFF;
+        frame[index++] = crc >> 8;
+
+        // Delimitador antes e depois: o texto do Logger entre os quadros vira um quadro inválido.
+        encoded[0] = FRAMING_DELIMITER;
+        size_t encodedLength = 1 + cobsEncode(frame, index, &encoded[1]);
+        encoded[encodedLength++] = FRAMING_DELIMITER;
+        Logger.write(encoded, encodedLength);
+    }
+
+    if(m_nextBlock >= blocks)
+        m_dumping = false;
+}
+
+void I2CRecordClass::tap(uint8_t devAddr, uint8_t regAddr, uint8_t flags, uint16_t length, const void *data, void *context)
+{
+    ((I2CRecordClass *)context)->m_recorder.record(micros(), devAddr, regAddr, flags, length, data);
+}
+
+I2CRecordClass I2CRecord;
@@ -9,6 +9,133 @@
  * 
  */
 #include "MessageService.h"
+#include "I2CRecordService.h"
+
+/**
+ * @brief Escreve um inteiro em little-endian.
+ * 
+ * @param buffer Buffer de saída.
+ * @param index Posição de escrita (avança com a escrita).
+ * @param value Valor.
+ * @param size Quantidade de bytes.
+ */
+static void putLE(uint8_t *buffer, uint8_t &index, uint32_t value, uint8_t size)
+{
+    for(uint8_t i = 0; i < size; i++)
+        buffer[index++] = (value >> (8 * i)) & 0xFF;
+}
+
+/**
+ * @brief Lê um inteiro de 32 bits em little-endian.
+ * 
+ * @param buffer Buffer de entrada.
+ * @return int32_t - Valor lido.
+ */
+static int32_t getLE32(const uint8_t *buffer)
+{
+    return (int32_t)((uint32_t)buffer[0] | ((uint32_t)buffer[1] << 8) | 
+                     ((uint32_t)buffer[2] << 16) | ((uint32_t)buffer[3] << 24));
+}
+
+/**
+ * @brief Altera um parâmetro de detecção em uma cópia das configurações.
+ * 
+ * @param settings Configurações que serão alteradas.
+ * @param parameter Parâmetro (ConfigParameter_e).
+ * @param value Valor na escala do protocolo.
+ * @return ConfigStatus_e - CONFIG_STATUS_OK ou o motivo da rejeição.
+ */
+static ConfigStatus_e setParameter(IMUDetectionSettings_t &settings, uint8_t parameter, int32_t value)
+{
+    int32_t maximum;
+
+    switch (parameter)
+    {
+    case CONFIG_TIPPING_MIN_SAMPLES:
+        maximum = UINT16_MAX;
+        break;
+    case CONFIG_TIPPING_THRESHOLD:
+        maximum = 180 * CONFIG_ANGLE_SCALE;
+        break;
+    case CONFIG_MOVEMENT_INTERVAL:
+    case CONFIG_STOP_INTERVAL:
+        maximum = CONFIG_INTERVAL_SCALE;
+        break;
+    case CONFIG_MOVEMENT_MIN_SAMPLES:
+    case CONFIG_STOP_MIN_SAMPLES:
+    case CONFIG_TAMPER_MIN_SAMPLES:
+    case CONFIG_TAMPER_TIME:
+        maximum = UINT8_MAX;
+        break;
+    default:
+        return CONFIG_STATUS_UNKNOWN_PARAMETER;
+    }
+
+    if(value < 0 || value > maximum)
+        return CONFIG_STATUS_OUT_OF_RANGE;
+
+    switch (parameter)
+    {
+    case CONFIG_TIPPING_MIN_SAMPLES:
+        settings.Tipping.MinimumSamples = value;
+        break;
+    case CONFIG_TIPPING_THRESHOLD:
+        settings.Tipping.TippingStartThreshold = value / CONFIG_ANGLE_SCALE;
+        break;
+    case CONFIG_MOVEMENT_MIN_SAMPLES:
+        settings.Movement.MinimumSamples = value;
+        break;
+    case CONFIG_MOVEMENT_INTERVAL:
+        settings.Movement.MovementInterval = value / CONFIG_INTERVAL_SCALE;
+        break;
+    case CONFIG_STOP_MIN_SAMPLES:
+        settings.Stop.MinimumSamples = value;
+        break;
+    case CONFIG_STOP_INTERVAL:
+        settings.Stop.StopInterval = value / CONFIG_INTERVAL_SCALE;
+        break;
+    case CONFIG_TAMPER_MIN_SAMPLES:
+        settings.Tamper.MinimumSamples = value;
+        break;
+    case CONFIG_TAMPER_TIME:
+        settings.Tamper.TamperTime = value;
+        break;
+    }
+
+    return CONFIG_STATUS_OK;
+}
+
+/**
+ * @brief Retorna um parâmetro de detecção na escala do protocolo.
+ * 
+ * @param settings Configurações atuais.
+ * @param parameter Parâmetro (ConfigParameter_e).
+ * @return int32_t - Valor do parâmetro.
+ */
+static int32_t getParameter(const IMUDetectionSettings_t &settings, uint8_t parameter)
+{
+    switch (parameter)
+    {
+    case CONFIG_TIPPING_MIN_SAMPLES:
+        return settings.Tipping.MinimumSamples;
+    case CONFIG_TIPPING_THRESHOLD:
+        return lround(settings.Tipping.TippingStartThreshold * CONFIG_ANGLE_SCALE);
+    case CONFIG_MOVEMENT_MIN_SAMPLES:
+        return settings.Movement.MinimumSamples;
+    case CONFIG_MOVEMENT_INTERVAL:
+        return lround(settings.Movement.MovementInterval * CONFIG_INTERVAL_SCALE);
+    case CONFIG_STOP_MIN_SAMPLES:
+        return settings.Stop.MinimumSamples;
+    case CONFIG_STOP_INTERVAL:
+        return lround(settings.Stop.StopInterval * CONFIG_INTERVAL_SCALE);
+    case CONFIG_TAMPER_MIN_SAMPLES:
+        return settings.Tamper.MinimumSamples;
+    case CONFIG_TAMPER_TIME:
+        return settings.Tamper.TamperTime;
+    default:
+        return 0;
+    }
+}
 
 void MessageServiceClass::begin()
 {
@@ -17,94 +144,325 @@ void MessageServiceClass::begin()
 
 void MessageServiceClass::handle()
 {
-    if(Serial.available())
+    // Processa apenas os bytes já recebidos; quadros incompletos continuam na próxima chamada.
+    int available = Serial.available();
+
+    // O intervalo entre chamadas (período do loop) é maior que COMMAND_FRAME_TIMEOUT: o
+    // tempo do quadro incompleto só corre a partir de uma chamada sem bytes novos.
+    if(available <= 0)
+    {
+        m_parser.idle(millis());
+        return;
+    }
+
+    while(available-- > 0)
     {
-        std::vector<uint8_t> buffer;
-        while(Serial.available())
+        if(m_parser.feed(Serial.read()))
+            handleCommand(m_parser.getPayload(), m_parser.getLength());
+    }
+}
+
+void MessageServiceClass::handleCommand(const uint8_t *command, uint8_t length)
+{
+    if(length < 2)
+        return;
+
+    if(command[0] == 0x90)
+    {
+        // Configuração de Sensibilidade
+        if(command[1] <= 0x04 && length < 4)
+            return;
+
+        switch (command[1])
         {
-            buffer.push_back(Serial.read());
-            delay(7);
+        // Configurando sensibilidade do Tipping.
+        case 0x01:
+        {
+            IMUTippingSettings_t newSettings;
+            newSettings.MinimumSamples = command[2];
+            newSettings.TippingStartThreshold = command[3];
+            Logger.printf("\nTipping Config >> MinSamples: %d | StartThreshold: %.2f", newSettings.MinimumSamples, newSettings.TippingStartThreshold);
+            m_device->configureTipping(newSettings);
+            break;
+        }
+        // Configurando sensibilidade do Movement.
+        case 0x02:
+        {
+            IMUMovementSettings_t newSettings;
+            newSettings.MinimumSamples = command[2];
+            newSettings.MovementInterval = ((double)command[3])/100;
+            Logger.printf("\nMovement Config >> MinSamples: %d | MovementInterval: Acc > %.2f || Acc < %.2f", newSettings.MinimumSamples, 1 + newSettings.MovementInterval, 1 - newSettings.MovementInterval);
+            m_device->configureMovementDetection(newSettings);
+            break;
+        }
+        // Configurando sensibilidade do Stop.
+        case 0x03:
+        {
+            IMUStopSettings_t newSettings;
+            newSettings.MinimumSamples = command[2];
+            newSettings.StopInterval = ((double)command[3])/100;
+            Logger.printf("\nStop Config >> MinSamples: %d | StopInterval: Acc < %.2f && Acc > %.2f", newSettings.MinimumSamples, 1 + newSettings.StopInterval, 1 - newSettings.StopInterval);
+            m_device->configureStopDetection(newSettings);
+            break;
+        }
+        case 0x04:
+        {
+            IMUTamperSettings_t newSettings;
+            newSettings.MinimumSamples = command[2];
+            newSettings.TamperTime = command[3];
+            Logger.printf("\nTamper Config >> MinSamples: %d | TamperTime: %d s", newSettings.MinimumSamples, newSettings.TamperTime);
+            m_device->configureTamperDetection(newSettings);
+            break;
         }
+        case 0x05:
+            ESP.restart();
+            break;
+        // Apagando os offsets salvos; a calibração volta a ser oferecida no próximo boot.
+        case 0x08:
+            OffsetStore.clear();
+            Logger.printf("\nStored offsets erased.");
+            break;
+        // Selecionando o perfil de detecção.
+        case 0x06:
+        {
+            if(length < 3 || command[2] >= IMU_PROFILE_COUNT)
+                break;
 
-        if(buffer[0] == 0x90)
+            m_device->applyProfile((IMUProfile_e)command[2]);
+            Logger.printf("\nProfile >> %s", g_profiles[command[2]].Name);
+            break;
+        }
+        // Associando um perfil a um estado do dispositivo.
+        case 0x07:
         {
-            // Configuração de Sensibilidade
-            switch (buffer[1])
-            {
-            // Configurando sensibilidade do Tipping.
-            case 0x01:
-            {
-                IMUTippingSettings_t newSettings;
-                newSettings.MinimumSamples = buffer[2];
-                newSettings.TippingStartThreshold = buffer[3];
-                Serial.printf("\nTipping Config >> MinSamples: %d | StartThreshold: %.2f", newSettings.MinimumSamples, newSettings.TippingStartThreshold);
-                m_device->configureTipping(newSettings);
+            if(length < 4 || command[2] >= g_stateCount)
                 break;
-            }
-            // Configurando sensibilidade do Movement.
-            case 0x02:
+
+            m_device->setStateProfile((DeviceState_e)command[2], (IMUProfile_e)command[3]);
+            Logger.printf("\nState Profile >> State: %d | Profile: %s", command[2], 
+                          (command[3] < IMU_PROFILE_COUNT) ? g_profiles[command[3]].Name : "base");
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    else if(command[0] == 0x80)
+    {
+        // Configuração de Debug.
+        if(length < 3)
+            return;
+
+        switch (command[1])
+        {
+        case 0x01:
+            Debug.setShowYPR(command[2] == 0x01);
+            break;
+        case 0x02:
+            Debug.setShowAcc(command[2] == 0x01);
+            break;
+        case 0x03:
+            Debug.setShowGyro(command[2] == 0x01);
+            break;
+        case 0x04:
+            Debug.setShowDevState(command[2] == 0x01);
+            break;
+        case 0x05:
+            Debug.setShowMemUsage(command[2] == 0x01);
+            break;
+        case 0x06:
+            Debug.setShowTemperature(command[2] == 0x01);
+            break;
+        case 0x07:
+            Debug.setShowStageTiming(command[2] == 0x01);
+            break;
+        default:
+            break;
+        }
+    }
+    else if(command[0] == 0x70)
+    {
+        // Consultas de diagnóstico.
+        switch (command[1])
+        {
+        case 0x01:
+            Debug.printStageTiming();
+            break;
+        case 0x02:
+            Profiler.reset();
+            Logger.printf("\nStage timing reset.");
+            break;
+        case 0x03:
+            Debug.printHealth();
+            Logger.printf("\nCmd >> CRC errors: %u | Framing errors: %u", m_parser.getCRCErrors(), m_parser.getFramingErrors());
+            break;
+        case 0x04:
+            Debug.printBusStats();
+            break;
+        case 0x05:
+            I2Cdev::resetStats();
+            Logger.printf("\nBus stats reset.");
+            break;
+        case 0x06:
+            I2CRecord.start();
+            break;
+        case 0x07:
+            I2CRecord.stop();
+            break;
+        case 0x08:
+            I2CRecord.dump();
+            break;
+        default:
+            break;
+        }
+    }
+    else if(command[0] == CONFIG_COMMAND)
+    {
+        // Protocolo versionado de configuração.
+        handleConfig(command, length);
+    }
+}
+
+void MessageServiceClass::handleConfig(const uint8_t *command, uint8_t length)
+{
+    // Sem a sequência não há como associar a resposta ao comando.
+    if(length < CONFIG_HEADER_SIZE)
+        return;
+
+    uint8_t response[COMMAND_MAX_PAYLOAD];
+    uint8_t size = 0;
+
+    response[size++] = CONFIG_RESPONSE;
+    response[size++] = CONFIG_PROTOCOL_VERSION;
+    response[size++] = command[2];
+    response[size++] = command[3];
+
+    uint8_t statusIndex = size++;
+    ConfigStatus_e status = CONFIG_STATUS_OK;
+
+    const uint8_t *arguments = &command[CONFIG_HEADER_SIZE];
+    uint8_t argumentsLength = length - CONFIG_HEADER_SIZE;
+
+    if(command[1] != CONFIG_PROTOCOL_VERSION)
+    {
+        status = CONFIG_STATUS_UNSUPPORTED_VERSION;
+    }
+    else if(m_device == NULL)
+    {
+        status = CONFIG_STATUS_NOT_READY;
+    }
+    else
+    {
+        switch (command[2])
+        {
+        case CONFIG_OP_SET_SETTINGS:
+        {
+            if(argumentsLength == 0 || argumentsLength % CONFIG_ITEM_SIZE != 0)
             {
-                IMUMovementSettings_t newSettings;
-                newSettings.MinimumSamples = buffer[2];
-                newSettings.MovementInterval = ((double)buffer[3])/100;
-                Serial.printf("\nMovement Config >> MinSamples: %d | MovementInterval: Acc > %.2f || Acc < %.2f", newSettings.MinimumSamples, 1 + newSettings.MovementInterval, 1 - newSettings.MovementInterval);
-                m_device->configureMovementDetection(newSettings);
+                status = CONFIG_STATUS_MALFORMED;
                 break;
             }
-            // Configurando sensibilidade do Stop.
-            case 0x03:
+
+            // Valida todos os pares em uma cópia antes de aplicar qualquer alteração.
+            IMUDetectionSettings_t settings = m_device->getSettings();
+            for(uint8_t i = 0; i < argumentsLength; i += CONFIG_ITEM_SIZE)
             {
-                IMUStopSettings_t newSettings;
-                newSettings.MinimumSamples = buffer[2];
-                newSettings.StopInterval = ((double)buffer[3])/100;
-                Serial.printf("\nStop Config >> MinSamples: %d | StopInterval: Acc < %.2f && Acc > %.2f", newSettings.MinimumSamples, 1 + newSettings.StopInterval, 1 - newSettings.StopInterval);
-                m_device->configureStopDetection(newSettings);
-                break;
+                status = setParameter(settings, arguments[i], getLE32(&arguments[i + 1]));
+                if(status != CONFIG_STATUS_OK)
+                {
+                    response[size++] = arguments[i];
+                    break;
+                }
             }
-            case 0x04:
+
+            if(status == CONFIG_STATUS_OK)
+                m_device->configure(settings);
+            break;
+        }
+        case CONFIG_OP_GET_SETTINGS:
+        {
+            IMUDetectionSettings_t settings = m_device->getSettings();
+            for(uint8_t parameter = CONFIG_TIPPING_MIN_SAMPLES; parameter <= CONFIG_TAMPER_TIME; parameter++)
             {
-                IMUTamperSettings_t newSettings;
-                newSettings.MinimumSamples = buffer[2];
-                newSettings.TamperTime = buffer[3];
-                Serial.printf("\nTamper Config >> MinSamples: %d | TamperTime: %d s", newSettings.MinimumSamples, newSettings.TamperTime);
-                m_device->configureTamperDetection(newSettings);
-                break;
-            }
-            case 0x05:
-                ESP.restart();
-                break;
-            default:
-                break;
+                response[size++] = parameter;
+                putLE(response, size, getParameter(settings, parameter), 4);
             }
+            break;
         }
-        else if(buffer[0] == 0x80)
+        case CONFIG_OP_GET_OFFSETS:
         {
-            // Configuração de Debug.
-            switch (buffer[1])
+            IMUOffsets_t offsets = m_device->getCurrentOffsets();
+            putLE(response, size, offsets.XAccelOffset, 2);
+            putLE(response, size, offsets.YAccelOffset, 2);
+            putLE(response, size, offsets.ZAccelOffset, 2);
+            putLE(response, size, offsets.XGyroOffset, 2);
+            putLE(response, size, offsets.YGyroOffset, 2);
+            putLE(response, size, offsets.ZGyroOffset, 2);
+            break;
+        }
+        case CONFIG_OP_GET_RATE:
+        {
+            IMUHealth_t health;
+            m_device->getHealth(health);
+            putLE(response, size, (health.IntervalP50 > 0) ? 100000000UL / health.IntervalP50 : 0, 4);
+            putLE(response, size, health.IntervalP50, 4);
+            break;
+        }
+        case CONFIG_OP_GET_STATS:
+        {
+            IMUHealth_t health;
+            m_device->getHealth(health);
+
+            const uint32_t stats[CONFIG_STATS_COUNT] = {
+                health.Samples, health.FifoOverflows, health.FifoResets, health.FifoTimeouts, health.TrashBytes,
+                health.I2CReadFailures, health.I2CReadTimeouts, health.I2CWriteFailures,
+                health.IntervalP50, health.IntervalP90, health.IntervalP99, health.IntervalMax,
+                health.StackHighWaterMark, health.StackSize
+            };
+
+            for(uint8_t i = 0; i < CONFIG_STATS_COUNT; i++)
+                putLE(response, size, stats[i], 4);
+            break;
+        }
+        case CONFIG_OP_GET_BUS_STATS:
+        {
+            I2Cdev_StatsRange range;
+            uint8_t index = (argumentsLength > 0) ? arguments[0] : 0;
+            if(!I2Cdev::getStatsRange(index, &range))
             {
-            case 0x01:
-                Debug.setShowYPR(buffer[2] == 0x01);
-                break;
-            case 0x02:
-                Debug.setShowAcc(buffer[2] == 0x01);
-                break;
-            case 0x03:
-                Debug.setShowGyro(buffer[2] == 0x01);
-                break;
-            case 0x04:
-                Debug.setShowDevState(buffer[2] == 0x01);
-                break;
-            case 0x05:
-                Debug.setShowMemUsage(buffer[2] == 0x01);
-                break;
-            case 0x06:
-                Debug.setShowTemperature(buffer[2] == 0x01);
-                break;
-            default:
+                status = CONFIG_STATUS_OUT_OF_RANGE;
                 break;
             }
+
+            response[size++] = I2Cdev::getStatsRangeCount();
+            response[size++] = range.devAddr;
+            response[size++] = range.firstReg;
+            response[size++] = range.lastReg;
+            putLE(response, size, range.transactions, 4);
+            putLE(response, size, range.bytes, 4);
+            putLE(response, size, range.busTime, 4);
+            putLE(response, size, range.errors, 4);
+            putLE(response, size, range.timeouts, 4);
+            putLE(response, size, I2Cdev::getBusUtilization(), 2);
+            break;
+        }
+        default:
+            status = CONFIG_STATUS_UNKNOWN_OPERATION;
+            break;
         }
     }
+
+    response[statusIndex] = status;
+    sendResponse(response, size);
+}
+
+void MessageServiceClass::sendResponse(const uint8_t *response, uint8_t length)
+{
+    uint8_t frame[COMMAND_MAX_PAYLOAD + COMMAND_FRAME_OVERHEAD];
+    size_t size = commandEncode(response, length, frame);
+
+    if(size > 0)
+        Logger.write(frame, size);
 }
 
 void MessageServiceClass::setDevice(IMUSensor *device)
@@ -10,78 +10,88 @@
 #include <vector>
 
 #include "DebugService.h"
+#include "I2CRecordService.h"
 #include "MessageService.h"
 
+#define BOOT_PROMPT_TIMEOUT 3000 // Tempo de espera pela resposta da calibração em unidades sem offsets salvos (ms).
+
 bool g_calibrate = false;
 
-void setup() 
+/**
+ * @brief Pergunta pela serial se o sensor deve ser calibrado, aguardando
+ * a resposta por no máximo (timeout) milissegundos.
+ * @param timeout Tempo máximo de espera (ms).
+ * @return true - Caso a resposta seja 0x01.
+ * @return false - Caso a resposta seja 0x00 ou o tempo se esgote.
+ */
+bool askCalibration(unsigned long timeout)
 {
-    Debug.begin(&Serial);
+    Logger.printf("\nWould you like to calibrate? (0 or 1)");
 
-    while(1)
+    unsigned long start = millis();
+    while((millis() - start) < timeout)
     {
-        Serial.printf("\nWould you like to calibrate? (0 or 1)");
-        
         if(Serial.available())
         {
             uint8_t currentByte = Serial.read();
             if(currentByte == 0x00 || currentByte == 0x01)
-            {
-                g_calibrate = (currentByte == 1) ? true : false;
-                break;
-            }
+                return currentByte == 0x01;
         }
 
-        delay(750);
+        delay(1);
     }
-    
-    // Configurando sensibilidade das detecções.
-    IMUTippingSettings_t tippingSettings;
-    tippingSettings.MinimumSamples = 16;
-    tippingSettings.TippingStartThreshold = 140;
 
-    IMUMovementSettings_t movementSettings;
-    movementSettings.MinimumSamples = 4;
-    movementSettings.MovementInterval = 0.04;
+    return false;
+}
 
-    IMUStopSettings_t stopSettings;
-    stopSettings.MinimumSamples = 8;
-    stopSettings.StopInterval = 0.03;
+void setup() 
+{
+    Debug.begin(&Serial);
 
-    IMUTamperSettings_t tamperSettings;
-    tamperSettings.TamperTime = 10;
-    tamperSettings.MinimumSamples = 5;
+#ifdef IMU_BENCHMARK
+    Benchmark.begin("NONT");
+    Benchmark.setTask(xTaskGetCurrentTaskHandle(), MPU6050_LOOP_TASK_STACK);
+#endif
+    
+#ifdef IMU_I2C_RECORD
+    // Grava o barramento desde o boot, incluindo a inicialização do DMP.
+    I2CRecord.start();
+#endif
 
     // Instanciando o sensor e configurando-o.
     MPU.begin(Wire);
 
+#ifndef IMU_BENCHMARK
+    // Unidades com offsets salvos não perguntam; as demais esperam a resposta por tempo limitado.
+    if(!MPU.hasStoredOffsets())
+        g_calibrate = askCalibration(BOOT_PROMPT_TIMEOUT);
+#endif
+
     if(g_calibrate)
     {
         IMUOffsets_t newOffsets = MPU.calibrate();
-        Serial.printf("\n\nAccOffsets[x, y, z]: [%d, %d, %d]", newOffsets.XAccelOffset, 
+        Logger.printf("\n\nAccOffsets[x, y, z]: [%d, %d, %d]", newOffsets.XAccelOffset, 
                                                                newOffsets.YAccelOffset, 
                                                                newOffsets.ZAccelOffset);
 
-        Serial.printf("\nGyroOffsets[x, y, z]: [%d, %d, %d]\n", newOffsets.XGyroOffset, 
+        Logger.printf("\nGyroOffsets[x, y, z]: [%d, %d, %d]\n", newOffsets.XGyroOffset, 
                                                                 newOffsets.YGyroOffset, 
                                                                 newOffsets.ZGyroOffset);
     } 
     else
     {
         IMUOffsets_t currentOffsets = MPU.getCurrentOffsets();
-        Serial.printf("\n\nAccOffsets[x, y, z]: [%d, %d, %d]", currentOffsets.XAccelOffset, 
+        Logger.printf("\n\nAccOffsets[x, y, z]: [%d, %d, %d]", currentOffsets.XAccelOffset, 
                                                                currentOffsets.YAccelOffset, 
                                                                currentOffsets.ZAccelOffset);
 
-        Serial.printf("\nGyroOffsets[x, y, z]: [%d, %d, %d]\n", currentOffsets.XGyroOffset, 
+        Logger.printf("\nGyroOffsets[x, y, z]: [%d, %d, %d]\n", currentOffsets.XGyroOffset, 
                                                                 currentOffsets.YGyroOffset, 
                                                                 currentOffsets.ZGyroOffset);
     }
     
-    MPU.configureTipping(tippingSettings);
-    MPU.configureMovementDetection(movementSettings);
-    MPU.configureStopDetection(stopSettings);
-    MPU.configureTamperDetection(tamperSettings);
+    // Sensibilidade das detecções (ver lib/IMUSensorLib/src/IMUProfiles.cpp).
+    MPU.applyProfile(IMU_PROFILE_CAR);
     Debug.setDevice(&MPU);
     MessageService.setDevice(&MPU);
 }
@@ -91,5 +101,11 @@ void loop()
     MPU.handle();
     MessageService.handle();
     Debug.handle();
+    I2CRecord.handle();
+
+#ifdef IMU_BENCHMARK
+    Benchmark.handle();
+#endif
+
     delay(500); // Máximo que aguenta sem ficar dando fifo overflow.
 }
\ No newline at end of file
@@ -84,6 +84,31 @@ public:
      */
     void setShowTemperature(bool newValue);
 
+    /**
+     * @brief Muda o valor da flag que mostra ou não as
+     * estatísticas de tempo de cada etapa da leitura.
+     * @param newValue Novo valor.
+     */
+    void setShowStageTiming(bool newValue);
+
+    /**
+     * @brief Imprime as estatísticas de tempo e o histograma
+     * de cada etapa da leitura.
+     */
+    void printStageTiming();
+
+    /**
+     * @brief Imprime os contadores de saúde da leitura
+     * do dispositivo.
+     */
+    void printHealth();
+
+    /**
+     * @brief Imprime o uso do barramento I2C por faixa
+     * de registradores.
+     */
+    void printBusStats();
+
 private:
     /**
      * @brief Função que realiza o print de Yaw, Pitch
@@ -121,6 +146,12 @@ private:
      */
     void Temperature();
 
+    /**
+     * @brief Função que realiza o print periódico das
+     * estatísticas de tempo das etapas da leitura.
+     */
+    void StageTiming();
+
     IMUSensor *m_device;      // Dispositivo que será observado para obter as informações.
     HardwareSerial *m_serial; // Serial que será utilizada para debug.
     DeviceState_e m_devState; // Status atual do dispositivo.
@@ -130,6 +161,7 @@ private:
     bool m_showDevState;      // Flag que indica se informações de estado são mostradas.
     bool m_showMemUsage;      // Flag que indica se o uso de memória é mostrado.
     bool m_showTemperature;   // Flag que indica se informações de temperature são mostradas.
+    bool m_showStageTiming;   // Flag que indica se o tempo das etapas da leitura é mostrado.
 };
 
 extern DebugClass Debug;
\ No newline at end of file
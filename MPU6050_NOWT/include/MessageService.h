@@ -12,6 +12,8 @@
 
 #include "IMUSensorLib.h"
 #include "DebugService.h"
+#include "CommandParser.h"
+#include "ConfigProtocol.h"
 
 /**
  * @brief Classe que contém os atributos e 
@@ -40,7 +42,32 @@ public:
     void setDevice(IMUSensor *device);
 
 private:
-    IMUSensor *m_device; // Dispositivo que irá alterar.
+    /**
+     * @brief Executa um comando recebido em um quadro válido.
+     * 
+     * @param command Bytes do comando.
+     * @param length Quantidade de bytes do comando.
+     */
+    void handleCommand(const uint8_t *command, uint8_t length);
+
+    /**
+     * @brief Executa um comando do protocolo versionado de configuração
+     * e envia a resposta com o status da operação.
+     * @param command Bytes do comando.
+     * @param length Quantidade de bytes do comando.
+     */
+    void handleConfig(const uint8_t *command, uint8_t length);
+
+    /**
+     * @brief Envia uma resposta dentro de um quadro.
+     * 
+     * @param response Bytes da resposta.
+     * @param length Quantidade de bytes da resposta.
+     */
+    void sendResponse(const uint8_t *response, uint8_t length);
+
+    IMUSensor *m_device;    // Dispositivo que irá alterar.
+    CommandParser m_parser; // Interpretador dos quadros recebidos pela serial.
 };
 
 extern MessageServiceClass MessageService;
\ No newline at end of file
@@ -0,0 +1,111 @@
+/**
+ * @file TelemetryService.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Serviço de telemetria binária com as amostras do sensor na taxa do DMP.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include "Framing.h"
+#include "IMUSensorLib.h"
+#include "TelemetryProtocol.h"
+
+#define TELEMETRY_QUEUE_SIZE 64 // Amostras aguardando envio (640 ms a 100 Hz).
+
+/**
+ * @brief Amostra já quantizada no formato do quadro de telemetria.
+ * 
+ */
+struct TelemetrySample_t
+{
+    uint32_t Time;          // Millis() da leitura.
+    uint16_t Sequence;      // Número de sequência da amostra.
+    int16_t YPR[3];         // Yaw, Pitch e Roll.
+    int16_t Acc[3];         // Acelerômetro.
+    int16_t Gyro[3];        // Giroscópio.
+    int16_t Temperature;    // Temperatura.
+    uint8_t State;          // Estado do dispositivo.
+};
+
+/**
+ * @brief Classe que contém os atributos e métodos
+ * do serviço de telemetria binária.
+ */
+class TelemetryClass
+{
+public:
+    /**
+     * @brief Inicia o serviço de telemetria. Os quadros são enviados
+     * pelo Logger, que deve ser iniciado antes.
+     * @return true - Caso a fila de amostras seja criada.
+     * @return false - Caso contrário.
+     */
+    bool begin();
+
+    /**
+     * @brief Itera o serviço, enviando as amostras pendentes.
+     * 
+     */
+    void handle();
+
+    /**
+     * @brief Ativa ou desativa o modo binário. Com o modo binário
+     * desativado o Debug volta a imprimir em ASCII.
+     * @param newValue Novo valor.
+     */
+    void setEnabled(bool newValue);
+
+    /**
+     * @brief Retorna se o modo binário está ativo.
+     * 
+     * @return true - Caso esteja ativo.
+     * @return false - Caso contrário.
+     */
+    bool isEnabled();
+
+    /**
+     * @brief Define quais campos serão enviados em cada quadro.
+     * 
+     * @param newMask Máscara de campos (TelemetryField_e).
+     */
+    void setFieldMask(uint8_t newMask);
+
+    /**
+     * @brief Retorna quantas amostras foram descartadas por falta
+     * de espaço na fila.
+     * @return uint32_t - Amostras descartadas.
+     */
+    uint32_t getDropped();
+
+    /**
+     * @brief Recebe as amostras da task de leitura. Deve ser registrada
+     * com IMUSensor::setSampleCallback().
+     * @param data Amostra lida.
+     * @param state Estado atual do dispositivo.
+     */
+    static void onSample(const IMUAxisData_t &data, DeviceState_e state);
+
+private:
+    /**
+     * @brief Monta o quadro de uma amostra, sem a codificação COBS.
+     * 
+     * @param sample Amostra.
+     * @param frame Buffer com pelo menos TELEMETRY_MAX_FRAME_SIZE bytes.
+     * @return size_t - Tamanho do quadro.
+     */
+    size_t buildFrame(const TelemetrySample_t &sample, uint8_t *frame);
+
+    QueueHandle_t m_queue;    // Fila de amostras entre a task de leitura e o loop.
+    bool m_enabled;           // Flag que indica se o modo binário está ativo.
+    uint8_t m_fieldMask;      // Campos enviados em cada quadro.
+    uint16_t m_sequence;      // Próximo número de sequência.
+    uint32_t m_dropped;       // Amostras descartadas com a fila cheia.
+};
+
+extern TelemetryClass Telemetry;
@@ -0,0 +1,144 @@
+/**
+ * @file CommandParser.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Arquivo de implementação das funções da classe CommandParser.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "CommandParser.h"
+#include "Framing.h"
+
+size_t commandEncode(const uint8_t *payload, uint8_t length, uint8_t *output)
+{
+    if(length == 0 || length > COMMAND_MAX_PAYLOAD)
+        return 0;
+
+    size_t size = 0;
+    output[size++] = COMMAND_START_OF_FRAME;
+    output[size++] = length;
+
+    for(uint8_t i = 0; i < length; i++)
+        output[size++] = payload[i];
+
+    uint16_t crc = crc16CCITT(&output[1], size - 1);
+    output[size++] = crc & 0xFF;
+    output[size++] = crc >> 8;
+
+    return size;
+}
+
+CommandParser::CommandParser()
+{
+    m_crcErrors = 0;
+    m_framingErrors = 0;
+    m_idleSince = 0;
+    reset();
+}
+
+void CommandParser::reset()
+{
+    m_state = PARSER_WAIT_START;
+    m_length = 0;
+    m_received = 0;
+    m_crc = 0;
+    m_idle = false;
+}
+
+bool CommandParser::feed(uint8_t byte)
+{
+    m_idle = false;
+
+    switch (m_state)
+    {
+    case PARSER_WAIT_START:
+        if(byte == COMMAND_START_OF_FRAME)
+            m_state = PARSER_WAIT_LENGTH;
+        break;
+    case PARSER_WAIT_LENGTH:
+        if(byte == 0 || byte > COMMAND_MAX_PAYLOAD)
+        {
+            m_framingErrors++;
+            reset();
+            break;
+        }
+        m_length = byte;
+        m_received = 0;
+        m_state = PARSER_WAIT_PAYLOAD;
+        break;
+    case PARSER_WAIT_PAYLOAD:
+        m_payload[m_received++] = byte;
+        if(m_received == m_length)
+            m_state = PARSER_WAIT_CRC_LOW;
+        break;
+    case PARSER_WAIT_CRC_LOW:
+        m_crc = byte;
+        m_state = PARSER_WAIT_CRC_HIGH;
+        break;
+    case PARSER_WAIT_CRC_HIGH:
+    {
+        m_crc |= (uint16_t)byte << 8;
+
+        uint16_t crc = crc16CCITT(&m_length, 1);
+        crc = crc16CCITT(m_payload, m_length, crc);
+
+        m_state = PARSER_WAIT_START;
+
+        if(crc != m_crc)
+        {
+            m_crcErrors++;
+            break;
+        }
+
+        // O comando permanece disponível até o próximo byte de início.
+        return true;
+    }
+    default:
+        reset();
+        break;
+    }
+
+    return false;
+}
+
+void CommandParser::idle(uint32_t now)
+{
+    if(m_state == PARSER_WAIT_START)
+        return;
+
+    if(!m_idle)
+    {
+        m_idle = true;
+        m_idleSince = now;
+        return;
+    }
+
+    // Quadro interrompido: volta a procurar o início.
+    if(now - m_idleSince > COMMAND_FRAME_TIMEOUT)
+    {
+        m_framingErrors++;
+        reset();
+    }
+}
+
+const uint8_t *CommandParser::getPayload() const
+{
+    return m_payload;
+}
+
+uint8_t CommandParser::getLength() const
+{
+    return m_length;
+}
+
+uint32_t CommandParser::getCRCErrors() const
+{
+    return m_crcErrors;
+}
+
+uint32_t CommandParser::getFramingErrors() const
+{
+    return m_framingErrors;
+}
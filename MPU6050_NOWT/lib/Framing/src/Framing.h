@@ -0,0 +1,54 @@
+/**
+ * @file Framing.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Funções de enquadramento (COBS) e verificação (CRC-16) de mensagens
+ * binárias. Não depende do Arduino para poder ser usado também no host.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FRAMING_CRC16_INIT 0xFFFF // Valor inicial do CRC-16/CCITT-FALSE.
+#define FRAMING_DELIMITER 0x00    // Byte que delimita o fim de um quadro COBS.
+
+/**
+ * @brief Tamanho máximo de uma mensagem de (n) bytes após a codificação
+ * COBS, sem contar o delimitador.
+ */
+#define FRAMING_COBS_MAX_SIZE(n) ((n) + ((n) / 254) + 1)
+
+/**
+ * @brief Calcula o CRC-16/CCITT-FALSE (polinômio 0x1021).
+ *
+ * @param data Dados.
+ * @param length Quantidade de bytes.
+ * @param crc Valor inicial, permitindo o cálculo em partes.
+ * @return uint16_t - CRC calculado.
+ */
+uint16_t crc16CCITT(const uint8_t *data, size_t length, uint16_t crc = FRAMING_CRC16_INIT);
+
+/**
+ * @brief Codifica uma mensagem em COBS. O resultado não contém
+ * nenhum byte 0x00 e não inclui o delimitador.
+ * @param input Mensagem original.
+ * @param length Tamanho da mensagem original.
+ * @param output Buffer de saída com pelo menos FRAMING_COBS_MAX_SIZE(length) bytes.
+ * @return size_t - Tamanho da mensagem codificada.
+ */
+size_t cobsEncode(const uint8_t *input, size_t length, uint8_t *output);
+
+/**
+ * @brief Decodifica uma mensagem COBS (sem o delimitador).
+ *
+ * @param input Mensagem codificada.
+ * @param length Tamanho da mensagem codificada.
+ * @param output Buffer de saída com pelo menos (length) bytes.
+ * @return size_t - Tamanho da mensagem decodificada (0 caso seja inválida).
+ */
+size_t cobsDecode(const uint8_t *input, size_t length, uint8_t *output);
@@ -0,0 +1,51 @@
+/**
+ * @file TelemetryProtocol.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Definição do quadro binário de telemetria, compartilhada entre o
+ * firmware e o decodificador do host.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Quadro (antes da codificação COBS, inteiros em little-endian):
+ * [Tipo (1)] [Sequência (2)] [Millis (4)] [Máscara (1)] [Campos...] [CRC-16 (2)]
+ *
+ * Os campos presentes seguem a ordem dos bits da máscara:
+ * YPR         3 x int16 (graus * TELEMETRY_YPR_SCALE)
+ * Acc         3 x int16 (g * TELEMETRY_ACC_SCALE, Q12)
+ * Gyro        3 x int16 (graus/s * TELEMETRY_GYRO_SCALE, Q4)
+ * Temperatura 1 x int16 (°C * TELEMETRY_TEMPERATURE_SCALE)
+ * Estado      1 x uint8 (DeviceState_e)
+ *
+ * O CRC-16/CCITT-FALSE cobre todos os bytes anteriores a ele. Cada quadro
+ * codificado é seguido pelo delimitador 0x00.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#define TELEMETRY_FRAME_SAMPLE 0x01 // Tipo do quadro com uma amostra do sensor.
+
+#define TELEMETRY_YPR_SCALE 100.0        // Centésimos de grau.
+#define TELEMETRY_ACC_SCALE 4096.0       // Q12 (±8 g).
+#define TELEMETRY_GYRO_SCALE 16.0        // Q4 (±2048 °/s).
+#define TELEMETRY_TEMPERATURE_SCALE 100.0 // Centésimos de grau Celsius.
+
+#define TELEMETRY_HEADER_SIZE 8 // Tipo, sequência, millis e máscara.
+#define TELEMETRY_CRC_SIZE 2    // CRC-16 no fim do quadro.
+#define TELEMETRY_MAX_FRAME_SIZE (TELEMETRY_HEADER_SIZE + 6 + 6 + 6 + 2 + 1 + TELEMETRY_CRC_SIZE)
+
+/**
+ * @brief Bits da máscara de campos do quadro de amostra.
+ * 
+ */
+enum TelemetryField_e
+{
+    TELEMETRY_FIELD_YPR = 0x01,
+    TELEMETRY_FIELD_ACC = 0x02,
+    TELEMETRY_FIELD_GYRO = 0x04,
+    TELEMETRY_FIELD_TEMPERATURE = 0x08,
+    TELEMETRY_FIELD_STATE = 0x10,
+    TELEMETRY_FIELD_ALL = 0x1F
+};
@@ -0,0 +1,127 @@
+/**
+ * @file IMUFusion.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Fusão de acelerômetro e giroscópio por software (Madgwick ou Mahony),
+ * alternativa ao DMP que roda sobre os quadros brutos do FIFO.
+ * @version 0.1
+ * @date 19-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Tudo em float de precisão simples (a FPU do ESP32 não trabalha com double). As
+ * normalizações usam a raiz inversa rápida (uma iteração de Newton, erro < 0,2% que
+ * só altera o módulo, não a direção) e os ângulos usam um atan2 polinomial (erro
+ * < 0,001°). O Yaw, Pitch e Roll seguem as mesmas fórmulas de dmpGetYawPitchRoll(),
+ * então os dois caminhos entregam os ângulos na mesma convenção. Não depende do
+ * Arduino: o mesmo código roda no firmware e no benchmark do host.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "IMUSensorEnums.h"
+
+#define IMU_FUSION_MADGWICK_BETA 0.1f // Ganho do Madgwick (rad/s): maior converge mais rápido, com mais ruído.
+#define IMU_FUSION_MAHONY_KP 1.0f     // Ganho proporcional do Mahony (twoKp da implementação de referência).
+#define IMU_FUSION_MAHONY_KI 0.0f     // Ganho integral do Mahony (twoKi; 0 desliga a correção de bias).
+
+/**
+ * @brief Ganhos dos filtros (cada algoritmo usa apenas os seus).
+ *
+ */
+struct IMUFusionGains_t
+{
+    float Beta; // Madgwick.
+    float Kp;   // Mahony, proporcional.
+    float Ki;   // Mahony, integral.
+};
+
+/**
+ * @brief Filtro de orientação alimentado amostra a amostra.
+ *
+ */
+class IMUFusion
+{
+public:
+    IMUFusion();
+
+    /**
+     * @brief Escolhe o algoritmo. A orientação atual é mantida.
+     *
+     * @param algorithm Algoritmo.
+     */
+    void setAlgorithm(IMUFusionAlgorithm_e algorithm);
+
+    /**
+     * @brief Retorna o algoritmo em uso.
+     *
+     */
+    IMUFusionAlgorithm_e getAlgorithm();
+
+    /**
+     * @brief Altera os ganhos dos filtros.
+     *
+     * @param gains Novos ganhos.
+     */
+    void setGains(const IMUFusionGains_t &gains);
+
+    /**
+     * @brief Retorna os ganhos em uso.
+     *
+     */
+    IMUFusionGains_t getGains();
+
+    /**
+     * @brief Volta para a orientação inicial (quaternion identidade) e zera a
+     * integral do Mahony.
+     */
+    void reset();
+
+    /**
+     * @brief Inicia a orientação alinhada com a gravidade medida, evitando a
+     * convergência a partir da identidade. Como no DMP, o Yaw inicial não tem
+     * referência (só a variação do Yaw tem significado).
+     * @param acc Acelerômetro (X, Y, Z, em qualquer escala).
+     */
+    void reset(const float *acc);
+
+    /**
+     * @brief Processa uma amostra.
+     *
+     * @param gyro Giroscópio (X, Y, Z, rad/s).
+     * @param acc Acelerômetro (X, Y, Z, em qualquer escala; zerado ignora a correção).
+     * @param dt Intervalo desde a amostra anterior (s).
+     */
+    void update(const float *gyro, const float *acc, float dt);
+
+    /**
+     * @brief Retorna o quaternion da orientação (W, X, Y, Z).
+     *
+     */
+    void getQuaternion(float *q);
+
+    /**
+     * @brief Calcula o Yaw, Pitch e Roll na convenção de dmpGetYawPitchRoll().
+     *
+     * @param ypr Yaw, Pitch e Roll (rad).
+     */
+    void getYawPitchRoll(float *ypr);
+
+private:
+    /**
+     * @brief Passo do Madgwick (versão de 6 eixos).
+     *
+     */
+    void updateMadgwick(float gx, float gy, float gz, float ax, float ay, float az, float dt);
+
+    /**
+     * @brief Passo do Mahony (versão de 6 eixos).
+     *
+     */
+    void updateMahony(float gx, float gy, float gz, float ax, float ay, float az, float dt);
+
+    IMUFusionAlgorithm_e m_algorithm; // Algoritmo em uso.
+    IMUFusionGains_t m_gains;         // Ganhos dos filtros.
+    float m_q[4];                     // Orientação (W, X, Y, Z).
+    float m_integral[3];              // Integral do erro do Mahony (rad/s).
+};
@@ -0,0 +1,208 @@
+/**
+ * @file IMUGyroBias.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Estimador do bias do giroscópio durante os períodos de parada,
+ * usado para corrigir a deriva sem recalibrar nem reiniciar o DMP.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * As amostras são acumuladas em janelas de tempo fixo enquanto o dispositivo está
+ * parado (a taxa de amostras depende da variante). Uma janela só é aceita se a
+ * variação de cada eixo e da temperatura ficar dentro dos limites (nenhuma rotação
+ * real); sua média é o bias residual. Os limites são definidos em °/s e convertidos
+ * para a faixa do giroscópio em uso (±2000 °/s com o DMP) em setRange(). A correção é
+ * aplicada nos offsets do giroscópio em passos limitados e com intervalo mínimo,
+ * para que a orientação do DMP não sofra saltos.
+ *
+ * Cada janela aceita também alimenta o modelo do offset ideal em função da
+ * temperatura (GyroTemperatureModel): uma tabela de nós a cada 5 °C, cada um com
+ * a temperatura e o offset médios das janelas que caíram nele. Fora das paradas o
+ * modelo é interpolado linearmente entre os nós aprendidos e aplicado nos offsets,
+ * acompanhando o aquecimento do sensor sem depender de uma nova parada.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#define GYRO_BIAS_WINDOW_TIME 5000    // Duração de uma janela (ms).
+#define GYRO_BIAS_MIN_SAMPLES 8       // Amostras mínimas para aceitar uma janela.
+#define GYRO_BIAS_NOISE_LIMIT 0.3f    // Variação máxima de um eixo dentro da janela (°/s).
+#define GYRO_BIAS_TEMPERATURE_LIMIT 1.0f // Variação máxima da temperatura dentro da janela (°C).
+#define GYRO_BIAS_DEADBAND 0.023f     // Bias médio abaixo do qual nada é corrigido (°/s).
+#define GYRO_BIAS_MAX_STEP 2          // Correção máxima por eixo a cada ajuste (LSB do offset).
+#define GYRO_BIAS_MIN_INTERVAL 30000  // Intervalo mínimo entre dois ajustes (ms).
+#define GYRO_BIAS_LSB_PER_DPS 131.0f  // LSB de leitura por °/s em ±250 °/s (metade a cada faixa acima).
+#define GYRO_BIAS_OFFSET_SCALE 4.0f   // LSB de leitura em ±250 °/s por LSB do offset (metade a cada faixa acima).
+
+#define GYRO_MODEL_NODES 21            // Nós da tabela (-20 °C a 80 °C).
+#define GYRO_MODEL_MIN_TEMPERATURE -20.0f // Temperatura do primeiro nó (°C).
+#define GYRO_MODEL_NODE_SPACING 5.0f   // Distância entre dois nós (°C).
+#define GYRO_MODEL_MAX_WEIGHT 16       // Janelas a partir das quais o nó passa a ser uma média móvel.
+#define GYRO_MODEL_UPDATE_INTERVAL 10000 // Intervalo mínimo entre duas aplicações do modelo (ms).
+#define GYRO_MODEL_SAVE_INTERVAL 600000  // Intervalo mínimo entre duas gravações do modelo na NVS (ms).
+
+/**
+ * @brief Contadores do estimador de bias.
+ *
+ */
+struct IMUGyroBiasData_t
+{
+    uint32_t Windows;       // Janelas completas aceitas.
+    uint32_t Rejected;      // Janelas descartadas por rotação ou variação de temperatura.
+    uint32_t Corrections;   // Ajustes aplicados nos offsets.
+    uint32_t LastCorrection; // Millis() do último ajuste.
+    uint32_t ModelCorrections; // Ajustes aplicados pelo modelo de temperatura.
+    float Bias[3];          // Bias médio da última janela aceita (LSB de leitura na faixa em uso).
+    float Temperature;      // Temperatura média da última janela aceita (°C).
+};
+
+/**
+ * @brief Classe que acumula as amostras paradas e calcula os ajustes
+ * dos offsets do giroscópio. Não acessa o sensor.
+ */
+class GyroBiasEstimator
+{
+public:
+    GyroBiasEstimator();
+
+    /**
+     * @brief Converte os limites para a faixa do giroscópio e descarta a janela
+     * em andamento.
+     * @param range Faixa do giroscópio (MPU6050_GYRO_FS_*, 0 = ±250 °/s).
+     */
+    void setRange(uint8_t range);
+
+    /**
+     * @brief Retorna quantos LSB de leitura, na faixa em uso, correspondem a
+     * um LSB do offset (4 em ±250 °/s, 0,5 em ±2000 °/s).
+     * @return float - LSB de leitura por LSB do offset.
+     */
+    float getOffsetScale();
+
+    /**
+     * @brief Descarta a janela em andamento (chamada ao sair da parada).
+     *
+     */
+    void reset();
+
+    /**
+     * @brief Acumula uma amostra parada.
+     *
+     * @param gyro Leituras brutas do giroscópio (X, Y, Z).
+     * @param temperature Temperatura do sensor (°C).
+     * @param now Tempo atual (ms).
+     * @param step Ajuste que deve ser somado aos offsets (LSB do offset).
+     * @return true - Caso um ajuste deva ser aplicado.
+     * @return false - Caso contrário.
+     */
+    bool addSample(const int16_t *gyro, float temperature, uint32_t now, int16_t *step);
+
+    /**
+     * @brief Retorna os contadores do estimador.
+     *
+     * @return IMUGyroBiasData_t - Contadores e última estimativa.
+     */
+    IMUGyroBiasData_t getData();
+
+    /**
+     * @brief Indica, uma única vez, que uma nova janela foi aceita
+     * desde a última consulta (ver getData()).
+     * @return true - Caso uma nova janela tenha sido aceita.
+     * @return false - Caso contrário.
+     */
+    bool takeWindow();
+
+    /**
+     * @brief Contabiliza um ajuste aplicado pelo modelo de temperatura.
+     *
+     */
+    void countModelCorrection();
+
+private:
+    IMUGyroBiasData_t m_data;  // Contadores e última estimativa.
+    float m_offsetScale;       // LSB de leitura por LSB do offset na faixa em uso.
+    int32_t m_noiseLimit;      // GYRO_BIAS_NOISE_LIMIT em LSB de leitura.
+    float m_deadband;          // GYRO_BIAS_DEADBAND em LSB de leitura.
+    uint32_t m_windowStart;    // Millis() da primeira amostra da janela.
+    int32_t m_sum[3];          // Soma das leituras da janela.
+    int16_t m_min[3];          // Menor leitura da janela.
+    int16_t m_max[3];          // Maior leitura da janela.
+    float m_temperatureSum;    // Soma das temperaturas da janela.
+    float m_temperatureMin;    // Menor temperatura da janela.
+    float m_temperatureMax;    // Maior temperatura da janela.
+    uint16_t m_count;          // Amostras da janela.
+    bool m_newWindow;          // Uma janela foi aceita e ainda não foi consultada.
+};
+
+/**
+ * @brief Nó da tabela do modelo de temperatura.
+ *
+ */
+struct GyroModelNode_t
+{
+    float Temperature; // Temperatura média das janelas do nó (°C).
+    float Offset[3];   // Offset ideal médio de cada eixo (LSB do offset).
+    uint8_t Weight;    // Janelas acumuladas (0 = nó vazio), limitado a GYRO_MODEL_MAX_WEIGHT.
+};
+
+/**
+ * @brief Modelo linear por partes do offset ideal do giroscópio em
+ * função da temperatura, aprendido durante as paradas. Não acessa o sensor.
+ */
+class GyroTemperatureModel
+{
+public:
+    GyroTemperatureModel();
+
+    /**
+     * @brief Descarta todos os nós aprendidos.
+     *
+     */
+    void clear();
+
+    /**
+     * @brief Acumula uma janela parada no nó da sua temperatura.
+     *
+     * @param temperature Temperatura média da janela (°C).
+     * @param offset Offset ideal de cada eixo (LSB do offset).
+     */
+    void learn(float temperature, const float *offset);
+
+    /**
+     * @brief Calcula o offset ideal para a temperatura informada, interpolando
+     * entre os nós aprendidos (constante além do primeiro e do último nó).
+     * @param temperature Temperatura atual (°C).
+     * @param offset Offset ideal de cada eixo (LSB do offset).
+     * @return true - Caso exista ao menos um nó aprendido.
+     * @return false - Caso contrário.
+     */
+    bool predict(float temperature, float *offset);
+
+    /**
+     * @brief Retorna a quantidade de nós aprendidos.
+     *
+     * @return uint8_t - Nós com ao menos uma janela.
+     */
+    uint8_t getNodeCount();
+
+    /**
+     * @brief Indica se o modelo mudou desde a última chamada a setSaved().
+     *
+     * @return true - Caso existam alterações não gravadas.
+     * @return false - Caso contrário.
+     */
+    bool isDirty();
+
+    /**
+     * @brief Marca o modelo como gravado.
+     *
+     */
+    void setSaved();
+
+    GyroModelNode_t Nodes[GYRO_MODEL_NODES]; // Tabela de nós, em ordem de temperatura.
+
+private:
+    bool m_dirty; // Alterado desde a última gravação.
+};
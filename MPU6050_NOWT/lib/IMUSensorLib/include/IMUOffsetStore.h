@@ -0,0 +1,100 @@
+/**
+ * @file IMUOffsetStore.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Armazenamento dos offsets de calibração na NVS do ESP32.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Registro (inteiros em little-endian):
+ * [Versão (1)] [Modelo (1)] [MAC da placa (6)] [Offsets 6 x int16 (12)] [CRC-16 (2)]
+ *
+ * Modelo de temperatura do giroscópio (floats no formato nativo do ESP32):
+ * [Versão (1)] [Modelo (1)] [MAC da placa (6)] [Nós 21 x (Peso (1) Temperatura (4) Offsets 3 x 4)] [CRC-16 (2)]
+ *
+ * O modelo e o MAC identificam o conjunto sensor/placa que foi calibrado; um
+ * registro de outro conjunto ou com CRC inválido é ignorado.
+ */
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+
+#include "IMUGyroBias.h"
+#include "IMUSensorStructs.h"
+
+#define OFFSET_STORE_NAMESPACE "imu"    // Namespace da NVS.
+#define OFFSET_STORE_KEY "offsets"      // Chave do registro na NVS.
+#define OFFSET_STORE_VERSION 0x01       // Versão do formato do registro.
+#define OFFSET_STORE_IDENTITY_SIZE 7    // Modelo e MAC.
+#define OFFSET_STORE_RECORD_SIZE 22     // Tamanho total do registro.
+#define OFFSET_STORE_MODEL_KEY "gyromodel" // Chave do modelo de temperatura na NVS.
+#define OFFSET_STORE_MODEL_VERSION 0x02 // Versão do registro do modelo (a 0x01 aprendia offsets na escala de ±250 °/s).
+#define OFFSET_STORE_NODE_SIZE 17       // Peso, temperatura e três offsets.
+#define OFFSET_STORE_MODEL_SIZE (8 + GYRO_MODEL_NODES * OFFSET_STORE_NODE_SIZE + 2) // Tamanho total do registro do modelo.
+
+/**
+ * @brief Classe que salva e restaura os offsets de calibração.
+ *
+ */
+class OffsetStoreClass
+{
+public:
+    /**
+     * @brief Restaura os offsets salvos para o sensor informado.
+     *
+     * @param model Modelo do sensor.
+     * @param offsets Struct que receberá os offsets (inalterada em caso de falha).
+     * @return true - Caso exista um registro válido para este sensor e placa.
+     * @return false - Caso contrário.
+     */
+    bool load(IMUModel_e model, IMUOffsets_t &offsets);
+
+    /**
+     * @brief Salva os offsets do sensor informado.
+     *
+     * @param model Modelo do sensor.
+     * @param offsets Offsets provenientes da calibração.
+     * @return true - Caso o registro tenha sido gravado.
+     * @return false - Caso contrário.
+     */
+    bool save(IMUModel_e model, const IMUOffsets_t &offsets);
+
+    /**
+     * @brief Restaura o modelo de temperatura do giroscópio salvo para o sensor informado.
+     *
+     * @param model Modelo do sensor.
+     * @param gyroModel Modelo que receberá os nós (inalterado em caso de falha).
+     * @return true - Caso exista um registro válido para este sensor e placa.
+     * @return false - Caso contrário.
+     */
+    bool loadGyroModel(IMUModel_e model, GyroTemperatureModel &gyroModel);
+
+    /**
+     * @brief Salva o modelo de temperatura do giroscópio do sensor informado.
+     *
+     * @param model Modelo do sensor.
+     * @param gyroModel Modelo aprendido.
+     * @return true - Caso o registro tenha sido gravado.
+     * @return false - Caso contrário.
+     */
+    bool saveGyroModel(IMUModel_e model, const GyroTemperatureModel &gyroModel);
+
+    /**
+     * @brief Apaga os offsets e o modelo de temperatura salvos.
+     *
+     */
+    void clear();
+
+private:
+    /**
+     * @brief Preenche a identidade do conjunto sensor/placa.
+     *
+     * @param model Modelo do sensor.
+     * @param identity Buffer com OFFSET_STORE_IDENTITY_SIZE bytes.
+     */
+    void getIdentity(IMUModel_e model, uint8_t *identity);
+};
+
+extern OffsetStoreClass OffsetStore;
@@ -0,0 +1,112 @@
+/**
+ * @file IMUProfiler.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Cronometragem de cada etapa do processamento das amostras do sensor.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include "IMUSensorEnums.h"
+
+#define IMU_PROFILER_BUCKETS 16 // Quantidade de faixas do histograma (potências de 2 em us).
+
+/**
+ * @brief Estatísticas de uma etapa. Os tempos são
+ * armazenados em ciclos de CPU.
+ */
+struct IMUStageStats_t
+{
+public:
+    IMUStageStats_t()
+    {
+        reset();
+    }
+
+    /**
+     * @brief Zera as estatísticas.
+     *
+     */
+    void reset()
+    {
+        Count = 0;
+        Min = UINT32_MAX;
+        Max = 0;
+        Sum = 0;
+        memset(Histogram, 0, sizeof(Histogram));
+    }
+
+    uint32_t Count;                           // Quantidade de medidas.
+    uint32_t Min;                             // Menor tempo medido.
+    uint32_t Max;                             // Maior tempo medido.
+    uint64_t Sum;                             // Soma dos tempos medidos.
+    uint32_t Histogram[IMU_PROFILER_BUCKETS]; // Faixa 0: < 1 us, faixa n: [2^(n-1), 2^n) us, última faixa acumula o restante.
+};
+
+/**
+ * @brief Classe que cronometra as etapas do processamento
+ * de cada amostra usando o contador de ciclos da CPU.
+ */
+class ProfilerClass
+{
+public:
+    /**
+     * @brief Marca o início de uma etapa.
+     *
+     * @return uint32_t - Contador de ciclos no início da etapa.
+     */
+    inline uint32_t start()
+    {
+        return ESP.getCycleCount();
+    }
+
+    /**
+     * @brief Registra o tempo gasto em uma etapa.
+     *
+     * @param stage Etapa cronometrada.
+     * @param startCycles Valor retornado por start() no início da etapa.
+     * @return uint32_t - Contador de ciclos no fim da etapa, que pode ser
+     * usado como início da etapa seguinte.
+     */
+    uint32_t record(IMUStage_e stage, uint32_t startCycles);
+
+    /**
+     * @brief Copia as estatísticas de uma etapa.
+     *
+     * @param stage Etapa desejada.
+     * @param stats Variável onde as estatísticas serão copiadas.
+     */
+    void getStats(IMUStage_e stage, IMUStageStats_t &stats);
+
+    /**
+     * @brief Zera as estatísticas de todas as etapas.
+     *
+     */
+    void reset();
+
+    /**
+     * @brief Retorna o nome de uma etapa.
+     *
+     * @param stage Etapa desejada.
+     * @return const char* - Nome da etapa.
+     */
+    static const char *stageName(IMUStage_e stage);
+
+    /**
+     * @brief Converte ciclos de CPU para microssegundos.
+     *
+     * @param cycles Ciclos de CPU.
+     * @return float - Tempo em microssegundos.
+     */
+    static float toMicros(uint64_t cycles);
+
+private:
+    IMUStageStats_t m_stats[STAGE_COUNT]; // Estatísticas de cada etapa.
+};
+
+extern ProfilerClass Profiler;
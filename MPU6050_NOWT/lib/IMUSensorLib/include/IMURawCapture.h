@@ -0,0 +1,69 @@
+/**
+ * @file IMURawCapture.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Tipos da captura bruta de acelerômetro e giroscópio em alta taxa,
+ * entregue em lotes pela task de leitura (análise de vibração e impacto).
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Na captura o DMP fica desligado e o próprio FIFO do sensor acumula quadros de
+ * 12 bytes (acelerômetro e giroscópio, MSB primeiro) na taxa pedida. A task de
+ * leitura esvazia o FIFO em rajadas, direto no buffer do lote, e entrega o lote
+ * quando ele enche. Não há Yaw, Pitch e Roll nem detecção de estados enquanto a
+ * captura está ativa.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#define IMU_RAW_MIN_RATE 4    // Menor taxa de captura (Hz).
+#define IMU_RAW_MAX_RATE 1000 // Maior taxa de captura (Hz), a taxa interna com o DLPF ligado.
+
+/**
+ * @brief Um quadro do FIFO, na ordem dos registradores do sensor.
+ *
+ */
+struct IMURawSample_t
+{
+    int16_t Acc[3];  // Acelerômetro (X, Y, Z), em LSB (ver IMURawBatch_t::AccScale).
+    int16_t Gyro[3]; // Giroscópio (X, Y, Z), em LSB (ver IMURawBatch_t::GyroScale).
+};
+
+/**
+ * @brief Lote de amostras consecutivas, espaçadas de 1 / SampleRate.
+ *
+ */
+struct IMURawBatch_t
+{
+    const IMURawSample_t *Samples; // Amostras (válidas apenas durante a chamada).
+    uint16_t Count;        // Quantidade de amostras.
+    uint32_t Sequence;     // Amostras entregues antes deste lote desde o início da captura.
+    uint32_t Time;         // Micros() estimado da última amostra do lote.
+    bool Gap;              // Amostras perdidas (estouro do FIFO ou erro no barramento) antes deste lote.
+    float SampleRate;      // Taxa efetiva da captura (Hz).
+    float AccScale;        // LSB por g do acelerômetro.
+    float GyroScale;       // LSB por °/s do giroscópio.
+};
+
+/**
+ * @brief Contadores da captura bruta.
+ *
+ */
+struct IMURawCaptureData_t
+{
+    bool Active;           // Captura em andamento.
+    float SampleRate;      // Taxa efetiva da captura em andamento (Hz).
+    uint32_t Batches;      // Lotes entregues.
+    uint32_t Samples;      // Amostras entregues.
+    uint32_t Overflows;    // Vezes em que o FIFO estourou e foi reiniciado.
+    uint32_t FailedReads;  // Rajadas descartadas por erro no barramento.
+};
+
+/**
+ * @brief Função chamada pela task de leitura a cada lote completo da
+ * captura bruta. Não deve bloquear: o FIFO continua enchendo durante a chamada.
+ * @param batch Lote de amostras.
+ */
+typedef void (*IMURawBatchCallback_t)(const IMURawBatch_t &batch);
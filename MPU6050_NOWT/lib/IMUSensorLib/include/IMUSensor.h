@@ -19,9 +19,25 @@
 
 #include "CircularBuffer.h"
 #include "I2Cdev.h"
+#include "IMUProfiler.h"
+#include "IMUProfiles.h"
 #include "IMUSensorStructs.h"
 
+#ifdef IMU_BENCHMARK
+#include "IMUBenchmark.h"
+#endif
+
 const int g_historySize = 100; // Tamanho do histórico de leituras do sensor.
+const int g_stateCount = STATE_TAMPER + 1; // Quantidade de estados do dispositivo.
+const int g_jitterWindow = 128; // Quantidade de intervalos entre amostras usada no cálculo do jitter.
+
+/**
+ * @brief Função chamada pela task de leitura a cada nova amostra,
+ * antes da decimação do histórico.
+ * @param data Amostra lida.
+ * @param state Estado atual do dispositivo.
+ */
+typedef void (*IMUSampleCallback_t)(const IMUAxisData_t &data, DeviceState_e state);
 
 /**
  * @brief Superclasse de sensores IMU
@@ -96,6 +112,38 @@ protected:
      */
     bool checkConfigurations();
 
+    /**
+     * @brief Adota, sem travar, as configurações publicadas desde a
+     * última amostra. Deve ser chamada apenas pela task de leitura,
+     * entre duas amostras.
+     */
+    void refreshSettings();
+
+    /**
+     * @brief Registra a chegada de um novo pacote para o
+     * cálculo do intervalo entre amostras.
+     */
+    void registerSample();
+
+    /**
+     * @brief Repassa uma nova amostra para a função registrada
+     * em setSampleCallback().
+     * @param data Amostra lida.
+     */
+    void notifySample(const IMUAxisData_t &data);
+
+    /**
+     * @brief Toma o semáforo do sensor.
+     * 
+     */
+    void lock();
+
+    /**
+     * @brief Libera o semáforo do sensor.
+     * 
+     */
+    void unlock();
+
     bool m_threadRunning;             // Flag que indica se a thread de leitura está ativada.
     bool m_tipped;                    // Flag de tombamento.
     bool m_moving;                    // Flag de movimento.
@@ -103,7 +151,12 @@ protected:
     bool m_semaphoreInitialized;      // Flag que indica o funcionamento do semáforo.
     int m_readFrequency;              // Frequência da leitura do sensor.
     SemaphoreHandle_t m_imuSemaphore; // Semaforização de processos sensíveis.
+#ifdef IMU_BENCHMARK
+    unsigned long m_lockTime;         // Micros() em que o semáforo foi tomado.
+#endif
     DeviceState_e m_devState;         // Estado atual do automóvel.
+    uint32_t m_samples;               // Pacotes lidos desde a inicialização.
+    volatile IMUSampleCallback_t m_sampleCallback; // Função que recebe todas as amostras lidas.
 
 public:
     /**
@@ -140,6 +193,45 @@ public:
      * @param settings Configurações do detector de tamper.
      */
     void configureTamperDetection(IMUTamperSettings_t settings);
+
+    /**
+     * @brief Configurar todos os detectores de uma só vez, sem que a
+     * leitura observe uma configuração parcial. As configurações passam
+     * a valer na próxima amostra.
+     * @param settings Configurações dos detectores.
+     */
+    void configure(const IMUDetectionSettings_t &settings);
+
+    /**
+     * @brief Retorna as últimas configurações publicadas dos detectores.
+     * 
+     * @return IMUDetectionSettings_t - Configurações dos detectores.
+     */
+    IMUDetectionSettings_t getSettings();
+
+    /**
+     * @brief Aplica um perfil de detecção da tabela em flash. O perfil
+     * passa a ser o perfil base, usado nos estados sem perfil associado,
+     * e descarta os ajustes feitos pelos configure*().
+     * @param profile Perfil de detecção.
+     */
+    void applyProfile(IMUProfile_e profile);
+
+    /**
+     * @brief Retorna o perfil de detecção em uso.
+     * 
+     * @return IMUProfile_e - Perfil em uso (IMU_PROFILE_NONE caso nenhum tenha sido aplicado).
+     */
+    IMUProfile_e getProfile();
+
+    /**
+     * @brief Associa um perfil a um estado do dispositivo. Ao entrar no
+     * estado o perfil é trocado automaticamente; ao sair, volta o perfil base.
+     * A troca fica suspensa após um configure*() até o próximo applyProfile().
+     * @param state Estado do dispositivo.
+     * @param profile Perfil do estado (IMU_PROFILE_NONE para usar o perfil base).
+     */
+    void setStateProfile(DeviceState_e state, IMUProfile_e profile);
     
     /**
      * @brief Retornar a última leitura dos eixos do acelerômetro
@@ -243,14 +335,53 @@ public:
      */
     virtual void setOffsets(IMUOffsets_t newOffsets) = 0;
 
+    /**
+     * @brief Retorna os contadores de saúde da leitura do sensor.
+     * A implementação base preenche a quantidade de amostras e os
+     * percentis do intervalo entre amostras.
+     * @param health Struct que armazenará os contadores.
+     */
+    virtual void getHealth(IMUHealth_t &health);
+
+    /**
+     * @brief Registra a função que receberá todas as amostras lidas, na
+     * taxa do DMP. A função é chamada pela task de leitura, portanto
+     * não deve bloquear.
+     * @param callback Função chamada a cada amostra (NULL para desativar).
+     */
+    void setSampleCallback(IMUSampleCallback_t callback);
+
 private: 
-    IMUTippingSettings_t m_tippingSettings;   // Configurações para a detecção de tombamento.
-    IMUMovementSettings_t m_movementSettings; // Configurações para a detecção de movimento.
-    IMUStopSettings_t m_stopSettings;         // Configurações para a detecção de parada.
-    IMUTamperSettings_t m_tamperSettings;     // Configurações para a detecção de tamper.
+    /**
+     * @brief Troca o perfil em uso sem alterar o perfil base. Não faz
+     * nada enquanto houver ajustes feitos em funcionamento.
+     * 
+     * @param profile Perfil de detecção.
+     */
+    void selectProfile(IMUProfile_e profile);
+
+    /**
+     * @brief Publica um novo bloco de configurações no buffer inativo e
+     * avança a geração. Deve ser chamada com g_settingsMux tomado.
+     * @param settings Configurações que serão publicadas.
+     */
+    void publishSettings(const IMUDetectionSettings_t &settings);
+
+    IMUDetectionSettings_t m_settings;          // Configurações em uso pela task de leitura.
+    IMUDetectionSettings_t m_settingsBuffer[2]; // Buffer duplo das configurações publicadas.
+    uint32_t m_settingsGeneration;              // Geração publicada (o buffer ativo é geração & 1).
+    uint32_t m_activeGeneration;                // Geração em uso pela task de leitura.
+    int32_t m_tippingLimit;                     // Limiar de tombamento sobre o eixo X da gravidade (Q30).
     IMUTippingData_t m_tippingData;     // Dados de tombamento.
     IMUMovementData_t m_movementData;   // Dados de movimento.
     IMUStopData_t m_stopData;           // Dados de parada.
     IMUTamperData_t m_tamperData;       // Dados de tamper.
     CircularBuffer <IMUAxisData_t, g_historySize> m_axisData; // Buffer circular com dados históricos das medidas do sensor.
+    uint32_t m_sampleIntervals[g_jitterWindow]; // Janela circular de intervalos entre amostras (us).
+    uint16_t m_intervalIndex;                   // Próxima posição da janela de intervalos.
+    unsigned long m_lastSampleTime;             // Micros() do último pacote registrado.
+    IMUProfile_e m_baseProfile;                 // Perfil escolhido em applyProfile().
+    IMUProfile_e m_activeProfile;               // Perfil em uso.
+    IMUProfile_e m_stateProfiles[g_stateCount]; // Perfil associado a cada estado do dispositivo.
+    volatile bool m_settingsOverride;           // Flag de ajustes feitos pelos configure*() sobre o perfil.
 };
\ No newline at end of file
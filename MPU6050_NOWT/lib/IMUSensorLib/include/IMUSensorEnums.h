@@ -27,7 +27,21 @@ enum IMUTippingSide_e
 enum IMUModel_e
 {
     // MPU6050
-    IMU_MODEL_MPU6050 = 0
+    IMU_MODEL_MPU6050 = 0,
+    // MPU6050 com magnetômetro AK8975 no barramento auxiliar (DMP de 9 eixos).
+    IMU_MODEL_MPU6050_MAG
+};
+
+/**
+ * @brief Algoritmo da fusão por software (IMUFusion).
+ * 
+ */
+enum IMUFusionAlgorithm_e
+{
+    // Madgwick: passo de gradiente descendente com ganho Beta.
+    IMU_FUSION_MADGWICK = 0,
+    // Mahony: filtro complementar com ganhos Kp e Ki (corrige o bias do giroscópio).
+    IMU_FUSION_MAHONY
 };
 
 /**
@@ -44,4 +58,66 @@ enum DeviceState_e
     STATE_TIPPED,
     // Tamper
     STATE_TAMPER
+};
+
+/**
+ * @brief Etapas do processamento de uma amostra
+ * cronometradas pelo Profiler.
+ */
+enum IMUStage_e
+{
+    // Espera até que o FIFO possua um pacote completo.
+    STAGE_FIFO_WAIT = 0,
+    // Leitura do pacote do DMP.
+    STAGE_FIFO_READ,
+    // Leitura dos registradores de acelerômetro, giroscópio e temperatura.
+    STAGE_RAW_READ,
+    // Cálculo de quaternion, gravidade e YPR.
+    STAGE_DMP_MATH,
+    // Inserção da amostra no histórico.
+    STAGE_ADD_MEASUREMENT,
+    // Detecção de tombamento.
+    STAGE_DETECT_TIPPING,
+    // Detecção de tamper.
+    STAGE_DETECT_TAMPER,
+    // Detecção de movimento.
+    STAGE_DETECT_MOVEMENT,
+    // Detecção de parada.
+    STAGE_DETECT_STOP,
+    // Atualização do estado do dispositivo.
+    STAGE_UPDATE_STATE,
+    // Quantidade de etapas.
+    STAGE_COUNT
+};
+
+/**
+ * @brief Política do Logger quando o buffer de
+ * transmissão está cheio.
+ */
+enum LoggerPolicy_e
+{
+    // Descarta a mensagem nova inteira.
+    LOGGER_DROP_NEWEST = 0,
+    // Sobrescreve os bytes mais antigos ainda não enviados.
+    LOGGER_DROP_OLDEST
+};
+
+/**
+ * @brief Perfis de detecção pré-definidos.
+ * 
+ */
+enum IMUProfile_e
+{
+    // Caminhão.
+    IMU_PROFILE_TRUCK = 0,
+    // Carro.
+    IMU_PROFILE_CAR,
+    // Motocicleta.
+    IMU_PROFILE_MOTORCYCLE,
+    // Veículo estacionado.
+    IMU_PROFILE_PARKED,
+    // Quantidade de perfis.
+    IMU_PROFILE_COUNT,
+    // Nenhum perfil associado.
+    IMU_PROFILE_NONE = 0xFF
 };
\ No newline at end of file
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "MPU6050_IMU.h"
+#include "MPU6050Mag_IMU.h"
 
 /**
  * @brief Permite a criação do objeto IMUSensor de acordo com o modelo escolhido.
@@ -36,6 +37,10 @@ public:
             sensor = new MPU6050IMU();
             ((MPU6050IMU *)sensor)->begin(wire);
             break;
+        case IMUModel_e::IMU_MODEL_MPU6050_MAG:
+            sensor = new MPU6050MagIMU();
+            ((MPU6050MagIMU *)sensor)->begin(wire);
+            break;
         default:
             break;
         }
@@ -10,6 +10,9 @@
  */
 #pragma once
 
+#include "IMUBenchmark.h"
+#include "IMULogger.h"
+#include "IMUProfiler.h"
 #include "IMUSensor.h"
 #include "IMUSensorEnums.h"
 #include "IMUSensorFactory.h"
@@ -10,10 +10,14 @@
  */
 #pragma once
 
+#include <math.h>
+#include <stdint.h>
 #include <vector>
 
 #include "IMUSensorEnums.h" 
 
+#define IMU_GRAVITY_ONE ((int32_t)1 << 30) // Módulo unitário da gravidade em ponto fixo Q30.
+
 /**
  * @brief Dados de leitura dos eixos do IMU.
  * 
@@ -28,6 +32,8 @@ public:
         Acc_X = Acc_Y = Acc_Z = 0.0;
         Gyro_X = Gyro_Y = Gyro_Z = 0.0;
         Yaw = Pitch = Roll = 0.0;
+        Gravity_X = Gravity_Y = Gravity_Z = 0;
+        Heading = NAN;
     }
 
     /**
@@ -88,6 +94,30 @@ public:
      * Roll.
      */
     double Roll;
+
+    /**
+     * @brief Eixo X da direção da gravidade, em Q30 (IMU_GRAVITY_ONE = 1),
+     * na convenção de dmpGetGravity().
+     */
+    int32_t Gravity_X;
+
+    /**
+     * @brief Eixo Y da direção da gravidade, em Q30.
+     * 
+     */
+    int32_t Gravity_Y;
+
+    /**
+     * @brief Eixo Z da direção da gravidade, em Q30.
+     * 
+     */
+    int32_t Gravity_Z;
+
+    /**
+     * @brief Rumo magnético compensado pela inclinação, em graus
+     * (NAN nos modelos sem magnetômetro).
+     */
+    double Heading;
 };
 
 /**
@@ -176,6 +206,15 @@ public:
         MinimumSamples = 0.0;
     }
 
+    /**
+     * @brief Constrói um objeto da struct IMUTippingSettings_t com os valores
+     * informados. Por ser constexpr, permite tabelas constantes em flash.
+     * @param tippingStartThreshold Limiar em graus para início da detecção.
+     * @param minimumSamples Amostragem mínima para determinar o tombamento.
+     */
+    constexpr IMUTippingSettings_t(double tippingStartThreshold, uint16_t minimumSamples)
+        : TippingStartThreshold(tippingStartThreshold), MinimumSamples(minimumSamples) {}
+
     /**
      * @brief Limiar em graus para início da detecção de tombamento.
      * 
@@ -206,6 +245,15 @@ public:
         MinimumSamples = 0;
     }
 
+    /**
+     * @brief Constrói um objeto da struct IMUMovementSettings_t com os valores informados.
+     * 
+     * @param movementInterval Intervalo do módulo da aceleração (g).
+     * @param minimumSamples Quantidade mínima de amostras.
+     */
+    constexpr IMUMovementSettings_t(double movementInterval, uint8_t minimumSamples)
+        : MovementInterval(movementInterval), MinimumSamples(minimumSamples) {}
+
     /**
      * @brief Intervalo que o módulo da aceleração deve ultrapassar
      * para identificar um movimento.
@@ -237,6 +285,15 @@ public:
         MinimumSamples = 0;
     }
 
+    /**
+     * @brief Constrói um objeto da struct IMUStopSettings_t com os valores informados.
+     * 
+     * @param stopInterval Intervalo do módulo da aceleração (g).
+     * @param minimumSamples Quantidade mínima de amostras.
+     */
+    constexpr IMUStopSettings_t(double stopInterval, uint8_t minimumSamples)
+        : StopInterval(stopInterval), MinimumSamples(minimumSamples) {}
+
     /**
      * @brief Intervalo que o módulo da aceleração deve ficar contido
      * para identificar que está parado.
@@ -268,6 +325,15 @@ public:
         MinimumSamples = 0;
     }
 
+    /**
+     * @brief Constrói um objeto da struct IMUTamperSettings_t com os valores informados.
+     * 
+     * @param tamperTime Tempo tombado e em movimento para detectar tamper (s).
+     * @param minimumSamples Quantidade mínima de amostras.
+     */
+    constexpr IMUTamperSettings_t(uint8_t tamperTime, uint8_t minimumSamples)
+        : TamperTime(tamperTime), MinimumSamples(minimumSamples) {}
+
     /**
      * @brief Se o automóvel tombar e continuar em movimento por (TamperTime)
      * segundos, irá detectar tamper.
@@ -281,6 +347,36 @@ public:
     uint8_t MinimumSamples;
 };
 
+/**
+ * @brief Conjunto das configurações de todos os detectores,
+ * aplicado de uma só vez.
+ */
+struct IMUDetectionSettings_t
+{
+public:
+    IMUDetectionSettings_t() {}
+
+    /**
+     * @brief Constrói um conjunto de configurações com os valores informados.
+     * 
+     * @param tipping Configurações do tombamento.
+     * @param movement Configurações do movimento.
+     * @param stop Configurações da parada.
+     * @param tamper Configurações do tamper.
+     */
+    constexpr IMUDetectionSettings_t(IMUTippingSettings_t tipping, IMUMovementSettings_t movement, 
+                                     IMUStopSettings_t stop, IMUTamperSettings_t tamper)
+        : Tipping(tipping), Movement(movement), Stop(stop), Tamper(tamper) {}
+
+    IMUTippingSettings_t Tipping;
+
+    IMUMovementSettings_t Movement;
+
+    IMUStopSettings_t Stop;
+
+    IMUTamperSettings_t Tamper;
+};
+
 struct IMUOffsets_t
 {
 public:
@@ -335,4 +431,159 @@ public:
      * 
      */    
     int16_t ZGyroOffset;
+};
+
+/**
+ * @brief Contadores de saúde do pipeline de leitura
+ * do sensor.
+ */
+struct IMUHealth_t
+{
+public:
+    /**
+     * @brief Constrói um objeto da struct IMUHealth_t.
+     * 
+     */
+    IMUHealth_t()
+    {
+        Samples = 0;
+        FifoOverflows = FifoResets = FifoTimeouts = TrashBytes = 0;
+        I2CReadFailures = I2CReadTimeouts = I2CWriteFailures = 0;
+        IntervalP50 = IntervalP90 = IntervalP99 = IntervalMax = 0;
+        StackHighWaterMark = StackSize = 0;
+        DmpInitTime = DmpWarmStart = 0;
+        GyroBiasWindows = GyroBiasCorrections = 0;
+        GyroModelCorrections = GyroModelNodes = 0;
+        I2CShadowHits = 0;
+        SensorRecoveries = LastOutage = TotalOutage = 0;
+    }
+
+    /**
+     * @brief Pacotes lidos desde a inicialização.
+     * 
+     */
+    uint32_t Samples;
+
+    /**
+     * @brief Vezes em que o FIFO ultrapassou sua capacidade
+     * e foi reiniciado antes da leitura.
+     */
+    uint32_t FifoOverflows;
+
+    /**
+     * @brief Vezes em que o FIFO foi reiniciado durante a busca
+     * pelo pacote mais recente.
+     */
+    uint32_t FifoResets;
+
+    /**
+     * @brief Vezes em que nenhum pacote válido foi obtido
+     * dentro do tempo limite.
+     */
+    uint32_t FifoTimeouts;
+
+    /**
+     * @brief Bytes antigos descartados do FIFO para alcançar
+     * o pacote mais recente.
+     */
+    uint32_t TrashBytes;
+
+    /**
+     * @brief Leituras I2C que retornaram menos bytes que o esperado.
+     * 
+     */
+    uint32_t I2CReadFailures;
+
+    /**
+     * @brief Leituras I2C interrompidas por tempo limite.
+     * 
+     */
+    uint32_t I2CReadTimeouts;
+
+    /**
+     * @brief Escritas I2C não reconhecidas pelo dispositivo.
+     * 
+     */
+    uint32_t I2CWriteFailures;
+
+    /**
+     * @brief Percentis e máximo do intervalo entre amostras (us)
+     * na janela mais recente.
+     */
+    uint32_t IntervalP50;
+    uint32_t IntervalP90;
+    uint32_t IntervalP99;
+    uint32_t IntervalMax;
+
+    /**
+     * @brief Menor quantidade de pilha livre já registrada na
+     * task de leitura (bytes).
+     */
+    uint32_t StackHighWaterMark;
+
+    /**
+     * @brief Tamanho da pilha da task de leitura (bytes).
+     * 
+     */
+    uint32_t StackSize;
+
+    /**
+     * @brief Duração da inicialização do DMP no boot, incluindo o
+     * carregamento do firmware (us).
+     */
+    uint32_t DmpInitTime;
+
+    /**
+     * @brief Indica se o boot reaproveitou o DMP já carregado (1)
+     * em vez de recarregar o firmware (0).
+     */
+    uint32_t DmpWarmStart;
+
+    /**
+     * @brief Janelas paradas aceitas pelo estimador de bias do giroscópio.
+     * 
+     */
+    uint32_t GyroBiasWindows;
+
+    /**
+     * @brief Ajustes aplicados nos offsets do giroscópio durante as paradas.
+     * 
+     */
+    uint32_t GyroBiasCorrections;
+
+    /**
+     * @brief Ajustes aplicados pelo modelo de temperatura do giroscópio.
+     * 
+     */
+    uint32_t GyroModelCorrections;
+
+    /**
+     * @brief Nós aprendidos no modelo de temperatura do giroscópio.
+     * 
+     */
+    uint32_t GyroModelNodes;
+
+    /**
+     * @brief Leituras I2C atendidas pela cópia em RAM dos registradores
+     * de configuração, sem acesso ao barramento.
+     */
+    uint32_t I2CShadowHits;
+
+    /**
+     * @brief Vezes em que o sensor foi recuperado após uma sequência de
+     * amostras com erro no barramento ou sem pacotes do DMP.
+     */
+    uint32_t SensorRecoveries;
+
+    /**
+     * @brief Duração da última perda do sensor, da primeira amostra com
+     * falha até a recuperação (ms).
+     */
+    uint32_t LastOutage;
+
+    /**
+     * @brief Soma das durações das perdas do sensor (ms).
+     * 
+     */
+    uint32_t TotalOutage;
 };
\ No newline at end of file
@@ -0,0 +1,156 @@
+/**
+ * @file MPU6050Mag_IMU.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Classe para o MPU6050 com um magnetômetro AK8975 no barramento auxiliar
+ * (modelo IMU_MODEL_MPU6050_MAG). O DMP (MotionApps 4.1) lê o magnetômetro pelo
+ * mestre I2C do próprio MPU e o coloca no mesmo pacote do FIFO que o quaternion.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include "MPU6050_IMU.h"
+#include "MPU6050_9Axis_MotionApps41.h"
+
+#define MPU6050_MAG_READ_TASK_STACK 10000 // Tamanho da pilha da task de leitura (bytes).
+
+/**
+ * @brief Classe com os métodos para o MPU6050 com magnetômetro
+ * externo. Além do Yaw, Pitch e Roll do DMP, cada amostra traz o
+ * rumo magnético (Heading) compensado pela inclinação, calculado
+ * com o campo e a gravidade do mesmo pacote.
+ */
+class MPU6050MagIMU : public IMUSensor
+{
+public:
+    /**
+     * @brief Constrói um novo objeto da classe
+     * MPU6050MagIMU.
+     */
+    MPU6050MagIMU();
+
+    /**
+     * @brief Carrega os offsets salvos (ou os padrão) e chama a inicialização.
+     *
+     * @param wire Interface I2C que comunica com a MPU.
+     * @return true - Caso inicie normalmente.
+     * @return false - Caso contrário.
+     */
+    bool begin(TwoWire &wire);
+
+    /**
+     * @brief Inicializa o sensor, carrega o DMP de 9 eixos e configura o
+     * magnetômetro como escravo do barramento auxiliar.
+     * @param wire Interface I2C que comunica com a MPU.
+     * @param offsets Offsets.
+     * @return true - Caso inicie normalmente.
+     * @return false - Caso contrário.
+     */
+    bool begin(TwoWire &wire, IMUOffsets_t offsets);
+
+    /**
+     * @brief Iniciar a thread que realiza as medições.
+     *
+     * @param frequency Frequência que a thread irá executar as medições (a cada x milissegundos).
+     */
+    void start(int frequency);
+
+    /**
+     * @brief Parar a thread que realiza as medições.
+     *
+     */
+    void stop();
+
+    /**
+     * @brief Calibrar o acelerômetro e o giroscópio.
+     *
+     * @return IMUOffsets_t - Offsets calculados à
+     * partir da calibração.
+     */
+    IMUOffsets_t calibrate();
+
+    /**
+     * @brief Obtem os offsets atuais do sensor.
+     *
+     * @return IMUOffsets_t - Offsets atuais do sensor.
+     */
+    IMUOffsets_t getCurrentOffsets();
+
+    /**
+     * @brief Altera os offsets do dispositivo.
+     *
+     * @param newOffsets Novos offsets que serão utilizados
+     * pelo dispositivo
+     */
+    void setOffsets(IMUOffsets_t newOffsets);
+
+    /**
+     * @brief Indica se os offsets em uso foram restaurados da NVS
+     * (ou salvos pela última calibração).
+     * @return true - Caso o sensor possua offsets salvos.
+     * @return false - Caso esteja usando os offsets padrão.
+     */
+    bool hasStoredOffsets();
+
+    /**
+     * @brief Retorna os contadores de saúde da leitura, incluindo
+     * os contadores do FIFO, do barramento I2C e o uso da pilha
+     * da task de leitura.
+     * @param health Struct que armazenará os contadores.
+     */
+    void getHealth(IMUHealth_t &health);
+
+    /**
+     * @brief Define a correção de ferro duro do magnetômetro, subtraída
+     * das leituras antes do cálculo do rumo.
+     * @param bias Offset de cada eixo do magnetômetro (X, Y, Z, em LSB do AK8975).
+     */
+    void setMagBias(const int16_t *bias);
+
+    /**
+     * @brief Define a declinação magnética local, somada ao rumo
+     * magnético para obter o rumo verdadeiro.
+     * @param declination Declinação (graus, positiva para leste).
+     */
+    void setDeclination(float declination);
+
+private:
+    /**
+     * @brief Faz a leitura e o armazenamento de novos dados
+     * dos sensores da MPU (Já convertidos).
+     */
+    void updateData();
+
+    /**
+     * @brief Função superficial que permite acessar a
+     * função base para a realização da readTask.
+     */
+    static void wrapper(void *parameter);
+
+    /**
+     * @brief Calcula o rumo com compensação de inclinação: o campo é
+     * projetado no plano horizontal definido pela gravidade do DMP.
+     * @param mag Leituras do magnetômetro no pacote (X, Y, Z).
+     * @param gravity Gravidade calculada a partir do quaternion do mesmo pacote.
+     * @return float - Rumo do eixo X do sensor (graus, 0 a 360), ou NAN
+     * se o campo estiver alinhado com a gravidade (ou zerado).
+     */
+    float computeHeading(const int16_t *mag, const VectorFloat &gravity);
+
+    MPU6050_9Axis_MotionApps41 m_mpu; // Objeto da lib com o DMP de 9 eixos.
+    uint8_t m_deviceStatus;      // Status de funcionamento dispositivo (== 0 -> Funcionando).
+    bool m_dmpStatus;            // Status de funcionamento do DMP.
+    bool m_storedOffsets;        // Flag que indica se os offsets vieram da NVS.
+    uint16_t m_packetSize;       // Tamanho do pacote do DMP (48 bytes).
+    uint8_t m_fifoBuffer[64];    // Último pacote lido do FIFO.
+    uint32_t m_fifoOverflows;    // Vezes em que o FIFO estourou antes da leitura.
+    uint32_t m_dmpInitTime;      // Duração da inicialização do DMP (us).
+    float m_gyroScale;           // °/s por LSB do giroscópio, da faixa configurada no sensor.
+    int16_t m_magBias[3];        // Correção de ferro duro do magnetômetro.
+    float m_declination;         // Declinação magnética local (graus).
+    unsigned long m_timeLastRead; // Millis() do último registro de leitura no histórico.
+    TaskHandle_t m_readTaskHandle; // Handle da task de leitura.
+};
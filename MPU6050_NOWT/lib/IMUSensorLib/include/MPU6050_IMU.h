@@ -11,11 +11,32 @@
 #pragma once
 
 #include "IMUSensor.h"
+#include "IMUFusion.h"
+#include "IMUGyroBias.h"
+#include "IMUOffsetStore.h"
+#include "IMURawCapture.h"
+
+// Firmware do DMP escolhido na compilação. O MotionApps 6.12 (IMU_DMP_MOTIONAPPS612) entrega
+// pacotes de 28 bytes com acelerômetro e giroscópio brutos; o 2.0 (padrão), pacotes de 42 bytes.
+#ifdef IMU_DMP_MOTIONAPPS612
+#include "MPU6050_6Axis_MotionApps612.h"
+#define MPU6050_DMP_FIRMWARE "MotionApps 6.12"
+#else
 #include "MPU6050_6Axis_MotionApps20.h"
+#define MPU6050_DMP_FIRMWARE "MotionApps 2.0"
+#endif
 
 #define MPU6050_PIN_SDA GPIO_NUM_33 // Pino de comunicação com MPU6050
 #define MPU6050_PIN_SCL GPIO_NUM_32 // Pino de comunicação com MPU6050
 #define MPU6050_FREQUENCY 400000    // Frequência de comunicação com MPU6050
+#define MPU6050_FIFO_WAIT_TIMEOUT 50 // Espera máxima por um pacote do DMP antes de contar a amostra como falha (ms).
+#define MPU6050_RECOVERY_THRESHOLD 3 // Amostras seguidas com falha que disparam a recuperação do sensor.
+#define MPU6050_RECOVERY_INTERVAL 100 // Intervalo entre as tentativas de recuperação (ms).
+#define MPU6050_READ_TASK_STACK 10000 // Tamanho da pilha da task de leitura (bytes)
+#define MPU6050_RAW_BATCH_SIZE 50     // Amostras por lote da captura bruta (50 ms a 1 kHz; o FIFO comporta 85).
+#define MPU6050_RAW_CHUNK_SIZE 10     // Quadros por rajada de leitura do FIFO (120 bytes: o I2Cdev::readBytes() conta em int8_t, até 127).
+#define MPU6050_RAW_POLL_INTERVAL 10  // Intervalo entre as leituras do FIFO na captura bruta (ms).
+#define MPU6050_FUSION_RATE 100       // Taxa da fusão por software (Hz), a mesma das amostras do DMP.
 
 /**
  * @brief Classe com os métodos para o sensor
@@ -84,6 +105,91 @@ public:
      */
     void setOffsets(IMUOffsets_t newOffsets);
 
+    /**
+     * @brief Indica se os offsets em uso foram restaurados da NVS
+     * (ou salvos pela última calibração).
+     * @return true - Caso o sensor possua offsets salvos.
+     * @return false - Caso esteja usando os offsets padrão.
+     */
+    bool hasStoredOffsets();
+
+    /**
+     * @brief Retorna os contadores de saúde da leitura, incluindo
+     * os contadores do FIFO, do barramento I2C e o uso da pilha
+     * da task de leitura.
+     * @param health Struct que armazenará os contadores.
+     */
+    void getHealth(IMUHealth_t &health);
+
+    /**
+     * @brief Ativa ou desativa a correção do bias do giroscópio
+     * durante as paradas (ativada por padrão).
+     * @param enable Nova configuração.
+     */
+    void setGyroBiasTracking(bool enable);
+
+    /**
+     * @brief Retorna os contadores e a última estimativa do bias
+     * do giroscópio.
+     * @param data Struct que armazenará os dados.
+     */
+    void getGyroBiasData(IMUGyroBiasData_t &data);
+
+    /**
+     * @brief Retorna o modelo de temperatura do giroscópio aprendido.
+     *
+     * @param model Objeto que armazenará uma cópia do modelo.
+     */
+    void getGyroModel(GyroTemperatureModel &model);
+
+    /**
+     * @brief Grava na NVS o modelo de temperatura entregue pela task de leitura.
+     * Chamada pelo loop: a escrita na flash nunca acontece na task de leitura.
+     */
+    void saveGyroModel();
+
+    /**
+     * @brief Troca o DMP pela captura bruta de acelerômetro e giroscópio: o
+     * FIFO passa a receber quadros de 12 bytes na taxa pedida, entregues em
+     * lotes de MPU6050_RAW_BATCH_SIZE amostras. A troca é feita pela task de
+     * leitura, que deve estar rodando.
+     * @param rate Taxa de captura (Hz, IMU_RAW_MIN_RATE a IMU_RAW_MAX_RATE). A
+     * taxa efetiva é 1 kHz dividido por um inteiro (ver IMURawBatch_t::SampleRate).
+     * @param callback Função que recebe os lotes.
+     * @return true - Caso a captura tenha sido pedida.
+     * @return false - Caso a task de leitura não esteja rodando ou os parâmetros sejam inválidos.
+     */
+    bool startRawCapture(uint16_t rate, IMURawBatchCallback_t callback);
+
+    /**
+     * @brief Encerra a captura bruta, restaurando a configuração e o DMP. As
+     * amostras do lote incompleto são descartadas.
+     */
+    void stopRawCapture();
+
+    /**
+     * @brief Retorna os contadores da captura bruta.
+     *
+     * @param data Struct que armazenará os contadores.
+     */
+    void getRawCaptureData(IMURawCaptureData_t &data);
+
+#ifdef IMU_SOFTWARE_FUSION
+    /**
+     * @brief Escolhe o algoritmo da fusão por software. A troca é feita
+     * pela task de leitura, mantendo a orientação atual.
+     * @param algorithm Algoritmo.
+     */
+    void setFusionAlgorithm(IMUFusionAlgorithm_e algorithm);
+
+    /**
+     * @brief Altera os ganhos da fusão por software, aplicados pela task
+     * de leitura na próxima amostra.
+     * @param gains Novos ganhos.
+     */
+    void setFusionGains(const IMUFusionGains_t &gains);
+#endif
+
 private:
     /**
      * @brief Faz a leitura e o armazenamento de novos dados
@@ -96,10 +202,139 @@ private:
      * função base para a realização da readTask.
      */
     static void wrapper(void * parameter);
+
+    /**
+     * @brief Acumula a amostra no estimador de bias enquanto o dispositivo
+     * está parado, alimentando o modelo de temperatura e aplicando os ajustes
+     * calculados; fora da parada aplica o modelo de temperatura.
+     * @param gyro Leituras brutas do giroscópio (X, Y, Z).
+     * @param temperature Temperatura do sensor (°C).
+     */
+    void trackGyroBias(const int16_t *gyro, float temperature);
+
+    /**
+     * @brief Soma um ajuste aos offsets do giroscópio.
+     *
+     * @param step Ajuste de cada eixo (LSB do offset).
+     */
+    void adjustGyroOffsets(const int16_t *step);
+
+    /**
+     * @brief Conta uma amostra com falha (erro no barramento ou sem pacote
+     * dentro do tempo) e, após MPU6050_RECOVERY_THRESHOLD seguidas, passa a
+     * recuperar o sensor em vez de ler.
+     */
+    void sampleFailed();
+
+    /**
+     * @brief Faz uma tentativa de recuperação, no máximo a cada
+     * MPU6050_RECOVERY_INTERVAL: libera o barramento, confirma o sensor e
+     * restaura o DMP e os offsets pelo caminho mais curto.
+     * @return true - Caso o sensor tenha voltado.
+     * @return false - Caso contrário (ou se ainda não for hora de tentar).
+     */
+    bool recoverSensor();
+
+    /**
+     * @brief Libera o barramento de um escravo que segura o SDA: até 9
+     * pulsos de SCL seguidos de um STOP, e reinicia a interface I2C.
+     */
+    void clearBus();
+
+    /**
+     * @brief Aplica, na task de leitura, a troca entre o DMP e a captura
+     * bruta pedida por startRawCapture() ou stopRawCapture().
+     */
+    void switchAcquisition();
+
+    /**
+     * @brief Desliga o DMP e configura o FIFO para receber quadros de
+     * acelerômetro e giroscópio, com o DLPF abaixo da frequência de Nyquist.
+     * @param rate Taxa de amostragem pedida (Hz).
+     * @return float - Taxa efetiva (Hz).
+     */
+    float configureFifo(uint16_t rate);
+
+    /**
+     * @brief Configura o FIFO e o lote para a captura bruta (também usada
+     * após uma recuperação do sensor).
+     */
+    void configureRawCapture();
+
+    /**
+     * @brief Lê os quadros completos do FIFO para o lote em andamento e
+     * entrega o lote quando ele enche.
+     */
+    void updateRawData();
+
+    /**
+     * @brief Entrega as amostras acumuladas no lote e o esvazia.
+     *
+     */
+    void deliverRawBatch();
+
+#ifdef IMU_SOFTWARE_FUSION
+    /**
+     * @brief Lê os quadros do FIFO, passa todos pelo filtro e preenche a
+     * amostra com a orientação e as leituras do último.
+     * @param data Amostra lida.
+     * @param gyro Leituras brutas do giroscópio do último quadro (X, Y, Z).
+     * @return true - Caso uma amostra tenha sido lida.
+     * @return false - Caso contrário (falha contada em sampleFailed()).
+     */
+    bool updateFusion(IMUAxisData_t &data, int16_t *gyro);
+#endif
+
+    /**
+     * @brief Calcula o Yaw, Pitch e Roll da última orientação lida. Chamada só
+     * para as amostras que saem da task de leitura (histórico e função de amostras):
+     * as demais ficam apenas com a gravidade em ponto fixo.
+     * @param data Amostra lida.
+     */
+    void updateAngles(IMUAxisData_t &data);
     
     MPU6050 m_mpu;               // Objeto da classe MPU6050 utilizado para acessar os métodos da lib.          
     uint8_t m_deviceStatus;      // Status de funcionamento dispositivo (== 0 -> Funcionando).
     bool m_dmpStatus;            // Status de funcionamento do DMP.
+    uint32_t m_fifoOverflows;    // Vezes em que o FIFO estourou antes da leitura.
+    uint32_t m_dmpInitTime;      // Duração da inicialização do DMP no boot (us).
+    bool m_warmStart;            // Flag que indica se o DMP foi reaproveitado no boot.
+    bool m_storedOffsets;        // Flag que indica se os offsets vieram da NVS.
+    bool m_gyroBiasTracking;     // Flag que ativa a correção do bias do giroscópio nas paradas.
+    GyroBiasEstimator m_gyroBias; // Estimador do bias do giroscópio.
+    GyroTemperatureModel m_gyroModel; // Offset ideal do giroscópio em função da temperatura.
+    uint32_t m_lastModelUpdate;  // Millis() da última aplicação do modelo de temperatura.
+    uint32_t m_lastModelSave;    // Millis() da última gravação do modelo na NVS.
+    GyroTemperatureModel m_gyroModelSnapshot; // Cópia do modelo aguardando a gravação pelo loop.
+    bool m_gyroModelPending;     // Cópia entregue e ainda não gravada.
+    TwoWire *m_wire;             // Interface I2C, reiniciada na recuperação do barramento.
+    IMUOffsets_t m_offsets;      // Offsets aplicados, restaurados se o sensor reiniciar.
+    uint8_t m_failedSamples;     // Amostras seguidas com falha.
+    bool m_recovering;           // Flag que indica que o sensor está sendo recuperado.
+    uint32_t m_outageStart;      // Millis() da primeira amostra com falha.
+    uint32_t m_lastRecoveryAttempt; // Millis() da última tentativa de recuperação.
+    uint32_t m_recoveryAttempts; // Tentativas da recuperação em andamento.
+    uint32_t m_recoveries;       // Recuperações concluídas.
+    uint32_t m_lastOutage;       // Duração da última perda do sensor (ms).
+    uint32_t m_totalOutage;      // Soma das durações das perdas (ms).
+    volatile uint16_t m_rawRequest; // Taxa pedida para a captura bruta (0 = DMP), aplicada pela task de leitura.
+    uint16_t m_rawRate;          // Taxa da captura em andamento (0 = DMP ativo).
+    IMURawBatchCallback_t m_rawCallback; // Função que recebe os lotes da captura bruta.
+    IMURawSample_t m_rawBuffer[MPU6050_RAW_BATCH_SIZE]; // Lote em andamento, preenchido direto pelo FIFO.
+    IMURawBatch_t m_rawBatch;    // Descrição do lote em andamento.
+    uint8_t m_dmpRate;           // Divisor da taxa de amostragem do DMP, restaurado ao fim da captura.
+    uint8_t m_dmpDLPFMode;       // DLPF do DMP, restaurado ao fim da captura.
+    IMURawCaptureData_t m_rawData; // Contadores da captura bruta.
+    float m_gyroScale;           // °/s por LSB do giroscópio, da faixa configurada no sensor.
+#ifdef IMU_SOFTWARE_FUSION
+    IMUFusion m_fusion;          // Filtro de orientação no lugar do DMP.
+    bool m_fusionStarted;        // Flag que indica se o filtro já foi alinhado com a gravidade.
+    float m_fusionPeriod;        // Intervalo entre os quadros do FIFO (s).
+    float m_gyroRadScale;        // rad/s por LSB do giroscópio.
+    IMUFusionAlgorithm_e m_fusionAlgorithm; // Algoritmo pedido em setFusionAlgorithm().
+    IMUFusionGains_t m_fusionGains; // Ganhos pedidos em setFusionGains().
+    volatile bool m_fusionChanged; // Flag que indica algoritmo ou ganhos a aplicar.
+#endif
 };
 
 extern MPU6050IMU MPU;
\ No newline at end of file
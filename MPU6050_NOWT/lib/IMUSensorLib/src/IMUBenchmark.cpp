@@ -0,0 +1,170 @@
+/**
+ * @file IMUBenchmark.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Arquivo de implementação das funções da classe BenchmarkClass.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "IMUBenchmark.h"
+
+portMUX_TYPE g_benchmarkMux = portMUX_INITIALIZER_UNLOCKED; // Proteção das métricas entre tasks.
+
+void BenchmarkClass::begin(const char *architecture)
+{
+    m_architecture = architecture;
+    m_task = NULL;
+    m_stackSize = 0;
+    m_startTime = micros();
+    m_lastReport = millis();
+    m_sampleTime = 0;
+    m_readTime = 0;
+    m_lastSequence = 0;
+    m_samples = 0;
+    m_missed = 0;
+}
+
+void BenchmarkClass::setTask(TaskHandle_t task, uint32_t stackSize)
+{
+    m_task = task;
+    m_stackSize = stackSize;
+}
+
+void BenchmarkClass::readSample(IMUAxisData_t &data)
+{
+    uint32_t sequence;
+
+    // Assim como getFIFOCount(), cada consulta ocupa o barramento até haver um novo pacote.
+    do
+    {
+        busTransfer(2);
+        sequence = (micros() - m_startTime) / IMU_BENCHMARK_SAMPLE_PERIOD_US;
+    } while (sequence == m_lastSequence);
+
+    m_readTime = micros();
+    busTransfer(IMU_BENCHMARK_SAMPLE_BYTES);
+    generate(sequence, data);
+
+    portENTER_CRITICAL(&g_benchmarkMux);
+    m_missed += sequence - m_lastSequence - 1;
+    m_samples++;
+    portEXIT_CRITICAL(&g_benchmarkMux);
+
+    m_lastSequence = sequence;
+    m_sampleTime = m_startTime + sequence * IMU_BENCHMARK_SAMPLE_PERIOD_US;
+}
+
+void BenchmarkClass::sampleProcessed()
+{
+    uint32_t cpuTime = micros() - m_readTime;
+
+    portENTER_CRITICAL(&g_benchmarkMux);
+    m_cpuTime.add(cpuTime);
+    portEXIT_CRITICAL(&g_benchmarkMux);
+}
+
+void BenchmarkClass::stateUpdated()
+{
+    uint32_t latency = micros() - m_sampleTime;
+
+    portENTER_CRITICAL(&g_benchmarkMux);
+    m_latency.add(latency);
+    portEXIT_CRITICAL(&g_benchmarkMux);
+}
+
+void BenchmarkClass::addLockHold(uint32_t holdTime)
+{
+    portENTER_CRITICAL(&g_benchmarkMux);
+    m_lockHold.add(holdTime);
+    portEXIT_CRITICAL(&g_benchmarkMux);
+}
+
+void BenchmarkClass::handle()
+{
+    if((millis() - m_lastReport) < IMU_BENCHMARK_REPORT_INTERVAL)
+        return;
+
+    m_lastReport = millis();
+
+    portENTER_CRITICAL(&g_benchmarkMux);
+    IMUBenchmarkMetric_t latency = m_latency;
+    IMUBenchmarkMetric_t cpuTime = m_cpuTime;
+    IMUBenchmarkMetric_t lockHold = m_lockHold;
+    uint32_t samples = m_samples;
+    uint32_t missed = m_missed;
+    m_latency.reset();
+    m_cpuTime.reset();
+    m_lockHold.reset();
+    m_samples = 0;
+    m_missed = 0;
+    portEXIT_CRITICAL(&g_benchmarkMux);
+
+    uint32_t stackUsed = 0;
+    if(m_task != NULL)
+        stackUsed = m_stackSize - uxTaskGetStackHighWaterMark(m_task);
+
+    Serial.printf("\n[BENCH] arch=%s samples=%u missed=%u", m_architecture, samples, missed);
+    Serial.printf(" latency_us=%u/%u/%u", (latency.Count) ? latency.Min : 0, latency.average(), latency.Max);
+    Serial.printf(" cpu_us=%u/%u/%u", (cpuTime.Count) ? cpuTime.Min : 0, cpuTime.average(), cpuTime.Max);
+    Serial.printf(" lock_us=%u/%u/%u locks=%u", (lockHold.Count) ? lockHold.Min : 0, lockHold.average(), lockHold.Max, lockHold.Count);
+    Serial.printf(" heap=%u min_heap=%u stack=%u/%u", ESP.getFreeHeap(), ESP.getMinFreeHeap(), stackUsed, m_stackSize);
+}
+
+void BenchmarkClass::busTransfer(uint16_t bytes)
+{
+    delayMicroseconds(bytes * IMU_BENCHMARK_BYTE_TIME_US);
+}
+
+void BenchmarkClass::generate(uint32_t sequence, IMUAxisData_t &data)
+{
+    uint32_t step = sequence % IMU_BENCHMARK_CYCLE_SAMPLES;
+    double phase = (double)step / 100;
+
+    // Ruído determinístico para que todas as arquiteturas recebam a mesma carga.
+    uint32_t seed = sequence * 1103515245 + 12345;
+    double noise = ((double)((seed >> 16) & 0x7FFF) / 0x7FFF - 0.5) * 0.02;
+
+    data.Time = millis();
+    data.Temperature = 30.0 + noise;
+    data.Gyro_X = data.Gyro_Y = data.Gyro_Z = noise * 10;
+    data.Yaw = 10 * sin(phase / 10);
+
+    if(step < 800 || step >= 2400)
+    {
+        // Parado.
+        data.Acc_X = 0.02 + noise;
+        data.Acc_Y = 0.99 + noise;
+        data.Acc_Z = 0.05 + noise;
+        data.Pitch = 3 + noise;
+        data.Roll = 2 + noise;
+    }
+    else if(step < 1800)
+    {
+        // Em movimento.
+        data.Acc_X = 0.2 * sin(phase * 3) + noise;
+        data.Acc_Y = 1.0 + 0.15 * sin(phase * 7) + noise;
+        data.Acc_Z = 0.7 + 0.1 * cos(phase * 5) + noise;
+        data.Pitch = 5 * sin(phase) + noise;
+        data.Roll = 4 * cos(phase) + noise;
+    }
+    else
+    {
+        // Tombado (deitado de lado).
+        data.Acc_X = 0.05 + noise;
+        data.Acc_Y = -0.99 + noise;
+        data.Acc_Z = -0.8 + noise;
+        data.Pitch = 85 + noise;
+        data.Roll = 10 + noise;
+    }
+
+    // Gravidade coerente com o Pitch e o Roll gerados (ambos dentro de ±90, onde as
+    // fórmulas do DMP se invertem diretamente).
+    double pitch = data.Pitch * M_PI / 180, roll = data.Roll * M_PI / 180;
+    data.Gravity_X = sin(pitch) * IMU_GRAVITY_ONE;
+    data.Gravity_Y = cos(pitch) * sin(roll) * IMU_GRAVITY_ONE;
+    data.Gravity_Z = cos(pitch) * cos(roll) * IMU_GRAVITY_ONE;
+}
+
+BenchmarkClass Benchmark;
@@ -0,0 +1,247 @@
+/**
+ * @file IMUFusion.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Arquivo de implementação das funções da classe IMUFusion.
+ * @version 0.1
+ * @date 19-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <math.h>
+#include <string.h>
+
+#include "IMUFusion.h"
+
+static const float g_fusionPi = 3.14159265f;
+
+/**
+ * @brief Raiz inversa rápida: estimativa pelos bits do float e uma iteração de Newton.
+ *
+ * @return float - 1 / sqrt(x), com erro relativo < 0,2%.
+ */
+static inline float invSqrt(float x)
+{
+    float half = 0.5f * x;
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bits = 0x5f3759df - (bits >> 1);
+    memcpy(&x, &bits, sizeof(x));
+
+    return x * (1.5f - half * x * x);
+}
+
+/**
+ * @brief atan2 polinomial: o ângulo é reduzido para [0, 1] e aproximado por um
+ * polinômio ímpar de grau 9 (erro < 1e-5 rad).
+ */
+static inline float fastAtan2(float y, float x)
+{
+    float ax = fabsf(x), ay = fabsf(y);
+    if(ax == 0 && ay == 0)
+        return 0;
+
+    float a = (ax >= ay) ? ay / ax : ax / ay;
+    float s = a * a;
+    float r = (((((0.0208351f * s - 0.0851330f) * s + 0.1801410f) * s - 0.3302995f) * s + 0.9998660f)) * a;
+
+    if(ay > ax)
+        r = 0.5f * g_fusionPi - r;
+    if(x < 0)
+        r = g_fusionPi - r;
+    return (y < 0) ? -r : r;
+}
+
+IMUFusion::IMUFusion()
+{
+    m_algorithm = IMU_FUSION_MADGWICK;
+    m_gains.Beta = IMU_FUSION_MADGWICK_BETA;
+    m_gains.Kp = IMU_FUSION_MAHONY_KP;
+    m_gains.Ki = IMU_FUSION_MAHONY_KI;
+    reset();
+}
+
+void IMUFusion::setAlgorithm(IMUFusionAlgorithm_e algorithm)
+{
+    m_algorithm = algorithm;
+    m_integral[0] = m_integral[1] = m_integral[2] = 0;
+}
+
+IMUFusionAlgorithm_e IMUFusion::getAlgorithm()
+{
+    return m_algorithm;
+}
+
+void IMUFusion::setGains(const IMUFusionGains_t &gains)
+{
+    m_gains = gains;
+}
+
+IMUFusionGains_t IMUFusion::getGains()
+{
+    return m_gains;
+}
+
+void IMUFusion::reset()
+{
+    m_q[0] = 1;
+    m_q[1] = m_q[2] = m_q[3] = 0;
+    m_integral[0] = m_integral[1] = m_integral[2] = 0;
+}
+
+void IMUFusion::reset(const float *acc)
+{
+    reset();
+    if(acc[0] == 0 && acc[1] == 0 && acc[2] == 0)
+        return;
+
+    // Roll e pitch da gravidade medida, yaw zero (rotação Z-Y-X).
+    float roll = atan2f(acc[1], acc[2]);
+    float pitch = atan2f(-acc[0], sqrtf(acc[1] * acc[1] + acc[2] * acc[2]));
+    float cr = cosf(0.5f * roll), sr = sinf(0.5f * roll);
+    float cp = cosf(0.5f * pitch), sp = sinf(0.5f * pitch);
+
+    m_q[0] = cr * cp;
+    m_q[1] = sr * cp;
+    m_q[2] = cr * sp;
+    m_q[3] = -sr * sp;
+}
+
+void IMUFusion::update(const float *gyro, const float *acc, float dt)
+{
+    if(m_algorithm == IMU_FUSION_MAHONY)
+        updateMahony(gyro[0], gyro[1], gyro[2], acc[0], acc[1], acc[2], dt);
+    else
+        updateMadgwick(gyro[0], gyro[1], gyro[2], acc[0], acc[1], acc[2], dt);
+}
+
+void IMUFusion::getQuaternion(float *q)
+{
+    memcpy(q, m_q, sizeof(m_q));
+}
+
+void IMUFusion::getYawPitchRoll(float *ypr)
+{
+    float w = m_q[0], x = m_q[1], y = m_q[2], z = m_q[3];
+
+    // Mesmas fórmulas de dmpGetGravity() e dmpGetYawPitchRoll(), escritas sem supor a
+    // norma unitária (a raiz inversa rápida deixa o módulo um pouco fora de 1).
+    float gx = 2 * (x * z - w * y);
+    float gy = 2 * (w * x + y * z);
+    float gz = w * w - x * x - y * y + z * z;
+    float horizontal = gy * gy + gz * gz;
+
+    ypr[0] = fastAtan2(2 * x * y - 2 * w * z, w * w + x * x - y * y - z * z);
+    ypr[1] = fastAtan2(gx, (horizontal > 0) ? horizontal * invSqrt(horizontal) : 0);
+    ypr[2] = fastAtan2(gy, gz);
+    if(gz < 0)
+        ypr[1] = (ypr[1] > 0) ? g_fusionPi - ypr[1] : -g_fusionPi - ypr[1];
+}
+
+void IMUFusion::updateMadgwick(float gx, float gy, float gz, float ax, float ay, float az, float dt)
+{
+    float q0 = m_q[0], q1 = m_q[1], q2 = m_q[2], q3 = m_q[3];
+
+    // Derivada do quaternion pela velocidade angular.
+    float qDot0 = 0.5f * (-q1 * gx - q2 * gy - q3 * gz);
+    float qDot1 = 0.5f * (q0 * gx + q2 * gz - q3 * gy);
+    float qDot2 = 0.5f * (q0 * gy - q1 * gz + q3 * gx);
+    float qDot3 = 0.5f * (q0 * gz + q1 * gy - q2 * gx);
+
+    // Sem aceleração (queda livre ou leitura zerada) só o giroscópio é integrado.
+    float norm = ax * ax + ay * ay + az * az;
+    if(norm > 0)
+    {
+        float recipNorm = invSqrt(norm);
+        ax *= recipNorm;
+        ay *= recipNorm;
+        az *= recipNorm;
+
+        // Gradiente da função objetivo: gravidade estimada menos a medida.
+        float _2q0 = 2 * q0, _2q1 = 2 * q1, _2q2 = 2 * q2, _2q3 = 2 * q3;
+        float _4q0 = 4 * q0, _4q1 = 4 * q1, _4q2 = 4 * q2;
+        float _8q1 = 8 * q1, _8q2 = 8 * q2;
+        float q0q0 = q0 * q0, q1q1 = q1 * q1, q2q2 = q2 * q2, q3q3 = q3 * q3;
+
+        float s0 = _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay;
+        float s1 = _4q1 * q3q3 - _2q3 * ax + 4 * q0q0 * q1 - _2q0 * ay - _4q1 + _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az;
+        float s2 = 4 * q0q0 * q2 + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2 + _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
+        float s3 = 4 * q1q1 * q3 - _2q1 * ax + 4 * q2q2 * q3 - _2q2 * ay;
+
+        norm = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+        if(norm > 0)
+        {
+            recipNorm = m_gains.Beta * invSqrt(norm);
+            qDot0 -= recipNorm * s0;
+            qDot1 -= recipNorm * s1;
+            qDot2 -= recipNorm * s2;
+            qDot3 -= recipNorm * s3;
+        }
+    }
+
+    q0 += qDot0 * dt;
+    q1 += qDot1 * dt;
+    q2 += qDot2 * dt;
+    q3 += qDot3 * dt;
+
+    float recipNorm = invSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+    m_q[0] = q0 * recipNorm;
+    m_q[1] = q1 * recipNorm;
+    m_q[2] = q2 * recipNorm;
+    m_q[3] = q3 * recipNorm;
+}
+
+void IMUFusion::updateMahony(float gx, float gy, float gz, float ax, float ay, float az, float dt)
+{
+    float q0 = m_q[0], q1 = m_q[1], q2 = m_q[2], q3 = m_q[3];
+
+    float norm = ax * ax + ay * ay + az * az;
+    if(norm > 0)
+    {
+        float recipNorm = invSqrt(norm);
+        ax *= recipNorm;
+        ay *= recipNorm;
+        az *= recipNorm;
+
+        // Metade da gravidade estimada e o erro (produto vetorial com a medida).
+        float halfvx = q1 * q3 - q0 * q2;
+        float halfvy = q0 * q1 + q2 * q3;
+        float halfvz = q0 * q0 - 0.5f + q3 * q3;
+        float halfex = ay * halfvz - az * halfvy;
+        float halfey = az * halfvx - ax * halfvz;
+        float halfez = ax * halfvy - ay * halfvx;
+
+        // Ganhos na forma da implementação de referência (twoKp e twoKi sobre o meio erro).
+        if(m_gains.Ki > 0)
+        {
+            m_integral[0] += m_gains.Ki * halfex * dt;
+            m_integral[1] += m_gains.Ki * halfey * dt;
+            m_integral[2] += m_gains.Ki * halfez * dt;
+            gx += m_integral[0];
+            gy += m_integral[1];
+            gz += m_integral[2];
+        }
+        else
+            m_integral[0] = m_integral[1] = m_integral[2] = 0;
+
+        gx += m_gains.Kp * halfex;
+        gy += m_gains.Kp * halfey;
+        gz += m_gains.Kp * halfez;
+    }
+
+    gx *= 0.5f * dt;
+    gy *= 0.5f * dt;
+    gz *= 0.5f * dt;
+
+    float qa = q0, qb = q1, qc = q2;
+    q0 += -qb * gx - qc * gy - q3 * gz;
+    q1 += qa * gx + qc * gz - q3 * gy;
+    q2 += qa * gy - qb * gz + q3 * gx;
+    q3 += qa * gz + qb * gy - qc * gx;
+
+    float recipNorm = invSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+    m_q[0] = q0 * recipNorm;
+    m_q[1] = q1 * recipNorm;
+    m_q[2] = q2 * recipNorm;
+    m_q[3] = q3 * recipNorm;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file IMUOffsetStore.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Arquivo de implementação das funções da classe OffsetStoreClass.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "IMUOffsetStore.h"
+#include "Framing.h"
+
+bool OffsetStoreClass::load(IMUModel_e model, IMUOffsets_t &offsets)
+{
+    uint8_t record[OFFSET_STORE_RECORD_SIZE];
+    uint8_t identity[OFFSET_STORE_IDENTITY_SIZE];
+    Preferences preferences;
+
+    if(!preferences.begin(OFFSET_STORE_NAMESPACE, true))
+        return false;
+
+    size_t size = preferences.getBytes(OFFSET_STORE_KEY, record, sizeof(record));
+    preferences.end();
+
+    if(size != OFFSET_STORE_RECORD_SIZE || record[0] != OFFSET_STORE_VERSION)
+        return false;
+
+    uint16_t crc = record[OFFSET_STORE_RECORD_SIZE - 2] | (record[OFFSET_STORE_RECORD_SIZE - 1] << 8);
+    if(crc16CCITT(record, OFFSET_STORE_RECORD_SIZE - 2) != crc)
+        return false;
+
+    getIdentity(model, identity);
+    if(memcmp(&record[1], identity, OFFSET_STORE_IDENTITY_SIZE) != 0)
+        return false;
+
+    int16_t values[6];
+    for(uint8_t i = 0; i < 6; i++)
+        values[i] = (int16_t)(record[8 + 2 * i] | (record[9 + 2 * i] << 8));
+
+    offsets = IMUOffsets_t(values[0], values[1], values[2], values[3], values[4], values[5]);
+
+    return true;
+}
+
+bool OffsetStoreClass::save(IMUModel_e model, const IMUOffsets_t &offsets)
+{
+    uint8_t record[OFFSET_STORE_RECORD_SIZE];
+    const int16_t values[6] = {offsets.XAccelOffset, offsets.YAccelOffset, offsets.ZAccelOffset,
+                               offsets.XGyroOffset, offsets.YGyroOffset, offsets.ZGyroOffset};
+
+    record[0] = OFFSET_STORE_VERSION;
+    getIdentity(model, &record[1]);
+
+    for(uint8_t i = 0; i < 6; i++)
+    {
+        record[8 + 2 * i] = (uint16_t)values[i] & 0xFF;
+        record[9 + 2 * i] = (uint16_t)values[i] >> 8;
+    }
+
+    uint16_t crc = crc16CCITT(record, OFFSET_STORE_RECORD_SIZE - 2);
+    record[OFFSET_STORE_RECORD_SIZE - 2] = crc & 0xFF;
+    record[OFFSET_STORE_RECORD_SIZE - 1] = crc >> 8;
+
+    Preferences preferences;
+    if(!preferences.begin(OFFSET_STORE_NAMESPACE, false))
+        return false;
+
+    size_t size = preferences.putBytes(OFFSET_STORE_KEY, record, sizeof(record));
+    preferences.end();
+
+    return size == OFFSET_STORE_RECORD_SIZE;
+}
+
+bool OffsetStoreClass::loadGyroModel(IMUModel_e model, GyroTemperatureModel &gyroModel)
+{
+    uint8_t record[OFFSET_STORE_MODEL_SIZE];
+    uint8_t identity[OFFSET_STORE_IDENTITY_SIZE];
+    Preferences preferences;
+
+    if(!preferences.begin(OFFSET_STORE_NAMESPACE, true))
+        return false;
+
+    size_t size = preferences.getBytes(OFFSET_STORE_MODEL_KEY, record, sizeof(record));
+    preferences.end();
+
+    if(size != OFFSET_STORE_MODEL_SIZE || record[0] != OFFSET_STORE_MODEL_VERSION)
+        return false;
+
+    uint16_t crc = record[OFFSET_STORE_MODEL_SIZE - 2] | (record[OFFSET_STORE_MODEL_SIZE - 1] << 8);
+    if(crc16CCITT(record, OFFSET_STORE_MODEL_SIZE - 2) != crc)
+        return false;
+
+    getIdentity(model, identity);
+    if(memcmp(&record[1], identity, OFFSET_STORE_IDENTITY_SIZE) != 0)
+        return false;
+
+    for(uint8_t i = 0; i < GYRO_MODEL_NODES; i++)
+    {
+        const uint8_t *node = &record[8 + i * OFFSET_STORE_NODE_SIZE];
+        GyroModelNode_t &target = gyroModel.Nodes[i];
+
+        target.Weight = min(node[0], (uint8_t)GYRO_MODEL_MAX_WEIGHT);
+        memcpy(&target.Temperature, &node[1], 4);
+        memcpy(target.Offset, &node[5], 12);
+    }
+    gyroModel.setSaved();
+
+    return true;
+}
+
+bool OffsetStoreClass::saveGyroModel(IMUModel_e model, const GyroTemperatureModel &gyroModel)
+{
+    uint8_t record[OFFSET_STORE_MODEL_SIZE];
+
+    record[0] = OFFSET_STORE_MODEL_VERSION;
+    getIdentity(model, &record[1]);
+
+    for(uint8_t i = 0; i < GYRO_MODEL_NODES; i++)
+    {
+        uint8_t *node = &record[8 + i * OFFSET_STORE_NODE_SIZE];
+        const GyroModelNode_t &source = gyroModel.Nodes[i];
+
+        node[0] = source.Weight;
+        memcpy(&node[1], &source.Temperature, 4);
+        memcpy(&node[5], source.Offset, 12);
+    }
+
+    uint16_t crc = crc16CCITT(record, OFFSET_STORE_MODEL_SIZE - 2);
+    record[OFFSET_STORE_MODEL_SIZE - 2] = crc & 0xFF;
+    record[OFFSET_STORE_MODEL_SIZE - 1] = crc >> 8;
+
+    Preferences preferences;
+    if(!preferences.begin(OFFSET_STORE_NAMESPACE, false))
+        return false;
+
+    size_t size = preferences.putBytes(OFFSET_STORE_MODEL_KEY, record, sizeof(record));
+    preferences.end();
+
+    return size == OFFSET_STORE_MODEL_SIZE;
+}
+
+void OffsetStoreClass::clear()
+{
+    Preferences preferences;
+    if(!preferences.begin(OFFSET_STORE_NAMESPACE, false))
+        return;
+
+    preferences.remove(OFFSET_STORE_KEY);
+    preferences.remove(OFFSET_STORE_MODEL_KEY);
+    preferences.end();
+}
+
+void OffsetStoreClass::getIdentity(IMUModel_e model, uint8_t *identity)
+{
+    uint64_t mac = ESP.getEfuseMac();
+
+    identity[0] = model;
+    for(uint8_t i = 0; i < 6; i++)
+        identity[1 + i] = (mac >> (8 * i)) & 0xFF;
+}
+
+OffsetStoreClass OffsetStore;
@@ -0,0 +1,28 @@
+/**
+ * @file IMUProfiles.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Valores dos perfis de detecção pré-definidos.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "IMUProfiles.h"
+
+// Tombamento (limiar em graus, amostras), movimento e parada (intervalo em g, amostras),
+// tamper (tempo em segundos, amostras).
+const IMUProfile_t g_profiles[IMU_PROFILE_COUNT] = {
+    // Caminhão: mais vibração, exige mais amostras para confirmar os eventos.
+    {"truck", IMUDetectionSettings_t(IMUTippingSettings_t(150, 20), IMUMovementSettings_t(0.10, 6),
+                                     IMUStopSettings_t(0.08, 25), IMUTamperSettings_t(10, 8))},
+    // Carro: valores usados originalmente no setup().
+    {"car", IMUDetectionSettings_t(IMUTippingSettings_t(140, 17), IMUMovementSettings_t(0.07, 4),
+                                   IMUStopSettings_t(0.06, 17), IMUTamperSettings_t(7, 5))},
+    // Motocicleta: inclina nas curvas, portanto o tombamento exige um ângulo maior.
+    {"motorcycle", IMUDetectionSettings_t(IMUTippingSettings_t(120, 10), IMUMovementSettings_t(0.12, 3),
+                                          IMUStopSettings_t(0.08, 15), IMUTamperSettings_t(5, 4))},
+    // Estacionado: qualquer movimento é suspeito.
+    {"parked", IMUDetectionSettings_t(IMUTippingSettings_t(140, 17), IMUMovementSettings_t(0.04, 2),
+                                      IMUStopSettings_t(0.05, 10), IMUTamperSettings_t(3, 3))}
+};
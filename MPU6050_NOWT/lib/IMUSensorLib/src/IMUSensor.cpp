@@ -19,9 +19,38 @@ unsigned long g_firstMovement = 0;  // Millis() em que ocorreu a primeira leitur
 unsigned long g_firstStop = 0;      // Millis() em que ocorreu a primeira leitura de parada.
 unsigned long g_firstTamper = 0;    // Millis() em que ocorreu a primeira leitura de tamper.
 unsigned long g_firstMovingTip = 0; // Millis() em que é identificado um tombamento com movimento.
+portMUX_TYPE g_settingsMux = portMUX_INITIALIZER_UNLOCKED; // Serializa quem publica configurações (a leitura não o utiliza).
+
+/**
+ * @brief Converte o limiar de tombamento (graus) para o eixo X da gravidade.
+ * Nas fórmulas do DMP, |Roll| > 90 equivale à gravidade Z negativa, e então o Pitch
+ * vale ±180 menos o ângulo da gravidade X com o plano. Os dois ramos do critério em
+ * graus se reduzem a |gravidade X| > sen(180 - limiar).
+ * @return int32_t - Limiar em Q30 (INT32_MAX quando o limiar não pode ser atingido).
+ */
+static int32_t tippingLimit(double threshold)
+{
+    if(threshold <= 90)
+        return INT32_MAX;
+    if(threshold >= 180)
+        return 0;
+
+    return (int32_t)(sin((180 - threshold) * M_PI / 180) * IMU_GRAVITY_ONE);
+}
 
 bool IMUSensor::begin(TwoWire &wire)
 {
+    m_samples = 0;
+    m_intervalIndex = 0;
+    m_lastSampleTime = 0;
+    m_baseProfile = m_activeProfile = IMU_PROFILE_NONE;
+    m_settingsOverride = false;
+    for(int i = 0; i < g_stateCount; i++)
+        m_stateProfiles[i] = IMU_PROFILE_NONE;
+    m_settingsGeneration = 0;
+    m_activeGeneration = 0;
+    m_tippingLimit = INT32_MAX;
+
     m_imuSemaphore = xSemaphoreCreateMutex();
     m_semaphoreInitialized = m_imuSemaphore != NULL;
     
@@ -30,46 +59,130 @@ bool IMUSensor::begin(TwoWire &wire)
 
 void IMUSensor::configureTipping(IMUTippingSettings_t settings)
 {
-    if(!m_semaphoreInitialized)
-        return;
-
-    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
-    m_tippingSettings.MinimumSamples = settings.MinimumSamples;
-    m_tippingSettings.TippingStartThreshold = settings.TippingStartThreshold;
-    xSemaphoreGive(m_imuSemaphore);
+    portENTER_CRITICAL(&g_settingsMux);
+    IMUDetectionSettings_t newSettings = m_settingsBuffer[m_settingsGeneration & 1];
+    newSettings.Tipping = settings;
+    m_settingsOverride = true;
+    publishSettings(newSettings);
+    portEXIT_CRITICAL(&g_settingsMux);
 }
 
 void IMUSensor::configureMovementDetection(IMUMovementSettings_t settings)
 {
-    if(!m_semaphoreInitialized)
+    portENTER_CRITICAL(&g_settingsMux);
+    IMUDetectionSettings_t newSettings = m_settingsBuffer[m_settingsGeneration & 1];
+    newSettings.Movement = settings;
+    m_settingsOverride = true;
+    publishSettings(newSettings);
+    portEXIT_CRITICAL(&g_settingsMux);
+}
+
+void IMUSensor::configureStopDetection(IMUStopSettings_t settings)
+{
+    portENTER_CRITICAL(&g_settingsMux);
+    IMUDetectionSettings_t newSettings = m_settingsBuffer[m_settingsGeneration & 1];
+    newSettings.Stop = settings;
+    m_settingsOverride = true;
+    publishSettings(newSettings);
+    portEXIT_CRITICAL(&g_settingsMux);
+}
+
+void IMUSensor::configureTamperDetection(IMUTamperSettings_t settings)
+{
+    portENTER_CRITICAL(&g_settingsMux);
+    IMUDetectionSettings_t newSettings = m_settingsBuffer[m_settingsGeneration & 1];
+    newSettings.Tamper = settings;
+    m_settingsOverride = true;
+    publishSettings(newSettings);
+    portEXIT_CRITICAL(&g_settingsMux);
+}
+
+void IMUSensor::configure(const IMUDetectionSettings_t &settings)
+{
+    portENTER_CRITICAL(&g_settingsMux);
+    m_settingsOverride = true;
+    publishSettings(settings);
+    portEXIT_CRITICAL(&g_settingsMux);
+}
+
+IMUDetectionSettings_t IMUSensor::getSettings()
+{
+    portENTER_CRITICAL(&g_settingsMux);
+    IMUDetectionSettings_t settings = m_settingsBuffer[m_settingsGeneration & 1];
+    portEXIT_CRITICAL(&g_settingsMux);
+
+    return settings;
+}
+
+void IMUSensor::publishSettings(const IMUDetectionSettings_t &settings)
+{
+    // Escreve no buffer que a task de leitura não está usando e só então avança a geração.
+    uint32_t generation = m_settingsGeneration + 1;
+    m_settingsBuffer[generation & 1] = settings;
+    __atomic_store_n(&m_settingsGeneration, generation, __ATOMIC_RELEASE);
+}
+
+void IMUSensor::refreshSettings()
+{
+    uint32_t generation = __atomic_load_n(&m_settingsGeneration, __ATOMIC_ACQUIRE);
+    if(generation == m_activeGeneration)
         return;
 
-    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
-    m_movementSettings.MinimumSamples = settings.MinimumSamples;
-    m_movementSettings.MovementInterval = settings.MovementInterval;
-    xSemaphoreGive(m_imuSemaphore);
+    // O buffer lido só é reescrito duas gerações depois; se a geração mudou
+    // durante a cópia, a cópia é refeita. A barreira impede que as leituras da
+    // cópia sejam adiadas para depois da segunda leitura da geração.
+    IMUDetectionSettings_t settings;
+    uint32_t check;
+    do
+    {
+        generation = __atomic_load_n(&m_settingsGeneration, __ATOMIC_ACQUIRE);
+        settings = m_settingsBuffer[generation & 1];
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        check = __atomic_load_n(&m_settingsGeneration, __ATOMIC_RELAXED);
+    } while(check != generation);
+
+    m_settings = settings;
+    m_tippingLimit = tippingLimit(settings.Tipping.TippingStartThreshold);
+    m_activeGeneration = generation;
 }
 
-void IMUSensor::configureStopDetection(IMUStopSettings_t settings)
+void IMUSensor::applyProfile(IMUProfile_e profile)
 {
-    if(!m_semaphoreInitialized)
+    if(profile >= IMU_PROFILE_COUNT)
         return;
 
-    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
-    m_stopSettings.MinimumSamples = settings.MinimumSamples;
-    m_stopSettings.StopInterval = settings.StopInterval;
-    xSemaphoreGive(m_imuSemaphore);
+    // Um perfil escolhido explicitamente descarta os ajustes feitos em funcionamento.
+    portENTER_CRITICAL(&g_settingsMux);
+    m_baseProfile = profile;
+    m_activeProfile = profile;
+    m_settingsOverride = false;
+    publishSettings(g_profiles[profile].Settings);
+    portEXIT_CRITICAL(&g_settingsMux);
 }
 
-void IMUSensor::configureTamperDetection(IMUTamperSettings_t settings)
+IMUProfile_e IMUSensor::getProfile()
 {
-    if(!m_semaphoreInitialized)
+    return m_activeProfile;
+}
+
+void IMUSensor::setStateProfile(DeviceState_e state, IMUProfile_e profile)
+{
+    if(state >= g_stateCount || (profile >= IMU_PROFILE_COUNT && profile != IMU_PROFILE_NONE))
         return;
 
-    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
-    m_tamperSettings.MinimumSamples = settings.MinimumSamples;
-    m_tamperSettings.TamperTime = settings.TamperTime;
-    xSemaphoreGive(m_imuSemaphore);
+    m_stateProfiles[state] = profile;
+}
+
+void IMUSensor::selectProfile(IMUProfile_e profile)
+{
+    // Testado sob o mesmo lock dos configure*(), para não sobrescrever um ajuste recém-publicado.
+    portENTER_CRITICAL(&g_settingsMux);
+    if(!m_settingsOverride)
+    {
+        m_activeProfile = profile;
+        publishSettings(g_profiles[profile].Settings);
+    }
+    portEXIT_CRITICAL(&g_settingsMux);
 }
 
 IMUAxisData_t IMUSensor::getAxisData()
@@ -78,9 +191,9 @@ IMUAxisData_t IMUSensor::getAxisData()
 
     if(!m_axisData.isEmpty() && m_semaphoreInitialized)
     {
-        xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+        lock();
         lastData = m_axisData.last();
-        xSemaphoreGive(m_imuSemaphore);
+        unlock();
     }
 
     return lastData;
@@ -93,9 +206,9 @@ bool IMUSensor::isRunning()
 
     bool threadRunning = false;
 
-    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+    lock();
     threadRunning = m_threadRunning;
-    xSemaphoreGive(m_imuSemaphore);
+    unlock();
     
     return threadRunning;
 }
@@ -107,9 +220,9 @@ bool IMUSensor::getTippedState()
 
     bool tipped = false;
 
-    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+    lock();
     tipped = m_tipped;
-    xSemaphoreGive(m_imuSemaphore);
+    unlock();
 
     return tipped;
 }
@@ -121,9 +234,9 @@ bool IMUSensor::getMovingState()
 
     bool moving = false;
 
-    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+    lock();
     moving = m_moving;
-    xSemaphoreGive(m_imuSemaphore);
+    unlock();
 
     return moving;
 }
@@ -135,9 +248,9 @@ bool IMUSensor::getTamperState()
     
     bool tamper = false;
 
-    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+    lock();
     tamper = m_tamper;
-    xSemaphoreGive(m_imuSemaphore);
+    unlock();
 
     return tamper;
 }
@@ -149,49 +262,36 @@ void IMUSensor::detectTipping()
 
     IMUAxisData_t lastData = getAxisData();
 
-    if(abs(lastData.Roll) > 90)
+    // Comparação inteira sobre a gravidade em Q30, sem Yaw, Pitch e Roll (ver tippingLimit()).
+    if(lastData.Gravity_X > m_tippingLimit || lastData.Gravity_X < -m_tippingLimit)
     {
-        if(abs(lastData.Pitch) < m_tippingSettings.TippingStartThreshold)
-        {
-            if(g_tippedCount == 0)
-                g_firstTip = lastData.Time;
-            g_tippedCount++;
-        }
-        else
-            g_tippedCount = 0;
+        if(g_tippedCount == 0)
+            g_firstTip = lastData.Time;
+        g_tippedCount++;
     }
     else
-    {
-        if(abs(lastData.Pitch) > (180 - m_tippingSettings.TippingStartThreshold))
-        {
-            if(g_tippedCount == 0)
-                g_firstTip = lastData.Time;
-            g_tippedCount++;
-        }
-        else
-            g_tippedCount = 0;
-    }
+        g_tippedCount = 0;
 
-    if(g_tippedCount >= m_tippingSettings.MinimumSamples && m_axisData.isFull())
+    if(g_tippedCount >= m_settings.Tipping.MinimumSamples && m_axisData.isFull())
     {
-        xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+        lock();
         m_tippingData.AxisMeasurements.clear();
         
         m_tipped = true;
 
-        m_tippingData.Side = (lastData.Pitch > 0) ? IMUTippingSide_e::IMU_TIP_SIDE_LEFT : IMUTippingSide_e::IMU_TIP_SIDE_RIGHT;
+        m_tippingData.Side = (lastData.Gravity_X > 0) ? IMUTippingSide_e::IMU_TIP_SIDE_LEFT : IMUTippingSide_e::IMU_TIP_SIDE_RIGHT;
         m_tippingData.StartTime = g_firstTip;
 
         for(int i = 0; i < g_historySize; i++)
             m_tippingData.AxisMeasurements.push_back(m_axisData[i]);
 
-        xSemaphoreGive(m_imuSemaphore);
+        unlock();
     }
     else
     {
-        xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+        lock();
         m_tipped = false;
-        xSemaphoreGive(m_imuSemaphore);
+        unlock();
     }
 }
 
@@ -204,22 +304,22 @@ void IMUSensor::detectMovement()
 
     double moduleAcc = sqrt(pow(lastData.Acc_X, 2) + pow(lastData.Acc_Y, 2) + pow(lastData.Acc_Z, 2));
 
-    if(moduleAcc < (1 - m_movementSettings.MovementInterval) || moduleAcc > (1 + m_movementSettings.MovementInterval))
+    if(moduleAcc < (1 - m_settings.Movement.MovementInterval) || moduleAcc > (1 + m_settings.Movement.MovementInterval))
     {
         if(g_movementCount == 0)
             g_firstMovement = lastData.Time;
         g_movementCount++;
     }
 
-    if(g_movementCount >= m_movementSettings.MinimumSamples)
+    if(g_movementCount >= m_settings.Movement.MinimumSamples)
     {
         g_stopCount = 0;
 
-        xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+        lock();
         m_moving = true;
 
         m_movementData.StartTime = g_firstMovement;
-        xSemaphoreGive(m_imuSemaphore);
+        unlock();
     }
 }
 
@@ -232,7 +332,7 @@ void IMUSensor::detectStop()
 
     double moduleAcc = sqrt(pow(lastData.Acc_X, 2) + pow(lastData.Acc_Y, 2) + pow(lastData.Acc_Z, 2));
 
-    if(moduleAcc > (1 - m_stopSettings.StopInterval) && moduleAcc < (1 + m_stopSettings.StopInterval))
+    if(moduleAcc > (1 - m_settings.Stop.StopInterval) && moduleAcc < (1 + m_settings.Stop.StopInterval))
     {
         if(g_stopCount == 0)
             g_firstStop = lastData.Time;
@@ -241,15 +341,15 @@ void IMUSensor::detectStop()
     else
         g_stopCount = 0;
 
-    if(g_stopCount >= m_stopSettings.MinimumSamples)
+    if(g_stopCount >= m_settings.Stop.MinimumSamples)
     {
         g_movementCount = 0;
 
-        xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+        lock();
         m_moving = false;
 
         m_stopData.StartTime = g_firstStop;
-        xSemaphoreGive(m_imuSemaphore);
+        unlock();
     }
 }
 
@@ -269,19 +369,19 @@ void IMUSensor::detectTamper()
     else
         g_tamperCount = 0;
     
-    if(g_tamperCount >= m_tamperSettings.MinimumSamples)
+    if(g_tamperCount >= m_settings.Tamper.MinimumSamples)
     {
-        xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+        lock();
         m_tamper = true;
 
         m_tamperData.StartTime = g_firstTamper;
-        xSemaphoreGive(m_imuSemaphore);
+        unlock();
     }
     else 
     {
-        xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+        lock();
         m_tamper = false;
-        xSemaphoreGive(m_imuSemaphore);
+        unlock();
     }
 }
 
@@ -290,9 +390,9 @@ void IMUSensor::addMeasurement(IMUAxisData_t measurement)
     if(!m_semaphoreInitialized)
         return;
 
-    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+    lock();
     m_axisData.push(measurement);
-    xSemaphoreGive(m_imuSemaphore);
+    unlock();
 }
 
 void IMUSensor::resetMeasurements()
@@ -300,9 +400,9 @@ void IMUSensor::resetMeasurements()
     if(!m_semaphoreInitialized)
         return;
 
-    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+    lock();
     m_axisData.clear();
-    xSemaphoreGive(m_imuSemaphore);
+    unlock();
 }
 
 void IMUSensor::getTippedData(IMUTippingData_t &tippingStruct)
@@ -310,11 +410,11 @@ void IMUSensor::getTippedData(IMUTippingData_t &tippingStruct)
     if(!m_semaphoreInitialized)
         return;
 
-    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+    lock();
     tippingStruct.StartTime = m_tippingData.StartTime;
     tippingStruct.Side = m_tippingData.Side;
     tippingStruct.AxisMeasurements.assign(m_tippingData.AxisMeasurements.begin(), m_tippingData.AxisMeasurements.end());    
-    xSemaphoreGive(m_imuSemaphore);
+    unlock();
 }
 
 void IMUSensor::getMovementData(IMUMovementData_t &movementStruct)
@@ -322,9 +422,9 @@ void IMUSensor::getMovementData(IMUMovementData_t &movementStruct)
     if(!m_semaphoreInitialized)
         return;
 
-    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+    lock();
     movementStruct.StartTime = m_movementData.StartTime;    
-    xSemaphoreGive(m_imuSemaphore);
+    unlock();
 }
 
 void IMUSensor::getStopData(IMUStopData_t &stopStruct)
@@ -332,9 +432,9 @@ void IMUSensor::getStopData(IMUStopData_t &stopStruct)
     if(!m_semaphoreInitialized)
         return;
 
-    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+    lock();
     stopStruct.StartTime = m_stopData.StartTime;    
-    xSemaphoreGive(m_imuSemaphore);
+    unlock();
 }
 
 void IMUSensor::getTamperData(IMUTamperData_t &tamperStruct)
@@ -342,9 +442,9 @@ void IMUSensor::getTamperData(IMUTamperData_t &tamperStruct)
     if(!m_semaphoreInitialized)
         return;
 
-    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+    lock();
     tamperStruct.StartTime = m_tamperData.StartTime;
-    xSemaphoreGive(m_imuSemaphore);
+    unlock();
 }
 
 DeviceState_e IMUSensor::getDevState()
@@ -353,9 +453,9 @@ DeviceState_e IMUSensor::getDevState()
 
     if(m_semaphoreInitialized)
     {
-        xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+        lock();
         devState = m_devState;
-        xSemaphoreGive(m_imuSemaphore);
+        unlock();
     }
 
     return devState;
@@ -371,7 +471,7 @@ void IMUSensor::updateState()
     {
         if(g_firstMovingTip == 0)
             g_firstMovingTip = millis();
-        else if(abs(millis() - g_firstMovingTip) > (m_tamperSettings.TamperTime * 1000))
+        else if(abs(millis() - g_firstMovingTip) > (m_settings.Tamper.TamperTime * 1000))
         {
             m_devState = DeviceState_e::STATE_TAMPER;
             g_firstMovingTip = 0;
@@ -384,14 +484,87 @@ void IMUSensor::updateState()
 
     if(!(m_moving && m_tipped))
         g_firstMovingTip = 0;
+
+    // Troca de perfil pelo estado: apenas a publicação de um bloco já pronto em flash.
+    // Suspensa enquanto houver ajustes feitos em funcionamento (ver selectProfile()).
+    IMUProfile_e profile = m_stateProfiles[m_devState];
+    if(profile == IMU_PROFILE_NONE)
+        profile = m_baseProfile;
+
+    if(profile != IMU_PROFILE_NONE && profile != m_activeProfile && !m_settingsOverride)
+        selectProfile(profile);
 }
 
 bool IMUSensor::checkConfigurations()
 {
-    bool TipSetted = m_tippingSettings.MinimumSamples != 0; 
-    bool MovementSetted = m_movementSettings.MinimumSamples != 0; 
-    bool StopSetted = m_stopSettings.MinimumSamples != 0; 
-    bool TamperSetted = m_tamperSettings.MinimumSamples != 0; 
+    IMUDetectionSettings_t settings = getSettings();
+
+    bool TipSetted = settings.Tipping.MinimumSamples != 0; 
+    bool MovementSetted = settings.Movement.MinimumSamples != 0; 
+    bool StopSetted = settings.Stop.MinimumSamples != 0; 
+    bool TamperSetted = settings.Tamper.MinimumSamples != 0; 
     
     return (TipSetted || MovementSetted || StopSetted || TamperSetted);
+}
+
+void IMUSensor::getHealth(IMUHealth_t &health)
+{
+    uint32_t intervals[g_jitterWindow];
+    uint32_t samples = m_samples;
+    uint16_t count = (samples > g_jitterWindow) ? g_jitterWindow : ((samples > 0) ? samples - 1 : 0);
+
+    memcpy(intervals, m_sampleIntervals, count * sizeof(uint32_t));
+    health.Samples = samples;
+
+    if(count == 0)
+        return;
+
+    std::sort(intervals, intervals + count);
+    health.IntervalP50 = intervals[(count - 1) * 50 / 100];
+    health.IntervalP90 = intervals[(count - 1) * 90 / 100];
+    health.IntervalP99 = intervals[(count - 1) * 99 / 100];
+    health.IntervalMax = intervals[count - 1];
+}
+
+void IMUSensor::registerSample()
+{
+    unsigned long now = micros();
+
+    if(m_samples > 0)
+    {
+        m_sampleIntervals[m_intervalIndex] = now - m_lastSampleTime;
+        m_intervalIndex = (m_intervalIndex + 1) % g_jitterWindow;
+    }
+
+    m_lastSampleTime = now;
+    m_samples++;
+}
+
+void IMUSensor::setSampleCallback(IMUSampleCallback_t callback)
+{
+    m_sampleCallback = callback;
+}
+
+void IMUSensor::notifySample(const IMUAxisData_t &data)
+{
+    // Lido uma vez: o callback pode ser trocado por outra task a qualquer momento.
+    IMUSampleCallback_t callback = m_sampleCallback;
+    if(callback != NULL)
+        callback(data, m_devState);
+}
+
+void IMUSensor::lock()
+{
+    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+#ifdef IMU_BENCHMARK
+    m_lockTime = micros();
+#endif
+}
+
+void IMUSensor::unlock()
+{
+#ifdef IMU_BENCHMARK
+    Benchmark.addLockHold(micros() - m_lockTime);
+#endif
+    xSemaphoreGive(m_imuSemaphore);
 }
\ No newline at end of file
@@ -0,0 +1,355 @@
+/**
+ * @file MPU6050Mag_IMU.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Arquivo de implementação das funções da classe MPU6050MagIMU.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "MPU6050Mag_IMU.h"
+#include "IMULogger.h"
+#include "I2CdevAsync.h"
+
+static const float g_magDegreeRad = 180 / M_PI; // Termo de conversão de radianos para graus.
+
+MPU6050MagIMU::MPU6050MagIMU()
+{
+    m_deviceStatus = 0;
+    m_dmpStatus = false;
+    m_storedOffsets = false;
+    m_packetSize = 0;
+    m_fifoOverflows = 0;
+    m_dmpInitTime = 0;
+    m_gyroScale = 1 / 131.0f;
+    m_magBias[0] = m_magBias[1] = m_magBias[2] = 0;
+    m_declination = 0;
+    m_timeLastRead = 0;
+    m_readTaskHandle = NULL;
+    m_sampleCallback = NULL;
+    m_moving = false;
+    m_tipped = false;
+    m_tamper = false;
+    m_threadRunning = false;
+    m_devState = DeviceState_e::STATE_STOPPED;
+}
+
+bool MPU6050MagIMU::begin(TwoWire &wire)
+{
+    IMUOffsets_t offsets = IMUOffsets_t(534, 439, 1134, -33, -70, -44);
+    m_storedOffsets = OffsetStore.load(IMU_MODEL_MPU6050_MAG, offsets);
+
+    return begin(wire, offsets);
+}
+
+bool MPU6050MagIMU::begin(TwoWire &wire, IMUOffsets_t offsets)
+{
+#ifdef IMU_BENCHMARK
+    // No benchmark o sensor é simulado, então o barramento não é utilizado.
+    m_dmpStatus = true;
+    return IMUSensor::begin(wire);
+#endif
+
+#if I2CDEV_IMPLEMENTATION == I2CDEV_ESP32_ASYNC
+    if(!I2CdevAsync.begin(I2C_NUM_0, MPU6050_PIN_SDA, MPU6050_PIN_SCL, MPU6050_FREQUENCY))
+        return false;
+#else
+    wire.begin(MPU6050_PIN_SDA, MPU6050_PIN_SCL, MPU6050_FREQUENCY);
+#endif
+
+    if(!m_mpu.testConnection())
+        return false;
+
+    m_mpu.setShadowRegistersEnabled(true);
+
+    // O dmpInitialize() fala com o magnetômetro direto (bypass) apenas para configurá-lo;
+    // depois o mestre I2C do MPU o lê a cada amostra e o host só acessa o FIFO.
+    uint32_t initStart = micros();
+    m_deviceStatus = m_mpu.dmpInitialize();
+    m_dmpInitTime = micros() - initStart;
+    Logger.printf("\n[MPU6050MagIMU] DMP (MotionApps 4.1) inicializado em %u us (status %u).", m_dmpInitTime,
+                  m_deviceStatus);
+
+    setOffsets(offsets);
+
+    if(m_deviceStatus != 0)
+        return false;
+
+    // O dmpInitialize() leva o giroscópio a ±2000 °/s: a conversão segue a faixa lida do sensor.
+    m_gyroScale = (1 << m_mpu.getFullScaleGyroRange()) / 131.0f;
+
+    m_mpu.setDMPEnabled(true);
+    m_dmpStatus = true;
+    m_packetSize = m_mpu.dmpGetFIFOPacketSize();
+
+    return IMUSensor::begin(wire);
+}
+
+IMUOffsets_t MPU6050MagIMU::calibrate()
+{
+    MPU6050_CalibrationResult result;
+
+    if(!m_mpu.CalibrateFast(result))
+    {
+        m_mpu.CalibrateAccel(6);
+        m_mpu.CalibrateGyro(6);
+    }
+
+    IMUOffsets_t newOffsets = getCurrentOffsets();
+    m_storedOffsets = OffsetStore.save(IMU_MODEL_MPU6050_MAG, newOffsets);
+
+    return newOffsets;
+}
+
+void MPU6050MagIMU::updateData()
+{
+    if(!m_dmpStatus)
+        return;
+
+    IMUAxisData_t data;
+
+#ifdef IMU_BENCHMARK
+    Benchmark.readSample(data);
+    registerSample();
+#else
+    uint32_t stageStart = Profiler.start();
+
+    uint16_t fifoCount = m_mpu.getFIFOCount();
+    if(fifoCount > 1023)
+    {
+        m_mpu.resetFIFO();
+        m_fifoOverflows++;
+        return;
+    }
+
+    uint32_t waitStart = millis();
+    while(fifoCount < m_packetSize && millis() - waitStart <= MPU6050_FIFO_WAIT_TIMEOUT)
+        fifoCount = m_mpu.getFIFOCount();
+
+    if(fifoCount < m_packetSize)
+        return;
+
+    stageStart = Profiler.record(STAGE_FIFO_WAIT, stageStart);
+
+    if(m_mpu.GetCurrentFIFOPacket(m_fifoBuffer, m_packetSize) != 1)
+        return;
+
+    registerSample();
+    stageStart = Profiler.record(STAGE_FIFO_READ, stageStart);
+
+    // Quaternion e campo magnético vêm do mesmo pacote: o rumo fica alinhado no tempo
+    // com a orientação, sem nenhuma leitura extra do magnetômetro.
+    Quaternion quaternion;
+    VectorFloat gravity;
+    float ypr[3];
+    int16_t mag[3];
+    m_mpu.dmpGetQuaternion(&quaternion, m_fifoBuffer);
+    m_mpu.dmpGetGravity(&gravity, &quaternion);
+    m_mpu.dmpGetYawPitchRoll(ypr, &quaternion, &gravity);
+    m_mpu.dmpGetMag(mag, m_fifoBuffer);
+
+    data.Yaw = ypr[0] * g_magDegreeRad;
+    data.Pitch = ypr[1] * g_magDegreeRad;
+    data.Roll = ypr[2] * g_magDegreeRad;
+    data.Heading = computeHeading(mag, gravity);
+    // O rumo já precisa dos ângulos a cada amostra: a gravidade em Q30 (usada no
+    // tombamento) sai da mesma conta em float.
+    data.Gravity_X = gravity.x * IMU_GRAVITY_ONE;
+    data.Gravity_Y = gravity.y * IMU_GRAVITY_ONE;
+    data.Gravity_Z = gravity.z * IMU_GRAVITY_ONE;
+
+    stageStart = Profiler.record(STAGE_DMP_MATH, stageStart);
+
+    // Acelerômetro e giroscópio do pacote estão na escala do DMP: uma leitura em rajada
+    // dos registradores brutos.
+    int16_t accel[3], gyro[3];
+    m_mpu.getMotion6(&accel[0], &accel[1], &accel[2], &gyro[0], &gyro[1], &gyro[2]);
+    data.Acc_X = (double) accel[0]/16384;
+    data.Acc_Y = (double) accel[1]/16384;
+    data.Acc_Z = (double) accel[2]/16384;
+    data.Gyro_X = gyro[0] * m_gyroScale;
+    data.Gyro_Y = gyro[1] * m_gyroScale;
+    data.Gyro_Z = gyro[2] * m_gyroScale;
+    data.Temperature = ((double)m_mpu.getTemperature()/340) + 36.53;
+    data.Time = millis();
+
+    Profiler.record(STAGE_RAW_READ, stageStart);
+#endif
+
+    notifySample(data);
+
+    if(millis() - m_timeLastRead > (unsigned long)m_readFrequency)
+    {
+        m_timeLastRead = millis();
+        refreshSettings();
+
+        uint32_t stageStart = Profiler.start();
+        addMeasurement(data);
+        stageStart = Profiler.record(STAGE_ADD_MEASUREMENT, stageStart);
+
+        detectTipping();
+        stageStart = Profiler.record(STAGE_DETECT_TIPPING, stageStart);
+
+        detectTamper();
+        stageStart = Profiler.record(STAGE_DETECT_TAMPER, stageStart);
+
+        if(m_moving)
+        {
+            detectStop();
+            stageStart = Profiler.record(STAGE_DETECT_STOP, stageStart);
+        }
+        else
+        {
+            detectMovement();
+            stageStart = Profiler.record(STAGE_DETECT_MOVEMENT, stageStart);
+        }
+
+        updateState();
+        Profiler.record(STAGE_UPDATE_STATE, stageStart);
+
+#ifdef IMU_BENCHMARK
+        Benchmark.stateUpdated();
+#endif
+    }
+
+#ifdef IMU_BENCHMARK
+    Benchmark.sampleProcessed();
+#endif
+}
+
+float MPU6050MagIMU::computeHeading(const int16_t *mag, const VectorFloat &gravity)
+{
+    // Eixos do AK8975 no referencial do acelerômetro (montagem do MPU-9150): X e Y
+    // trocados e Z invertido.
+    float field[3] = {(float)(mag[1] - m_magBias[1]), (float)(mag[0] - m_magBias[0]),
+                      (float)-(mag[2] - m_magBias[2])};
+
+    // A gravidade do DMP aponta para cima com o sensor nivelado.
+    float down[3] = {-gravity.x, -gravity.y, -gravity.z};
+
+    // Leste = baixo x campo; norte = leste x baixo. O rumo é o ângulo do eixo X
+    // do sensor medido do norte para o leste.
+    float east[3] = {down[1] * field[2] - down[2] * field[1], down[2] * field[0] - down[0] * field[2],
+                     down[0] * field[1] - down[1] * field[0]};
+    float northX = east[1] * down[2] - east[2] * down[1];
+
+    if(east[0] == 0 && northX == 0)
+        return NAN;
+
+    float heading = atan2f(east[0], northX) * g_magDegreeRad + m_declination;
+    if(heading < 0)
+        heading += 360;
+    else if(heading >= 360)
+        heading -= 360;
+
+    return heading;
+}
+
+void MPU6050MagIMU::start(int frequency)
+{
+#ifdef IMU_BENCHMARK
+    bool connected = true;
+#else
+    bool connected = m_mpu.testConnection();
+#endif
+
+    if(!m_threadRunning && m_dmpStatus && connected && m_semaphoreInitialized && checkConfigurations())
+    {
+        m_readFrequency = frequency;
+        xTaskCreate(wrapper, "[MPU6050Mag]readTask", MPU6050_MAG_READ_TASK_STACK, this, 1, &m_readTaskHandle);
+
+#ifdef IMU_BENCHMARK
+        Benchmark.setTask(m_readTaskHandle, MPU6050_MAG_READ_TASK_STACK);
+#endif
+
+        lock();
+        m_threadRunning = true;
+        unlock();
+    }
+}
+
+void MPU6050MagIMU::stop()
+{
+    if(m_threadRunning && m_readTaskHandle != NULL && m_semaphoreInitialized)
+    {
+        lock();
+        m_threadRunning = false;
+        unlock();
+
+        resetMeasurements();
+
+        vTaskDelete(m_readTaskHandle);
+        m_readTaskHandle = NULL;
+    }
+}
+
+void MPU6050MagIMU::getHealth(IMUHealth_t &health)
+{
+    IMUSensor::getHealth(health);
+
+    health.FifoOverflows = m_fifoOverflows;
+    health.FifoResets = m_mpu.getFIFOResetCount();
+    health.FifoTimeouts = m_mpu.getFIFOTimeoutCount();
+    health.TrashBytes = m_mpu.getFIFOTrashCount();
+    health.I2CReadFailures = I2Cdev::readFailures;
+    health.I2CReadTimeouts = I2Cdev::readTimeouts;
+    health.I2CWriteFailures = I2Cdev::writeFailures;
+    health.I2CShadowHits = I2Cdev::shadowHits;
+    health.StackSize = MPU6050_MAG_READ_TASK_STACK;
+
+    if(m_readTaskHandle != NULL)
+        health.StackHighWaterMark = uxTaskGetStackHighWaterMark(m_readTaskHandle);
+
+    health.DmpInitTime = m_dmpInitTime;
+}
+
+void MPU6050MagIMU::setMagBias(const int16_t *bias)
+{
+    lock();
+    for(int i = 0; i < 3; i++)
+        m_magBias[i] = bias[i];
+    unlock();
+}
+
+void MPU6050MagIMU::setDeclination(float declination)
+{
+    lock();
+    m_declination = declination;
+    unlock();
+}
+
+void MPU6050MagIMU::wrapper(void *parameter)
+{
+    for(;;)
+        static_cast<MPU6050MagIMU*>(parameter)->updateData();
+}
+
+IMUOffsets_t MPU6050MagIMU::getCurrentOffsets()
+{
+    IMUOffsets_t currentOffsets;
+
+    currentOffsets.XAccelOffset = m_mpu.getXAccelOffset();
+    currentOffsets.YAccelOffset = m_mpu.getYAccelOffset();
+    currentOffsets.ZAccelOffset = m_mpu.getZAccelOffset();
+    currentOffsets.XGyroOffset = m_mpu.getXGyroOffset();
+    currentOffsets.YGyroOffset = m_mpu.getYGyroOffset();
+    currentOffsets.ZGyroOffset = m_mpu.getZGyroOffset();
+
+    return currentOffsets;
+}
+
+void MPU6050MagIMU::setOffsets(IMUOffsets_t newOffsets)
+{
+    m_mpu.setXAccelOffset(newOffsets.XAccelOffset);
+    m_mpu.setYAccelOffset(newOffsets.YAccelOffset);
+    m_mpu.setZAccelOffset(newOffsets.ZAccelOffset);
+    m_mpu.setXGyroOffset(newOffsets.XGyroOffset);
+    m_mpu.setYGyroOffset(newOffsets.YGyroOffset);
+    m_mpu.setZGyroOffset(newOffsets.ZGyroOffset);
+}
+
+bool MPU6050MagIMU::hasStoredOffsets()
+{
+    return m_storedOffsets;
+}
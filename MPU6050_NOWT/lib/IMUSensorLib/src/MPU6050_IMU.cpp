@@ -9,22 +9,69 @@
  * 
  */
 #include "MPU6050_IMU.h"
+#include "IMULogger.h"
+#include "I2CdevAsync.h"
 
-uint16_t g_fifoPacketSize;          // Tamanho esperado do pacote do DMP (Padrão: 42 bytes)
+uint16_t g_fifoPacketSize;          // Tamanho esperado do pacote do DMP (42 bytes no MotionApps 2.0, 28 no 6.12)
 uint16_t g_fifoCount;               // Quantos bytes o FIFO possui atualmente.
 uint8_t g_fifoBuffer[64];           // Buffer para armezamento do FIFO.
-VectorFloat g_gravity;              // [x, y, z]    Vetor para informações da gravidade.
-Quaternion g_quart;                 // [w, x, y, z] Vetor para informações de quaternion.
+VectorInt32 g_gravity;              // [x, y, z]    Direção da gravidade em Q30.
+QuaternionQ30 g_quart;              // [w, x, y, z] Quaternion do DMP em Q30.
 const float g_degreeRad = 180/M_PI; // Termo de conversão de radianos para graus.
 float g_YPR[3];                     // Buffer de leitura do Yaw, Pitch e Roll
 unsigned long g_timeLastRead = 0;   // Millis() em que foi feito último registro de leitura no histórico.
 
+/**
+ * @brief Soma dos contadores de erro do I2Cdev. Comparada antes e depois de uma
+ * amostra, indica falha no barramento sem nenhuma transação extra.
+ * @return uint32_t - Leituras e escritas com falha até agora.
+ */
+static uint32_t busErrorCount()
+{
+    return I2Cdev::readFailures + I2Cdev::readTimeouts + I2Cdev::writeFailures;
+}
+
 TaskHandle_t g_readTaskHandle = NULL; // Handle da task de leitura.
 
 MPU6050IMU::MPU6050IMU()
 {
     m_deviceStatus = 0;
     m_dmpStatus = false;
+    m_fifoOverflows = 0;
+    m_dmpInitTime = 0;
+    m_warmStart = false;
+    m_storedOffsets = false;
+    m_gyroBiasTracking = true;
+    m_lastModelUpdate = 0;
+    m_lastModelSave = 0;
+    m_gyroModelPending = false;
+    m_wire = NULL;
+    m_failedSamples = 0;
+    m_recovering = false;
+    m_outageStart = 0;
+    m_lastRecoveryAttempt = 0;
+    m_recoveryAttempts = 0;
+    m_recoveries = 0;
+    m_lastOutage = 0;
+    m_totalOutage = 0;
+    m_rawRequest = 0;
+    m_rawRate = 0;
+    m_rawCallback = NULL;
+    m_rawBatch = IMURawBatch_t();
+    m_rawBatch.Samples = m_rawBuffer;
+    m_dmpRate = 0;
+    m_dmpDLPFMode = 0;
+    m_rawData = IMURawCaptureData_t();
+    m_gyroScale = 1 / 131.0f;
+#ifdef IMU_SOFTWARE_FUSION
+    m_fusionStarted = false;
+    m_fusionPeriod = 1.0f / MPU6050_FUSION_RATE;
+    m_gyroRadScale = 0;
+    m_fusionAlgorithm = m_fusion.getAlgorithm();
+    m_fusionGains = m_fusion.getGains();
+    m_fusionChanged = false;
+#endif
+    m_sampleCallback = NULL;
     m_moving = false;
     m_tipped = false;
     m_tamper = false;
@@ -36,27 +83,96 @@ bool MPU6050IMU::begin(TwoWire &wire)
 {
     IMUOffsets_t offsets = IMUOffsets_t(534, 439, 1134, -33, -70, -44);
 
+    // Offsets salvos pela última calibração deste sensor têm prioridade sobre os padrão.
+    m_storedOffsets = OffsetStore.load(IMU_MODEL_MPU6050, offsets);
+    OffsetStore.loadGyroModel(IMU_MODEL_MPU6050, m_gyroModel);
+
     return begin(wire, offsets);
 }
 
 bool MPU6050IMU::begin(TwoWire &wire, IMUOffsets_t offsets)
 {
+    m_wire = &wire;
+
+#ifdef IMU_BENCHMARK
+    // No benchmark o sensor é simulado, então o barramento não é utilizado.
+    m_dmpStatus = true;
+    return IMUSensor::begin(wire);
+#endif
+
+#if I2CDEV_IMPLEMENTATION == I2CDEV_ESP32_ASYNC
+    // Backend assíncrono: o driver do ESP-IDF ocupa a porta no lugar do Wire.
+    if(!I2CdevAsync.begin(I2C_NUM_0, MPU6050_PIN_SDA, MPU6050_PIN_SCL, MPU6050_FREQUENCY))
+        return false;
+#else
     wire.begin(MPU6050_PIN_SDA, MPU6050_PIN_SCL, MPU6050_FREQUENCY);
-    m_mpu.initialize();
+#endif
 
     if(!m_mpu.testConnection())
         return false;
 
-    m_deviceStatus = m_mpu.dmpInitialize();
+    // Registradores de configuração espelhados em RAM: setters de bits sem a leitura prévia
+    // e getters de configuração sem acesso ao barramento.
+    m_mpu.setShadowRegistersEnabled(true);
+
+    // Contadores de uso do barramento por faixa de registradores (as faixas mais estreitas
+    // primeiro, pois a primeira que contém o registrador é a utilizada).
+    if(I2Cdev::getStatsRangeCount() == 1)
+    {
+        I2Cdev::addStatsRange(MPU6050_DEFAULT_ADDRESS, MPU6050_RA_FIFO_COUNTH, MPU6050_RA_FIFO_R_W, "fifo");
+        I2Cdev::addStatsRange(MPU6050_DEFAULT_ADDRESS, MPU6050_RA_BANK_SEL, MPU6050_RA_MEM_R_W, "dmp mem");
+        I2Cdev::addStatsRange(MPU6050_DEFAULT_ADDRESS, MPU6050_RA_ACCEL_XOUT_H, MPU6050_RA_EXT_SENS_DATA_23, "dados");
+        I2Cdev::addStatsRange(MPU6050_DEFAULT_ADDRESS, 0x00, 0xFF, "config");
+    }
+    I2Cdev::setStatsEnabled(true);
+
+#ifdef IMU_SOFTWARE_FUSION
+    // Fusão por software: nenhum firmware é carregado, o FIFO recebe os quadros brutos.
+    // O initialize() deixa o giroscópio em ±250 °/s (o DMP usa ±2000 °/s); a escala do
+    // giroscópio é lida do sensor após a inicialização, nunca assumida.
+    uint32_t initStart = micros();
+    m_mpu.initialize();
+    m_fusionPeriod = 1 / configureFifo(MPU6050_FUSION_RATE);
+    m_deviceStatus = 0;
+    m_dmpInitTime = micros() - initStart;
+    Logger.printf("\n[MPU6050IMU] Fusao por software (%s) a %.0f Hz, sem o DMP, iniciada em %u us.",
+                  (m_fusion.getAlgorithm() == IMU_FUSION_MAHONY) ? "Mahony" : "Madgwick", 1 / m_fusionPeriod, m_dmpInitTime);
+#else
+    // Após ESP.restart() ou watchdog o sensor continua alimentado: se o DMP e a configuração
+    // ainda estiverem lá, basta rearmar o FIFO em vez de reiniciar o chip e recarregar o firmware.
+    uint32_t initStart = micros();
+    m_warmStart = (m_mpu.dmpWarmStart() == 0);
+    if(m_warmStart)
+        m_deviceStatus = 0;
+    else
+    {
+        m_mpu.initialize();
+        m_deviceStatus = m_mpu.dmpInitialize();
+    }
+    m_dmpInitTime = micros() - initStart;
+    Logger.printf("\n[MPU6050IMU] DMP (%s) %s em %u us (status %u).", MPU6050_DMP_FIRMWARE,
+                  m_warmStart ? "reaproveitado" : "inicializado", m_dmpInitTime, m_deviceStatus);
+#endif
 
     setOffsets(offsets);
 
     if(m_deviceStatus != 0)
         return false;
 
+    // Conversão das leituras e limites do estimador de bias seguem a faixa configurada
+    // do giroscópio (±2000 °/s com o DMP, ±250 °/s na fusão por software).
+    uint8_t gyroRange = m_mpu.getFullScaleGyroRange();
+    m_gyroScale = (1 << gyroRange) / 131.0f;
+    m_gyroBias.setRange(gyroRange);
+#ifdef IMU_SOFTWARE_FUSION
+    m_gyroRadScale = m_gyroScale / g_degreeRad;
+#endif
+
+#ifndef IMU_SOFTWARE_FUSION
     m_mpu.setDMPEnabled(true);
-    m_dmpStatus = true;
     g_fifoPacketSize = m_mpu.dmpGetFIFOPacketSize();
+#endif
+    m_dmpStatus = true;
 
     if(!IMUSensor::begin(wire))
         return false;
@@ -66,8 +182,21 @@ bool MPU6050IMU::begin(TwoWire &wire, IMUOffsets_t offsets)
 
 IMUOffsets_t MPU6050IMU::calibrate()
 {
-    m_mpu.CalibrateAccel(10);
-    m_mpu.CalibrateGyro(10);
+    MPU6050_CalibrationResult result;
+
+    // Seis eixos juntos, parando assim que convergem; a rotina antiga fica como reserva.
+    if(m_mpu.CalibrateFast(result))
+    {
+        Logger.printf("\n[MPU6050IMU] Calibracao concluida em %u iteracoes (residuo acel %.1f, giro %.1f LSB).",
+                      result.iterations, result.accelResidual, result.gyroResidual);
+    }
+    else
+    {
+        Logger.printf("\n[MPU6050IMU] Calibracao rapida nao convergiu em %u iteracoes (residuo acel %.1f, giro %.1f LSB).",
+                      result.iterations, result.accelResidual, result.gyroResidual);
+        m_mpu.CalibrateAccel(6);
+        m_mpu.CalibrateGyro(6);
+    }
 
     IMUOffsets_t newOffsets = IMUOffsets_t();
 
@@ -78,6 +207,9 @@ IMUOffsets_t MPU6050IMU::calibrate()
     newOffsets.YGyroOffset = m_mpu.getYGyroOffset();
     newOffsets.ZGyroOffset = m_mpu.getZGyroOffset();
 
+    m_offsets = newOffsets;
+    m_storedOffsets = OffsetStore.save(IMU_MODEL_MPU6050, newOffsets);
+
     return newOffsets;
 }
 
@@ -85,64 +217,190 @@ void MPU6050IMU::updateData()
 {
     if(!m_dmpStatus)
         return;
-    
+
+    IMUAxisData_t data;
+
+#ifdef IMU_BENCHMARK
+    Benchmark.readSample(data);
+    registerSample();
+#else
+    // Nenhuma verificação de conexão por amostra: os contadores de erro do I2Cdev (em RAM)
+    // indicam se alguma transação da amostra falhou.
+    if(m_recovering)
+    {
+        if(!recoverSensor())
+            vTaskDelay(pdMS_TO_TICKS(MPU6050_RECOVERY_INTERVAL));
+        return;
+    }
+
+    if(m_rawRequest != m_rawRate)
+        switchAcquisition();
+
+    if(m_rawRate != 0)
+    {
+        updateRawData();
+        return;
+    }
+
+#ifdef IMU_SOFTWARE_FUSION
+    int16_t gyro[3];
+    if(!updateFusion(data, gyro))
+        return;
+#else
+    uint32_t busErrors = busErrorCount();
+    uint32_t stageStart = Profiler.start();
+
     g_fifoCount = m_mpu.getFIFOCount();
 
-    if(g_fifoCount > 1023)
+    if(busErrorCount() == busErrors && g_fifoCount > 1023)
+    {
         m_mpu.resetFIFO();
-    else
+        m_fifoOverflows++;
+        return;
+    }
+
+    // Espera limitada: um sensor que reiniciou (sem DMP) nunca enche o FIFO.
+    uint32_t waitStart = millis();
+    while (g_fifoCount < g_fifoPacketSize && busErrorCount() == busErrors && millis() - waitStart <= MPU6050_FIFO_WAIT_TIMEOUT) 
+        g_fifoCount = m_mpu.getFIFOCount();
+
+    if(g_fifoCount < g_fifoPacketSize || busErrorCount() != busErrors)
+    {
+        sampleFailed();
+        return;
+    }
+
+    stageStart = Profiler.record(STAGE_FIFO_WAIT, stageStart);
+
+    g_fifoCount -= g_fifoPacketSize;
+    if(!m_mpu.dmpGetCurrentFIFOPacket(g_fifoBuffer))
+    {
+        if(busErrorCount() != busErrors)
+            sampleFailed();
+        return;
+    }
+
+    registerSample();
+    stageStart = Profiler.record(STAGE_FIFO_READ, stageStart);
+
+    // Quaternion em Q30 direto do pacote: a gravidade sai só de multiplicações inteiras
+    // e os ângulos ficam para updateAngles().
+    int32_t quaternion[4];
+    m_mpu.dmpGetQuaternion(quaternion, g_fifoBuffer);
+    g_quart = QuaternionQ30(quaternion);
+    g_gravity = g_quart.getGravity();
+
+    data.Gravity_X = g_gravity.x;
+    data.Gravity_Y = g_gravity.y;
+    data.Gravity_Z = g_gravity.z;
+
+    stageStart = Profiler.record(STAGE_DMP_MATH, stageStart);
+
+#ifdef IMU_DMP_MOTIONAPPS612
+    // O pacote do 6.12 já traz acelerômetro e giroscópio brutos (mesma escala dos registradores):
+    // fora do FIFO só a temperatura é lida.
+    int16_t accel[3], gyro[3];
+    m_mpu.dmpGetAccel(accel, g_fifoBuffer);
+    m_mpu.dmpGetGyro(gyro, g_fifoBuffer);
+#else
+    // No pacote do 2.0 acelerômetro e giroscópio estão na escala do DMP: as leituras brutas
+    // continuam vindo dos registradores.
+    int16_t accel[3] = {m_mpu.getAccelerationX(), m_mpu.getAccelerationY(), m_mpu.getAccelerationZ()};
+    int16_t gyro[3] = {m_mpu.getRotationX(), m_mpu.getRotationY(), m_mpu.getRotationZ()};
+#endif
+    data.Acc_X = (double) accel[0]/16384;
+    data.Acc_Y = (double) accel[1]/16384;
+    data.Acc_Z = (double) accel[2]/16384;
+    data.Gyro_X = gyro[0] * m_gyroScale;
+    data.Gyro_Y = gyro[1] * m_gyroScale;
+    data.Gyro_Z = gyro[2] * m_gyroScale;
+    data.Temperature = ((double)m_mpu.getTemperature()/340) + 36.53;
+    data.Time = millis();
+
+    // Leituras brutas com erro não viram amostra.
+    if(busErrorCount() != busErrors)
     {
-        while (g_fifoCount < g_fifoPacketSize) 
-            g_fifoCount = m_mpu.getFIFOCount();
+        sampleFailed();
+        return;
+    }
+    m_failedSamples = 0;
+
+    Profiler.record(STAGE_RAW_READ, stageStart);
+#endif
+
+    trackGyroBias(gyro, data.Temperature);
+#endif
+
+    // O callback é lido uma vez: os ângulos são calculados só se a amostra
+    // for entregue a ele ou entrar no histórico.
+    IMUSampleCallback_t callback = m_sampleCallback;
+    bool record = abs(millis() - g_timeLastRead) > m_readFrequency;
 
-        g_fifoCount -= g_fifoPacketSize;
-        m_mpu.dmpGetCurrentFIFOPacket(g_fifoBuffer);
+    if(callback != NULL || record)
+        updateAngles(data);
 
-        m_mpu.dmpGetQuaternion(&g_quart, g_fifoBuffer);
-        m_mpu.dmpGetGravity(&g_gravity, &g_quart);
-        m_mpu.dmpGetYawPitchRoll(g_YPR, &g_quart, &g_gravity);
+    if(callback != NULL)
+        callback(data, m_devState);
+
+    if(record)
+    {
+        g_timeLastRead = millis();
+        refreshSettings();
+
+        uint32_t stageStart = Profiler.start();
+        addMeasurement(data);
+        stageStart = Profiler.record(STAGE_ADD_MEASUREMENT, stageStart);
+
+        detectTipping();
+        stageStart = Profiler.record(STAGE_DETECT_TIPPING, stageStart);
+
+        detectTamper();
+        stageStart = Profiler.record(STAGE_DETECT_TAMPER, stageStart);
         
-        IMUAxisData_t data;
-        data.Yaw  = g_YPR[0] * g_degreeRad;
-        data.Pitch = g_YPR[1] * g_degreeRad;
-        data.Roll = g_YPR[2] * g_degreeRad;
-        data.Acc_X = (double) m_mpu.getAccelerationX()/16384;
-        data.Acc_Y = (double) m_mpu.getAccelerationY()/16384;
-        data.Acc_Z = (double) m_mpu.getAccelerationZ()/16384;
-        data.Gyro_X = (double) m_mpu.getRotationX()/131;
-        data.Gyro_Y = (double) m_mpu.getRotationY()/131;
-        data.Gyro_Z = (double) m_mpu.getRotationZ()/131;
-        data.Temperature = ((double)m_mpu.getTemperature()/340) + 36.53;
-        data.Time = millis();
-
-        if(abs(millis() - g_timeLastRead) > m_readFrequency)
+        if(m_moving)
         {
-            g_timeLastRead = millis();
-            addMeasurement(data);
-
-            detectTipping();
-            detectTamper();
-            
-            if(m_moving)
-                detectStop();
-            else
-                detectMovement();
-
-            updateState();
+            detectStop();
+            stageStart = Profiler.record(STAGE_DETECT_STOP, stageStart);
         }
+        else
+        {
+            detectMovement();
+            stageStart = Profiler.record(STAGE_DETECT_MOVEMENT, stageStart);
+        }
+
+        updateState();
+        Profiler.record(STAGE_UPDATE_STATE, stageStart);
+
+#ifdef IMU_BENCHMARK
+        Benchmark.stateUpdated();
+#endif
     }
+
+#ifdef IMU_BENCHMARK
+    Benchmark.sampleProcessed();
+#endif
 }
 
 void MPU6050IMU::start(int frequency)
 {
-    if(!m_threadRunning && m_dmpStatus && m_mpu.testConnection() && m_semaphoreInitialized && checkConfigurations())
+#ifdef IMU_BENCHMARK
+    bool connected = true;
+#else
+    bool connected = m_mpu.testConnection();
+#endif
+
+    if(!m_threadRunning && m_dmpStatus && connected && m_semaphoreInitialized && checkConfigurations())
     {
         m_readFrequency = frequency;
-        xTaskCreate(wrapper, "[MPU6050]readTask", 10000, this, 1, &g_readTaskHandle);
+        xTaskCreate(wrapper, "[MPU6050]readTask", MPU6050_READ_TASK_STACK, this, 1, &g_readTaskHandle);
+
+#ifdef IMU_BENCHMARK
+        Benchmark.setTask(g_readTaskHandle, MPU6050_READ_TASK_STACK);
+#endif
 
-        xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+        lock();
         m_threadRunning = true;
-        xSemaphoreGive(m_imuSemaphore);
+        unlock();
     }
 }
 
@@ -150,9 +408,9 @@ void MPU6050IMU::stop()
 {
     if(m_threadRunning && g_readTaskHandle != NULL && m_semaphoreInitialized)
     {
-        xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+        lock();
         m_threadRunning = false;
-        xSemaphoreGive(m_imuSemaphore);
+        unlock();
 
         resetMeasurements();
 
@@ -161,6 +419,619 @@ void MPU6050IMU::stop()
     }
 }
 
+void MPU6050IMU::getHealth(IMUHealth_t &health)
+{
+    IMUSensor::getHealth(health);
+
+    health.FifoOverflows = m_fifoOverflows;
+    health.FifoResets = m_mpu.getFIFOResetCount();
+    health.FifoTimeouts = m_mpu.getFIFOTimeoutCount();
+    health.TrashBytes = m_mpu.getFIFOTrashCount();
+    health.I2CReadFailures = I2Cdev::readFailures;
+    health.I2CReadTimeouts = I2Cdev::readTimeouts;
+    health.I2CWriteFailures = I2Cdev::writeFailures;
+    health.I2CShadowHits = I2Cdev::shadowHits;
+    health.SensorRecoveries = m_recoveries;
+    health.LastOutage = m_lastOutage;
+    health.TotalOutage = m_totalOutage;
+    health.StackSize = MPU6050_READ_TASK_STACK;
+
+    if(g_readTaskHandle != NULL)
+        health.StackHighWaterMark = uxTaskGetStackHighWaterMark(g_readTaskHandle);
+
+    health.DmpInitTime = m_dmpInitTime;
+    health.DmpWarmStart = m_warmStart;
+
+    IMUGyroBiasData_t gyroBias = m_gyroBias.getData();
+    health.GyroBiasWindows = gyroBias.Windows;
+    health.GyroBiasCorrections = gyroBias.Corrections;
+    health.GyroModelCorrections = gyroBias.ModelCorrections;
+    health.GyroModelNodes = m_gyroModel.getNodeCount();
+}
+
+void MPU6050IMU::setGyroBiasTracking(bool enable)
+{
+    lock();
+    m_gyroBiasTracking = enable;
+    unlock();
+}
+
+void MPU6050IMU::getGyroBiasData(IMUGyroBiasData_t &data)
+{
+    data = m_gyroBias.getData();
+}
+
+void MPU6050IMU::getGyroModel(GyroTemperatureModel &model)
+{
+    model = m_gyroModel;
+}
+
+void MPU6050IMU::saveGyroModel()
+{
+    if(!__atomic_load_n(&m_gyroModelPending, __ATOMIC_ACQUIRE))
+        return;
+
+    // Uma falha perde só esta cópia: a próxima janela aceita marca o modelo para nova gravação.
+    if(!OffsetStore.saveGyroModel(IMU_MODEL_MPU6050, m_gyroModelSnapshot))
+        Logger.printf("\n[MPU6050IMU] Falha ao gravar o modelo de temperatura do giroscopio.");
+
+    __atomic_store_n(&m_gyroModelPending, false, __ATOMIC_RELEASE);
+}
+
+void MPU6050IMU::trackGyroBias(const int16_t *gyro, float temperature)
+{
+    if(!m_gyroBiasTracking)
+        return;
+
+    uint32_t now = millis();
+    int16_t step[3];
+
+    // Fora da parada a janela em andamento é descartada e o modelo de temperatura assume.
+    if(m_moving || m_devState != DeviceState_e::STATE_STOPPED)
+    {
+        m_gyroBias.reset();
+
+        float target[3];
+        if(now - m_lastModelUpdate < GYRO_MODEL_UPDATE_INTERVAL || !m_gyroModel.predict(temperature, target))
+            return;
+        m_lastModelUpdate = now;
+
+        const int16_t current[3] = {m_mpu.getXGyroOffset(), m_mpu.getYGyroOffset(), m_mpu.getZGyroOffset()};
+        bool adjust = false;
+        for(int i = 0; i < 3; i++)
+        {
+            step[i] = (int16_t)constrain(lroundf(target[i] - current[i]), -GYRO_BIAS_MAX_STEP, GYRO_BIAS_MAX_STEP);
+            adjust = adjust || step[i] != 0;
+        }
+
+        if(adjust)
+        {
+            adjustGyroOffsets(step);
+            m_gyroBias.countModelCorrection();
+        }
+        return;
+    }
+
+    bool correct = m_gyroBias.addSample(gyro, temperature, now, step);
+
+    if(m_gyroBias.takeWindow())
+    {
+        // Offset ideal = offset atual menos o bias residual da janela, convertido da faixa
+        // em uso para a escala do offset (bias * 2 em ±2000 °/s).
+        IMUGyroBiasData_t data = m_gyroBias.getData();
+        const int16_t current[3] = {m_mpu.getXGyroOffset(), m_mpu.getYGyroOffset(), m_mpu.getZGyroOffset()};
+        float ideal[3];
+        for(int i = 0; i < 3; i++)
+            ideal[i] = current[i] - data.Bias[i] / m_gyroBias.getOffsetScale();
+
+        m_gyroModel.learn(data.Temperature, ideal);
+
+        // A gravação só acontece parado e com intervalo mínimo, poupando a flash. A escrita
+        // na NVS fica para o loop (saveGyroModel()): aqui só a cópia é entregue.
+        if(!__atomic_load_n(&m_gyroModelPending, __ATOMIC_ACQUIRE) && m_gyroModel.isDirty() &&
+           (m_lastModelSave == 0 || now - m_lastModelSave > GYRO_MODEL_SAVE_INTERVAL))
+        {
+            m_gyroModelSnapshot = m_gyroModel;
+            m_gyroModel.setSaved();
+            m_lastModelSave = now;
+            __atomic_store_n(&m_gyroModelPending, true, __ATOMIC_RELEASE);
+        }
+    }
+
+    if(correct)
+        adjustGyroOffsets(step);
+}
+
+void MPU6050IMU::adjustGyroOffsets(const int16_t *step)
+{
+    m_offsets.XGyroOffset += step[0];
+    m_offsets.YGyroOffset += step[1];
+    m_offsets.ZGyroOffset += step[2];
+
+    m_mpu.setXGyroOffset(m_offsets.XGyroOffset);
+    m_mpu.setYGyroOffset(m_offsets.YGyroOffset);
+    m_mpu.setZGyroOffset(m_offsets.ZGyroOffset);
+}
+
+void MPU6050IMU::sampleFailed()
+{
+    if(m_failedSamples == 0)
+        m_outageStart = millis();
+
+    if(++m_failedSamples < MPU6050_RECOVERY_THRESHOLD)
+        return;
+
+    m_recovering = true;
+    m_recoveryAttempts = 0;
+    Logger.printf("\n[MPU6050IMU] Sensor sem resposta, iniciando a recuperacao.");
+}
+
+bool MPU6050IMU::recoverSensor()
+{
+    if(m_recoveryAttempts > 0 && millis() - m_lastRecoveryAttempt < MPU6050_RECOVERY_INTERVAL)
+        return false;
+
+    m_lastRecoveryAttempt = millis();
+    m_recoveryAttempts++;
+
+    clearBus();
+
+    // O sensor pode ter reiniciado: a cópia dos registradores em RAM deixa de valer
+    // (e o dmpWarmStart() precisa ler o chip, não a cópia).
+    m_mpu.setShadowRegistersEnabled(false);
+    m_mpu.setShadowRegistersEnabled(true);
+
+    uint32_t busErrors = busErrorCount();
+    if(!m_mpu.testConnection())
+        return false;
+
+#ifdef IMU_SOFTWARE_FUSION
+    // Sem o DMP não há firmware a recarregar: a configuração (poucos registradores) é
+    // sempre refeita, e o filtro continua de onde estava.
+    const char *path = "configuracao refeita";
+    m_mpu.initialize();
+    setOffsets(m_offsets);
+    configureFifo(MPU6050_FUSION_RATE);
+#else
+    // Caminho mais curto: só o barramento travou, o DMP e os offsets continuam no chip e
+    // basta rearmar o FIFO. Se o sensor reiniciou (queda de tensão) o DMP é recarregado.
+    const char *path = "DMP reaproveitado";
+    if(m_mpu.dmpWarmStart() != 0)
+    {
+        path = "DMP recarregado";
+        m_mpu.initialize();
+        if(m_mpu.dmpInitialize() != 0)
+            return false;
+
+        setOffsets(m_offsets);
+    }
+
+    // Os dois caminhos deixam o DMP desligado (como em begin()).
+    m_mpu.setDMPEnabled(true);
+#endif
+
+    if(busErrorCount() != busErrors)
+        return false;
+
+    m_lastOutage = millis() - m_outageStart;
+    m_totalOutage += m_lastOutage;
+    m_recoveries++;
+    m_failedSamples = 0;
+    m_recovering = false;
+
+    // A recuperação volta a configuração de leitura normal (com o DMP o warm start sempre
+    // falha na captura, e o firmware é recarregado): a captura é reconfigurada e o próximo
+    // lote indica a lacuna.
+    if(m_rawRate != 0)
+    {
+        configureRawCapture();
+        m_rawBatch.Gap = true;
+    }
+
+    Logger.printf("\n[MPU6050IMU] Sensor recuperado apos %u ms (%s, %u tentativa(s)).", m_lastOutage, 
+                  path, m_recoveryAttempts);
+    return true;
+}
+
+void MPU6050IMU::clearBus()
+{
+#if I2CDEV_IMPLEMENTATION == I2CDEV_ESP32_ASYNC
+    // O driver do ESP-IDF reinicia o periférico sozinho após um tempo limite e é dono dos pinos.
+#else
+    if(m_wire == NULL)
+        return;
+
+    m_wire->end();
+
+    // Um escravo interrompido no meio de um byte segura o SDA em nível baixo até receber
+    // os clocks que faltam: no máximo 8 bits e o ACK.
+    pinMode(MPU6050_PIN_SDA, INPUT_PULLUP);
+    pinMode(MPU6050_PIN_SCL, OUTPUT_OPEN_DRAIN);
+    digitalWrite(MPU6050_PIN_SCL, HIGH);
+    for(uint8_t i = 0; i < 9 && digitalRead(MPU6050_PIN_SDA) == LOW; i++)
+    {
+        digitalWrite(MPU6050_PIN_SCL, LOW);
+        delayMicroseconds(5);
+        digitalWrite(MPU6050_PIN_SCL, HIGH);
+        delayMicroseconds(5);
+    }
+
+    // STOP: SDA sobe com o SCL em nível alto.
+    pinMode(MPU6050_PIN_SDA, OUTPUT_OPEN_DRAIN);
+    digitalWrite(MPU6050_PIN_SDA, LOW);
+    delayMicroseconds(5);
+    digitalWrite(MPU6050_PIN_SDA, HIGH);
+    delayMicroseconds(5);
+
+    m_wire->begin(MPU6050_PIN_SDA, MPU6050_PIN_SCL, MPU6050_FREQUENCY);
+#endif
+}
+
+bool MPU6050IMU::startRawCapture(uint16_t rate, IMURawBatchCallback_t callback)
+{
+#ifdef IMU_BENCHMARK
+    // O benchmark reproduz pacotes do DMP, não quadros brutos.
+    return false;
+#endif
+
+    if(!m_threadRunning || callback == NULL || rate < IMU_RAW_MIN_RATE || rate > IMU_RAW_MAX_RATE)
+        return false;
+
+    lock();
+    m_rawCallback = callback;
+    m_rawRequest = rate;
+    unlock();
+
+    return true;
+}
+
+void MPU6050IMU::stopRawCapture()
+{
+    lock();
+    m_rawRequest = 0;
+    unlock();
+}
+
+void MPU6050IMU::getRawCaptureData(IMURawCaptureData_t &data)
+{
+    data = m_rawData;
+    data.Active = (m_rawRate != 0);
+}
+
+void MPU6050IMU::switchAcquisition()
+{
+    uint16_t request = m_rawRequest;
+
+    if(request == 0)
+    {
+#ifdef IMU_SOFTWARE_FUSION
+        // Os quadros da fusão são os mesmos da captura: só a taxa volta, e o filtro é
+        // realinhado com a gravidade no próximo quadro.
+        configureFifo(MPU6050_FUSION_RATE);
+        m_fusionStarted = false;
+#else
+        // Volta ao DMP: o firmware continuou na memória do sensor, basta restaurar a
+        // configuração e rearmar o FIFO (como no warm start).
+        m_mpu.setFIFOEnabled(false);
+        m_mpu.setAccelFIFOEnabled(false);
+        m_mpu.setXGyroFIFOEnabled(false);
+        m_mpu.setYGyroFIFOEnabled(false);
+        m_mpu.setZGyroFIFOEnabled(false);
+        m_mpu.setDLPFMode(m_dmpDLPFMode);
+        m_mpu.setRate(m_dmpRate);
+        m_mpu.setFIFOEnabled(true);
+        m_mpu.resetFIFO();
+        m_mpu.resetDMP();
+        m_mpu.setDMPEnabled(true);
+#endif
+
+        m_rawRate = 0;
+        m_rawBatch.Count = 0;
+        Logger.printf("\n[MPU6050IMU] Captura bruta encerrada (%u lotes, %u estouros do FIFO).",
+                      m_rawData.Batches, m_rawData.Overflows);
+        return;
+    }
+
+    if(m_rawRate == 0)
+    {
+        m_dmpRate = m_mpu.getRate();
+        m_dmpDLPFMode = m_mpu.getDLPFMode();
+    }
+
+    m_rawRate = request;
+    m_rawData = IMURawCaptureData_t();
+    m_rawBatch.Sequence = 0;
+    m_rawBatch.Gap = false;
+    configureRawCapture();
+
+    Logger.printf("\n[MPU6050IMU] Captura bruta a %.1f Hz.", m_rawBatch.SampleRate);
+}
+
+float MPU6050IMU::configureFifo(uint16_t rate)
+{
+    // Com o DLPF ligado a taxa interna é 1 kHz, dividida por (1 + divisor).
+    uint8_t divider = 1000 / rate - 1;
+    float sampleRate = 1000.0f / (divider + 1);
+
+    // Maior banda do DLPF abaixo da frequência de Nyquist, evitando o aliasing da vibração.
+    const uint16_t bandwidth[] = {188, 98, 42, 20, 10};
+    uint8_t dlpfMode = MPU6050_DLPF_BW_5;
+    for(uint8_t i = 0; i < sizeof(bandwidth) / sizeof(bandwidth[0]); i++)
+    {
+        if(bandwidth[i] < sampleRate / 2)
+        {
+            dlpfMode = MPU6050_DLPF_BW_188 + i;
+            break;
+        }
+    }
+
+    m_mpu.setDMPEnabled(false);
+    m_mpu.setFIFOEnabled(false);
+    m_mpu.setDLPFMode(dlpfMode);
+    m_mpu.setRate(divider);
+    m_mpu.setAccelFIFOEnabled(true);
+    m_mpu.setXGyroFIFOEnabled(true);
+    m_mpu.setYGyroFIFOEnabled(true);
+    m_mpu.setZGyroFIFOEnabled(true);
+    m_mpu.resetFIFO();
+    m_mpu.setFIFOEnabled(true);
+
+    return sampleRate;
+}
+
+void MPU6050IMU::configureRawCapture()
+{
+    float sampleRate = configureFifo(m_rawRate);
+
+    // Escalas em uso (lidas da cópia em RAM dos registradores).
+    m_rawBatch.SampleRate = sampleRate;
+    m_rawBatch.AccScale = 16384 >> m_mpu.getFullScaleAccelRange();
+    m_rawBatch.GyroScale = 131.0f / (1 << m_mpu.getFullScaleGyroRange());
+    m_rawBatch.Count = 0;
+    m_rawData.SampleRate = sampleRate;
+}
+
+void MPU6050IMU::updateRawData()
+{
+    const uint16_t frameSize = sizeof(IMURawSample_t);
+    uint32_t busErrors = busErrorCount();
+    uint32_t readTime = micros();
+
+    uint16_t available = m_mpu.getFIFOCount();
+    if(busErrorCount() != busErrors)
+    {
+        sampleFailed();
+        return;
+    }
+
+    // Estouro: quadros foram sobrescritos e o alinhamento se perdeu. As amostras já no
+    // lote são contínuas e seguem adiante; o próximo lote indica a lacuna.
+    if(available > 1023)
+    {
+        deliverRawBatch();
+        m_mpu.resetFIFO();
+        m_rawData.Overflows++;
+        m_rawBatch.Gap = true;
+        return;
+    }
+
+    available /= frameSize;
+    uint16_t frames = MPU6050_RAW_BATCH_SIZE - m_rawBatch.Count;
+    if(available < frames)
+        frames = available;
+
+    if(frames == 0)
+    {
+        vTaskDelay(pdMS_TO_TICKS(MPU6050_RAW_POLL_INTERVAL));
+        return;
+    }
+
+    // Rajadas direto no buffer do lote, sem cópia intermediária, em pedaços que cabem
+    // no contador de bytes do I2Cdev::readBytes().
+    uint8_t *output = (uint8_t *)&m_rawBuffer[m_rawBatch.Count];
+    for(uint16_t read = 0; read < frames; read += MPU6050_RAW_CHUNK_SIZE)
+    {
+        uint16_t chunk = frames - read;
+        if(chunk > MPU6050_RAW_CHUNK_SIZE)
+            chunk = MPU6050_RAW_CHUNK_SIZE;
+        m_mpu.getFIFOBytes(&output[read * frameSize], chunk * frameSize);
+    }
+
+    // Rajada incompleta: o FIFO pode ter ficado desalinhado.
+    if(busErrorCount() != busErrors)
+    {
+        deliverRawBatch();
+        m_mpu.resetFIFO();
+        m_rawData.FailedReads++;
+        m_rawBatch.Gap = true;
+        sampleFailed();
+        return;
+    }
+    m_failedSamples = 0;
+
+    // O FIFO entrega cada valor com o MSB primeiro.
+    int16_t *values = (int16_t *)output;
+    for(uint16_t i = 0; i < frames * frameSize / 2; i++)
+        values[i] = (int16_t)((output[2 * i] << 8) | output[2 * i + 1]);
+
+    // A amostra mais nova do FIFO chegou por volta da leitura do contador; a última lida
+    // é mais antiga pelos quadros que ficaram.
+    m_rawBatch.Time = readTime - (uint32_t)((available - frames) * 1000000.0f / m_rawBatch.SampleRate);
+    m_rawBatch.Count += frames;
+
+    if(m_rawBatch.Count == MPU6050_RAW_BATCH_SIZE)
+        deliverRawBatch();
+
+    if(frames == available)
+        vTaskDelay(pdMS_TO_TICKS(MPU6050_RAW_POLL_INTERVAL));
+}
+
+void MPU6050IMU::deliverRawBatch()
+{
+    if(m_rawBatch.Count == 0)
+        return;
+
+    IMURawBatchCallback_t callback = m_rawCallback;
+    if(callback != NULL)
+        callback(m_rawBatch);
+
+    m_rawData.Batches++;
+    m_rawData.Samples += m_rawBatch.Count;
+    m_rawBatch.Sequence += m_rawBatch.Count;
+    m_rawBatch.Count = 0;
+    m_rawBatch.Gap = false;
+}
+
+#ifdef IMU_SOFTWARE_FUSION
+void MPU6050IMU::setFusionAlgorithm(IMUFusionAlgorithm_e algorithm)
+{
+    lock();
+    m_fusionAlgorithm = algorithm;
+    m_fusionChanged = true;
+    unlock();
+}
+
+void MPU6050IMU::setFusionGains(const IMUFusionGains_t &gains)
+{
+    lock();
+    m_fusionGains = gains;
+    m_fusionChanged = true;
+    unlock();
+}
+
+bool MPU6050IMU::updateFusion(IMUAxisData_t &data, int16_t *gyro)
+{
+    if(m_fusionChanged)
+    {
+        lock();
+        if(m_fusionAlgorithm != m_fusion.getAlgorithm())
+            m_fusion.setAlgorithm(m_fusionAlgorithm);
+        m_fusion.setGains(m_fusionGains);
+        m_fusionChanged = false;
+        unlock();
+    }
+
+    const uint16_t frameSize = sizeof(IMURawSample_t);
+    uint32_t busErrors = busErrorCount();
+    uint32_t stageStart = Profiler.start();
+
+    uint16_t count = m_mpu.getFIFOCount();
+
+    if(busErrorCount() == busErrors && count > 1023)
+    {
+        m_mpu.resetFIFO();
+        m_fifoOverflows++;
+        return false;
+    }
+
+    // Espera limitada, como no caminho do DMP.
+    uint32_t waitStart = millis();
+    while(count < frameSize && busErrorCount() == busErrors && millis() - waitStart <= MPU6050_FIFO_WAIT_TIMEOUT)
+        count = m_mpu.getFIFOCount();
+
+    if(count < frameSize || busErrorCount() != busErrors)
+    {
+        sampleFailed();
+        return false;
+    }
+
+    stageStart = Profiler.record(STAGE_FIFO_WAIT, stageStart);
+
+    // Normalmente há um quadro por leitura; atrasos são alcançados de uma vez, até a
+    // capacidade do buffer, em rajadas que cabem no contador do I2Cdev::readBytes().
+    uint16_t frames = count / frameSize;
+    if(frames > MPU6050_RAW_BATCH_SIZE)
+        frames = MPU6050_RAW_BATCH_SIZE;
+
+    uint8_t *bytes = (uint8_t *)m_rawBuffer;
+    for(uint16_t read = 0; read < frames && busErrorCount() == busErrors; read += MPU6050_RAW_CHUNK_SIZE)
+    {
+        uint16_t chunk = frames - read;
+        if(chunk > MPU6050_RAW_CHUNK_SIZE)
+            chunk = MPU6050_RAW_CHUNK_SIZE;
+        m_mpu.getFIFOBytes(&bytes[read * frameSize], chunk * frameSize);
+    }
+    if(busErrorCount() != busErrors)
+    {
+        // Rajada incompleta: o FIFO pode ter ficado desalinhado.
+        m_mpu.resetFIFO();
+        sampleFailed();
+        return false;
+    }
+
+    registerSample();
+    stageStart = Profiler.record(STAGE_FIFO_READ, stageStart);
+
+    // Todos os quadros passam pelo filtro, no intervalo do relógio do sensor; a amostra
+    // entregue é a do último.
+    int16_t raw[6];
+    for(uint16_t i = 0; i < frames; i++, bytes += frameSize)
+    {
+        for(uint8_t j = 0; j < 6; j++)
+            raw[j] = (int16_t)((bytes[2 * j] << 8) | bytes[2 * j + 1]);
+
+        const float accel[3] = {(float)raw[0], (float)raw[1], (float)raw[2]};
+        const float rate[3] = {raw[3] * m_gyroRadScale, raw[4] * m_gyroRadScale, raw[5] * m_gyroRadScale};
+
+        if(!m_fusionStarted)
+        {
+            m_fusion.reset(accel);
+            m_fusionStarted = true;
+        }
+        m_fusion.update(rate, accel, m_fusionPeriod);
+    }
+
+    float q[4];
+    m_fusion.getQuaternion(q);
+    data.Gravity_X = 2 * (q[1] * q[3] - q[0] * q[2]) * IMU_GRAVITY_ONE;
+    data.Gravity_Y = 2 * (q[0] * q[1] + q[2] * q[3]) * IMU_GRAVITY_ONE;
+    data.Gravity_Z = (q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3]) * IMU_GRAVITY_ONE;
+
+    stageStart = Profiler.record(STAGE_DMP_MATH, stageStart);
+
+    gyro[0] = raw[3];
+    gyro[1] = raw[4];
+    gyro[2] = raw[5];
+    data.Acc_X = (double) raw[0]/16384;
+    data.Acc_Y = (double) raw[1]/16384;
+    data.Acc_Z = (double) raw[2]/16384;
+    data.Gyro_X = gyro[0] * m_gyroScale;
+    data.Gyro_Y = gyro[1] * m_gyroScale;
+    data.Gyro_Z = gyro[2] * m_gyroScale;
+    data.Temperature = ((double)m_mpu.getTemperature()/340) + 36.53;
+    data.Time = millis();
+
+    if(busErrorCount() != busErrors)
+    {
+        sampleFailed();
+        return false;
+    }
+    m_failedSamples = 0;
+
+    Profiler.record(STAGE_RAW_READ, stageStart);
+
+    return true;
+}
+#endif
+
+void MPU6050IMU::updateAngles(IMUAxisData_t &data)
+{
+#ifdef IMU_BENCHMARK
+    // No benchmark os ângulos já vêm prontos na amostra gerada.
+    (void)data;
+#else
+#ifdef IMU_SOFTWARE_FUSION
+    m_fusion.getYawPitchRoll(g_YPR);
+#else
+    g_quart.getYawPitchRoll(g_YPR, &g_gravity);
+#endif
+
+    data.Yaw = g_YPR[0] * g_degreeRad;
+    data.Pitch = g_YPR[1] * g_degreeRad;
+    data.Roll = g_YPR[2] * g_degreeRad;
+#endif
+}
+
 void MPU6050IMU::wrapper(void * parameter)
 {
     for(;;)
@@ -183,6 +1054,7 @@ IMUOffsets_t MPU6050IMU::getCurrentOffsets()
 
 void MPU6050IMU::setOffsets(IMUOffsets_t newOffsets)
 {
+    m_offsets = newOffsets;
     m_mpu.setXAccelOffset(newOffsets.XAccelOffset);
     m_mpu.setYAccelOffset(newOffsets.YAccelOffset);
     m_mpu.setZAccelOffset(newOffsets.ZAccelOffset);
@@ -191,4 +1063,9 @@ void MPU6050IMU::setOffsets(IMUOffsets_t newOffsets)
     m_mpu.setZGyroOffset(newOffsets.ZGyroOffset);
 }
 
+bool MPU6050IMU::hasStoredOffsets()
+{
+    return m_storedOffsets;
+}
+
 MPU6050IMU MPU;
\ No newline at end of file
@@ -100,6 +100,11 @@ THE SOFTWARE.
     #define DEBUG_PRINTLNF(x, y)
 #endif
 
+// AK8975 address on the auxiliary I2C bus (0x0C to 0x0F, set by its CAD pins)
+#ifndef MPU6050_AK8975_ADDRESS
+#define MPU6050_AK8975_ADDRESS      0x0E
+#endif
+
 #define MPU6050_DMP_CODE_SIZE       1962    // dmpMemory[]
 #define MPU6050_DMP_CONFIG_SIZE     232     // dmpConfig[]
 #define MPU6050_DMP_UPDATES_SIZE    140     // dmpUpdates[]
@@ -393,16 +398,16 @@ uint8_t MPU6050_9Axis_MotionApps41::dmpInitialize() {
 
     DEBUG_PRINTLN(F("Setting magnetometer mode to power-down..."));
     //mag -> setMode(0);
-    I2Cdev::writeByte(0x0E, 0x0A, 0x00, wireObj);
+    I2Cdev::writeByte(MPU6050_AK8975_ADDRESS, 0x0A, 0x00, wireObj);
 
     DEBUG_PRINTLN(F("Setting magnetometer mode to fuse access..."));
     //mag -> setMode(0x0F);
-    I2Cdev::writeByte(0x0E, 0x0A, 0x0F, wireObj);
+    I2Cdev::writeByte(MPU6050_AK8975_ADDRESS, 0x0A, 0x0F, wireObj);
 
     DEBUG_PRINTLN(F("Reading mag magnetometer factory calibration..."));
     int8_t asax, asay, asaz;
     //mag -> getAdjustment(&asax, &asay, &asaz);
-    I2Cdev::readBytes(0x0E, 0x10, 3, buffer, I2Cdev::readTimeout, wireObj);
+    I2Cdev::readBytes(MPU6050_AK8975_ADDRESS, 0x10, 3, buffer, I2Cdev::readTimeout, wireObj);
     asax = (int8_t)buffer[0];
     asay = (int8_t)buffer[1];
     asaz = (int8_t)buffer[2];
@@ -418,13 +423,13 @@ uint8_t MPU6050_9Axis_MotionApps41::dmpInitialize() {
 
     DEBUG_PRINTLN(F("Setting magnetometer mode to power-down..."));
     //mag -> setMode(0);
-    I2Cdev::writeByte(0x0E, 0x0A, 0x00, wireObj);
+    I2Cdev::writeByte(MPU6050_AK8975_ADDRESS, 0x0A, 0x00, wireObj);
 
     // load DMP code into memory banks
     DEBUG_PRINT(F("Writing DMP code to MPU memory banks ("));
     DEBUG_PRINT(MPU6050_DMP_CODE_SIZE);
     DEBUG_PRINTLN(F(" bytes)"));
-    if (writeProgMemoryBlock(dmpMemory, MPU6050_DMP_CODE_SIZE)) {
+    if (writeProgMemoryBlockFast(dmpMemory, MPU6050_DMP_CODE_SIZE)) {
         DEBUG_PRINTLN(F("Success! DMP code written and verified."));
 
         DEBUG_PRINTLN(F("Configuring DMP and related settings..."));
@@ -520,17 +525,17 @@ uint8_t MPU6050_9Axis_MotionApps41::dmpInitialize() {
 
             DEBUG_PRINTLN(F("Setting AK8975 to single measurement mode..."));
             //mag -> setMode(1);
-            I2Cdev::writeByte(0x0E, 0x0A, 0x01, wireObj);
+            I2Cdev::writeByte(MPU6050_AK8975_ADDRESS, 0x0A, 0x01, wireObj);
 
-            // setup AK8975 (0x0E) as Slave 0 in read mode
+            // setup AK8975 as Slave 0 in read mode
             DEBUG_PRINTLN(F("Setting up AK8975 read slave 0..."));
-            I2Cdev::writeByte(0x68, MPU6050_RA_I2C_SLV0_ADDR, 0x8E, wireObj);
+            I2Cdev::writeByte(0x68, MPU6050_RA_I2C_SLV0_ADDR, 0x80 | MPU6050_AK8975_ADDRESS, wireObj);
             I2Cdev::writeByte(0x68, MPU6050_RA_I2C_SLV0_REG,  0x01, wireObj);
             I2Cdev::writeByte(0x68, MPU6050_RA_I2C_SLV0_CTRL, 0xDA, wireObj);
 
-            // setup AK8975 (0x0E) as Slave 2 in write mode
+            // setup AK8975 as Slave 2 in write mode
             DEBUG_PRINTLN(F("Setting up AK8975 write slave 2..."));
-            I2Cdev::writeByte(0x68, MPU6050_RA_I2C_SLV2_ADDR, 0x0E, wireObj);
+            I2Cdev::writeByte(0x68, MPU6050_RA_I2C_SLV2_ADDR, MPU6050_AK8975_ADDRESS, wireObj);
             I2Cdev::writeByte(0x68, MPU6050_RA_I2C_SLV2_REG,  0x0A, wireObj);
             I2Cdev::writeByte(0x68, MPU6050_RA_I2C_SLV2_CTRL, 0x81, wireObj);
             I2Cdev::writeByte(0x68, MPU6050_RA_I2C_SLV2_DO,   0x01, wireObj);
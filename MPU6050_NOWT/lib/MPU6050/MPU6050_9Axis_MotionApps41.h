@@ -38,8 +38,12 @@ THE SOFTWARE.
 #ifndef _MPU6050_6AXIS_MOTIONAPPS41_H_
 #define _MPU6050_6AXIS_MOTIONAPPS41_H_
 
-// take ownership of the "MPU6050" typedef
+// take ownership of the "MPU6050" typedef, unless another MotionApps header already did
+// (several firmware classes can then be used in the same translation unit)
+#ifndef I2CDEVLIB_MPU6050_TYPEDEF
 #define I2CDEVLIB_MPU6050_TYPEDEF
+#define I2CDEVLIB_MPU6050_TYPEDEF_MOTIONAPPS41
+#endif
 
 #include "MPU6050.h"
 
@@ -148,6 +152,8 @@ class MPU6050_9Axis_MotionApps41 : public MPU6050_Base {
         uint16_t dmpPacketSize;
 };
 
+#ifdef I2CDEVLIB_MPU6050_TYPEDEF_MOTIONAPPS41
 typedef MPU6050_9Axis_MotionApps41 MPU6050;
+#endif
 
 #endif /* _MPU6050_6AXIS_MOTIONAPPS41_H_ */
@@ -0,0 +1,160 @@
+/**
+ * @file TelemetryService.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Arquivo de implementação das funções da classe TelemetryClass.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "TelemetryService.h"
+
+/**
+ * @brief Quantiza um valor, saturando nos limites do int16.
+ * 
+ * @param value Valor original.
+ * @param scale Escala do campo.
+ * @return int16_t - Valor quantizado.
+ */
+static int16_t quantize(double value, double scale)
+{
+    double scaled = round(value * scale);
+
+    if(scaled > INT16_MAX)
+        return INT16_MAX;
+    if(scaled < INT16_MIN)
+        return INT16_MIN;
+
+    return (int16_t)scaled;
+}
+
+/**
+ * @brief Escreve um inteiro em little-endian.
+ * 
+ * @param frame Buffer do quadro.
+ * @param index Posição de escrita (avança com a escrita).
+ * @param value Valor.
+ * @param size Quantidade de bytes.
+ */
+static void putLE(uint8_t *frame, size_t &index, uint32_t value, uint8_t size)
+{
+    for(uint8_t i = 0; i < size; i++)
+        frame[index++] = (value >> (8 * i)) & 0xFF;
+}
+
+bool TelemetryClass::begin()
+{
+    m_enabled = false;
+    m_fieldMask = TELEMETRY_FIELD_ALL;
+    m_sequence = 0;
+    m_dropped = 0;
+    m_queue = xQueueCreate(TELEMETRY_QUEUE_SIZE, sizeof(TelemetrySample_t));
+
+    return m_queue != NULL;
+}
+
+void TelemetryClass::handle()
+{
+    if(m_queue == NULL)
+        return;
+
+    TelemetrySample_t sample;
+    uint8_t frame[TELEMETRY_MAX_FRAME_SIZE];
+    uint8_t encoded[FRAMING_COBS_MAX_SIZE(TELEMETRY_MAX_FRAME_SIZE) + 1];
+
+    while(xQueueReceive(m_queue, &sample, 0) == pdTRUE)
+    {
+        size_t length = cobsEncode(frame, buildFrame(sample, frame), encoded);
+        encoded[length++] = FRAMING_DELIMITER;
+        Logger.write(encoded, length);
+    }
+}
+
+void TelemetryClass::setEnabled(bool newValue)
+{
+    if(newValue && !m_enabled && m_queue != NULL)
+    {
+        // Delimitador inicial para que o host descarte o texto ASCII anterior.
+        xQueueReset(m_queue);
+        Logger.write((uint8_t)FRAMING_DELIMITER);
+    }
+
+    m_enabled = newValue;
+}
+
+bool TelemetryClass::isEnabled()
+{
+    return m_enabled;
+}
+
+void TelemetryClass::setFieldMask(uint8_t newMask)
+{
+    m_fieldMask = newMask & TELEMETRY_FIELD_ALL;
+}
+
+uint32_t TelemetryClass::getDropped()
+{
+    return m_dropped;
+}
+
+void TelemetryClass::onSample(const IMUAxisData_t &data, DeviceState_e state)
+{
+    if(!Telemetry.m_enabled || Telemetry.m_queue == NULL)
+        return;
+
+    TelemetrySample_t sample;
+    sample.Time = data.Time;
+    sample.Sequence = Telemetry.m_sequence++;
+    sample.YPR[0] = quantize(data.Yaw, TELEMETRY_YPR_SCALE);
+    sample.YPR[1] = quantize(data.Pitch, TELEMETRY_YPR_SCALE);
+    sample.YPR[2] = quantize(data.Roll, TELEMETRY_YPR_SCALE);
+    sample.Acc[0] = quantize(data.Acc_X, TELEMETRY_ACC_SCALE);
+    sample.Acc[1] = quantize(data.Acc_Y, TELEMETRY_ACC_SCALE);
+    sample.Acc[2] = quantize(data.Acc_Z, TELEMETRY_ACC_SCALE);
+    sample.Gyro[0] = quantize(data.Gyro_X, TELEMETRY_GYRO_SCALE);
+    sample.Gyro[1] = quantize(data.Gyro_Y, TELEMETRY_GYRO_SCALE);
+    sample.Gyro[2] = quantize(data.Gyro_Z, TELEMETRY_GYRO_SCALE);
+    sample.Temperature = quantize(data.Temperature, TELEMETRY_TEMPERATURE_SCALE);
+    sample.State = (uint8_t)state;
+
+    // A task de leitura nunca espera pela serial: sem espaço, a amostra é descartada
+    // e a lacuna na sequência indica a perda para o host.
+    if(xQueueSend(Telemetry.m_queue, &sample, 0) != pdTRUE)
+        Telemetry.m_dropped++;
+}
+
+size_t TelemetryClass::buildFrame(const TelemetrySample_t &sample, uint8_t *frame)
+{
+    size_t index = 0;
+    uint8_t mask = m_fieldMask;
+
+    putLE(frame, index, TELEMETRY_FRAME_SAMPLE, 1);
+    putLE(frame, index, sample.Sequence, 2);
+    putLE(frame, index, sample.Time, 4);
+    putLE(frame, index, mask, 1);
+
+    if(mask & TELEMETRY_FIELD_YPR)
+        for(uint8_t i = 0; i < 3; i++)
+            putLE(frame, index, (uint16_t)sample.YPR[i], 2);
+
+    if(mask & TELEMETRY_FIELD_ACC)
+        for(uint8_t i = 0; i < 3; i++)
+            putLE(frame, index, (uint16_t)sample.Acc[i], 2);
+
+    if(mask & TELEMETRY_FIELD_GYRO)
+        for(uint8_t i = 0; i < 3; i++)
+            putLE(frame, index, (uint16_t)sample.Gyro[i], 2);
+
+    if(mask & TELEMETRY_FIELD_TEMPERATURE)
+        putLE(frame, index, (uint16_t)sample.Temperature, 2);
+
+    if(mask & TELEMETRY_FIELD_STATE)
+        putLE(frame, index, sample.State, 1);
+
+    putLE(frame, index, crc16CCITT(frame, index), 2);
+
+    return index;
+}
+
+TelemetryClass Telemetry;
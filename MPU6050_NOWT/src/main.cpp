@@ -10,88 +10,109 @@
 #include <vector>
 
 #include "DebugService.h"
+#include "I2CRecordService.h"
 #include "MessageService.h"
+#include "TelemetryService.h"
+
+#define BOOT_PROMPT_TIMEOUT 3000 // Tempo de espera pela resposta da calibração em unidades sem offsets salvos (ms).
 
 unsigned long g_readDelay = 200;
 bool g_calibrate = false;
 
-void setup() 
+/**
+ * @brief Pergunta pela serial se o sensor deve ser calibrado, aguardando
+ * a resposta por no máximo (timeout) milissegundos.
+ * @param timeout Tempo máximo de espera (ms).
+ * @return true - Caso a resposta seja 0x01.
+ * @return false - Caso a resposta seja 0x00 ou o tempo se esgote.
+ */
+bool askCalibration(unsigned long timeout)
 {
-    Debug.begin(&Serial);
+    Logger.printf("\nWould you like to calibrate? (0 or 1)");
 
-    while(1)
+    unsigned long start = millis();
+    while((millis() - start) < timeout)
     {
-        Serial.printf("\nWould you like to calibrate? (0 or 1)");
-        
         if(Serial.available())
         {
             uint8_t currentByte = Serial.read();
             if(currentByte == 0x00 || currentByte == 0x01)
-            {
-                g_calibrate = (currentByte == 1) ? true : false;
-                break;
-            }
+                return currentByte == 0x01;
         }
 
-        delay(750);
+        delay(1);
     }
 
-    // Configurando a sensibilidade da detecção dos eventos.
-    IMUTippingSettings_t tippingSettings;
-    tippingSettings.MinimumSamples = 17;
-    tippingSettings.TippingStartThreshold = 140;
+    return false;
+}
 
-    IMUMovementSettings_t movementSettings;
-    movementSettings.MinimumSamples = 4;
-    movementSettings.MovementInterval = 0.07;
+void setup() 
+{
+    Debug.begin(&Serial);
 
-    IMUStopSettings_t stopSettings;
-    stopSettings.MinimumSamples = 17;
-    stopSettings.StopInterval = 0.06;
+#ifdef IMU_BENCHMARK
+    Benchmark.begin("NOWT");
+#endif
 
-    IMUTamperSettings_t tamperSettings;
-    tamperSettings.TamperTime = 7;
-    tamperSettings.MinimumSamples = 5;
+#ifdef IMU_I2C_RECORD
+    // Grava o barramento desde o boot, incluindo a inicialização do DMP.
+    I2CRecord.start();
+#endif
 
     // Instanciando o sensor e configurando-o.
     MPU.begin(Wire);
 
+#ifndef IMU_BENCHMARK
+    // Unidades com offsets salvos não perguntam; as demais esperam a resposta por tempo limitado.
+    if(!MPU.hasStoredOffsets())
+        g_calibrate = askCalibration(BOOT_PROMPT_TIMEOUT);
+#endif
+
     if(g_calibrate)
     {
         IMUOffsets_t newOffsets = MPU.calibrate();
-        Serial.printf("\n\nAccOffsets[x, y, z]: [%d, %d, %d]", newOffsets.XAccelOffset, 
+        Logger.printf("\n\nAccOffsets[x, y, z]: [%d, %d, %d]", newOffsets.XAccelOffset, 
                                                                newOffsets.YAccelOffset, 
                                                                newOffsets.ZAccelOffset);
 
-        Serial.printf("\nGyroOffsets[x, y, z]: [%d, %d, %d]\n", newOffsets.XGyroOffset, 
+        Logger.printf("\nGyroOffsets[x, y, z]: [%d, %d, %d]\n", newOffsets.XGyroOffset, 
                                                                 newOffsets.YGyroOffset, 
                                                                 newOffsets.ZGyroOffset);
     } 
     else
     {
         IMUOffsets_t currentOffsets = MPU.getCurrentOffsets();
-        Serial.printf("\n\nAccOffsets[x, y, z]: [%d, %d, %d]", currentOffsets.XAccelOffset, 
+        Logger.printf("\n\nAccOffsets[x, y, z]: [%d, %d, %d]", currentOffsets.XAccelOffset, 
                                                                currentOffsets.YAccelOffset, 
                                                                currentOffsets.ZAccelOffset);
 
-        Serial.printf("\nGyroOffsets[x, y, z]: [%d, %d, %d]\n", currentOffsets.XGyroOffset, 
+        Logger.printf("\nGyroOffsets[x, y, z]: [%d, %d, %d]\n", currentOffsets.XGyroOffset, 
                                                                 currentOffsets.YGyroOffset, 
                                                                 currentOffsets.ZGyroOffset);
     }
     
-    MPU.configureTipping(tippingSettings);
-    MPU.configureMovementDetection(movementSettings);
-    MPU.configureStopDetection(stopSettings);
-    MPU.configureTamperDetection(tamperSettings);
+    // Sensibilidade das detecções (ver lib/IMUSensorLib/src/IMUProfiles.cpp).
+    MPU.applyProfile(IMU_PROFILE_CAR);
     MPU.start(g_readDelay);
 
     Debug.setDevice(&MPU);
     MessageService.setDevice(&MPU);
+
+    // O callback de amostras é registrado quando a telemetria é ligada (ver MessageService).
+    Telemetry.begin();
 }
 
 void loop() 
 { 
     MessageService.handle();
     Debug.handle();
+    I2CRecord.handle();
+    Telemetry.handle();
+    MPU.saveGyroModel();
+
+#ifdef IMU_BENCHMARK
+    Benchmark.handle();
+#endif
+
     delay(g_readDelay);
 }
\ No newline at end of file
@@ -3,6 +3,10 @@
 // 2013-06-05 by Jeff Rowberg <jeff@rowberg.net>
 //
 // Changelog:
+//      2026-10-18 - optional transaction tap (see I2CdevRecorder.h)
+//      2026-10-18 - optional bus usage counters per register range
+//      2026-10-18 - add I2CDEV_ESP32_ASYNC queued backend
+//      2026-10-18 - optional per-device shadow of configuration registers
 //      2021-09-28 - allow custom Wire object as transaction function argument
 //      2020-01-20 - hardija : complete support for Teensy 3.x
 //      2015-10-30 - simondlevy : support i2c_t3 for Teensy3.1
@@ -47,6 +51,12 @@ THE SOFTWARE.
 */
 
 #include "I2Cdev.h"
+#include "I2CdevAsync.h"
+
+// outcome of a transaction for the bus usage counters
+#define I2CDEV_STATS_OK         0
+#define I2CDEV_STATS_ERROR      1
+#define I2CDEV_STATS_TIMEOUT    2
 
 #if I2CDEV_IMPLEMENTATION == I2CDEV_ARDUINO_WIRE || I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_SBWIRE
 
@@ -95,6 +105,232 @@ THE SOFTWARE.
 I2Cdev::I2Cdev() {
 }
 
+/** Attach a register shadow. Its valid bitmap is cleared, so every cacheable
+ * register is read from the device once before being served from RAM.
+ * @param shadow Shadow with devAddr, wireObj, cacheable and selfClearing filled in
+ */
+void I2Cdev::attachShadow(I2Cdev_Shadow *shadow) {
+    detachShadow(shadow);
+    invalidateShadow(shadow);
+    shadow->next = shadows;
+    shadows = shadow;
+}
+
+/** Detach a register shadow (no effect if it is not attached).
+ * @param shadow Shadow passed to attachShadow()
+ */
+void I2Cdev::detachShadow(I2Cdev_Shadow *shadow) {
+    for (I2Cdev_Shadow **s = &shadows; *s != 0; s = &(*s)->next) {
+        if (*s == shadow) {
+            *s = shadow->next;
+            shadow->next = 0;
+            return;
+        }
+    }
+}
+
+/** Forget every cached value, e.g. after a device reset.
+ * @param shadow Shadow to invalidate
+ */
+void I2Cdev::invalidateShadow(I2Cdev_Shadow *shadow) {
+    memset(shadow->valid, 0, sizeof(shadow->valid));
+}
+
+/** Find the shadow attached for a device, if any.
+ * @param devAddr I2C slave device address
+ * @param wireObj Wire object used by the transaction
+ * @return Attached shadow or 0
+ */
+I2Cdev_Shadow *I2Cdev::findShadow(uint8_t devAddr, void *wireObj) {
+    for (I2Cdev_Shadow *s = shadows; s != 0; s = s->next) {
+        if (s->devAddr == devAddr && s->wireObj == wireObj) return s;
+    }
+    return 0;
+}
+
+/** Serve a read from the shadow when every requested register is cached.
+ * Words are stored MSB first, as the device sends them.
+ * @param length Number of registers (bytes) requested
+ * @param bytes Byte buffer to fill, or 0
+ * @param words Word buffer to fill, or 0
+ * @return True if the buffer was filled from RAM
+ */
+bool I2Cdev::readShadow(uint8_t devAddr, uint8_t regAddr, uint16_t length, uint8_t *bytes, uint16_t *words, void *wireObj) {
+    I2Cdev_Shadow *s = findShadow(devAddr, wireObj);
+    if (s == 0 || length == 0 || regAddr + length > 256) return false;
+    for (uint16_t r = regAddr; r < regAddr + length; r++) {
+        if (!(s->valid[r >> 3] & (1 << (r & 7)))) return false;
+    }
+    for (uint16_t i = 0; i < length; i++) {
+        uint8_t value = s->value[regAddr + i];
+        if (bytes) bytes[i] = value;
+        else if (i & 1) words[i >> 1] |= value;
+        else words[i >> 1] = value << 8;
+    }
+    shadowHits++;
+    return true;
+}
+
+/** Keep the shadow coherent with a completed transaction.
+ * A successful transfer stores the cacheable registers, minus their self-clearing
+ * bits; a failed write leaves the registers unknown, and a device reset forgets
+ * every register.
+ * @param length Number of registers (bytes) transferred
+ * @param bytes Byte buffer transferred, or 0
+ * @param words Word buffer transferred (MSB first on the bus), or 0
+ */
+void I2Cdev::updateShadow(uint8_t devAddr, uint8_t regAddr, uint16_t length, const uint8_t *bytes, const uint16_t *words, bool success, void *wireObj) {
+    I2Cdev_Shadow *s = findShadow(devAddr, wireObj);
+    if (s == 0) return;
+    for (uint16_t i = 0, r = regAddr; i < length && r < 256; i++, r++) {
+        uint8_t bit = 1 << (r & 7);
+        if (!(s->cacheable[r >> 3] & bit)) continue;
+        if (!success) {
+            s->valid[r >> 3] &= ~bit;
+            continue;
+        }
+        uint8_t value = bytes ? bytes[i] : (uint8_t)((i & 1) ? words[i >> 1] : words[i >> 1] >> 8);
+        if (r == s->resetReg && (value & s->resetMask)) {
+            invalidateShadow(s);
+            return;
+        }
+        for (uint8_t k = 0; k < s->selfClearingCount; k++) {
+            if (s->selfClearing[k][0] == r) value &= ~s->selfClearing[k][1];
+        }
+        s->value[r] = value;
+        s->valid[r >> 3] |= bit;
+    }
+}
+
+/** Enable or disable the bus usage counters.
+ * Each transaction then costs two micros() calls and a short range lookup.
+ * @param enabled New counters state
+ */
+void I2Cdev::setStatsEnabled(bool enabled) {
+    if (enabled && !statsEnabled) {
+        statsWindowStart = micros();
+        statsWindowBusTime = 0;
+    }
+    statsEnabled = enabled;
+}
+
+/** Get the bus usage counters state.
+ * @return True if transactions are being counted
+ */
+bool I2Cdev::getStatsEnabled() {
+    return statsEnabled;
+}
+
+/** Register a register range with its own counters. Ranges are matched in
+ * registration order, so narrow ranges must be added before wider ones.
+ * @param devAddr I2C slave device address
+ * @param firstReg First register of the range
+ * @param lastReg Last register of the range (inclusive)
+ * @param name Label used when printing the counters (must stay valid)
+ * @return Index of the range, or -1 if the table is full
+ */
+int8_t I2Cdev::addStatsRange(uint8_t devAddr, uint8_t firstReg, uint8_t lastReg, const char *name) {
+    if (statsRangeCount >= I2CDEV_STATS_RANGES) return -1;
+    I2Cdev_StatsRange *range = &statsRanges[statsRangeCount];
+    memset(range, 0, sizeof(*range));
+    range->devAddr = devAddr;
+    range->firstReg = firstReg;
+    range->lastReg = lastReg;
+    range->name = name;
+    return statsRangeCount++;
+}
+
+/** Get the number of ranges, range 0 included.
+ * @return Number of valid indexes for getStatsRange()
+ */
+uint8_t I2Cdev::getStatsRangeCount() {
+    return statsRangeCount;
+}
+
+/** Copy the counters of a range.
+ * @param index Range index (0 = unmatched traffic)
+ * @param range Container for the counters
+ * @return True if index is valid
+ */
+bool I2Cdev::getStatsRange(uint8_t index, I2Cdev_StatsRange *range) {
+    if (index >= statsRangeCount) return false;
+    *range = statsRanges[index];
+    return true;
+}
+
+/** Get the bus utilization of the last complete window (I2CDEV_STATS_PERIOD).
+ * A window without traffic to close it is closed here.
+ * @return Share of the window spent in transfers, in hundredths of percent
+ */
+uint16_t I2Cdev::getBusUtilization() {
+    uint32_t elapsed = micros() - statsWindowStart;
+    if (statsEnabled && elapsed >= 2 * (uint32_t)I2CDEV_STATS_PERIOD) {
+        busUtilization = (uint16_t)((uint64_t)statsWindowBusTime * 10000 / elapsed);
+        statsWindowStart += elapsed;
+        statsWindowBusTime = 0;
+    }
+    return busUtilization;
+}
+
+/** Zero every counter, keeping the registered ranges.
+ */
+void I2Cdev::resetStats() {
+    for (uint8_t i = 0; i < statsRangeCount; i++) {
+        statsRanges[i].transactions = 0;
+        statsRanges[i].bytes = 0;
+        statsRanges[i].busTime = 0;
+        statsRanges[i].errors = 0;
+        statsRanges[i].timeouts = 0;
+    }
+    statsWindowStart = micros();
+    statsWindowBusTime = 0;
+    busUtilization = 0;
+}
+
+/** Install (or remove, with tap = 0) the transaction tap.
+ * Reads served from a register shadow never reach the bus and are not tapped.
+ * @param tap Function called after every bus transaction
+ * @param context Passed back to the tap
+ */
+void I2Cdev::setTap(I2Cdev_Tap tap, void *context) {
+    // another task may be on the bus: never pair the new tap with the old context
+    I2Cdev::tap = 0;
+    tapContext = context;
+    I2Cdev::tap = tap;
+}
+
+/** Account one transaction in its range and in the utilization window.
+ * @param start micros() when the transaction started
+ * @param outcome I2CDEV_STATS_OK, I2CDEV_STATS_ERROR or I2CDEV_STATS_TIMEOUT
+ */
+void I2Cdev::recordStats(uint8_t devAddr, uint8_t regAddr, uint16_t bytes, uint32_t start, uint8_t outcome) {
+    uint32_t now = micros();
+    uint32_t busTime = now - start;
+
+    I2Cdev_StatsRange *range = &statsRanges[0];
+    for (uint8_t i = 1; i < statsRangeCount; i++) {
+        I2Cdev_StatsRange *r = &statsRanges[i];
+        if (r->devAddr == devAddr && regAddr >= r->firstReg && regAddr <= r->lastReg) {
+            range = r;
+            break;
+        }
+    }
+
+    range->transactions++;
+    range->bytes += bytes;
+    range->busTime += busTime;
+    if (outcome == I2CDEV_STATS_ERROR) range->errors++;
+    else if (outcome == I2CDEV_STATS_TIMEOUT) range->timeouts++;
+
+    statsWindowBusTime += busTime;
+    uint32_t elapsed = now - statsWindowStart;
+    if (elapsed >= I2CDEV_STATS_PERIOD) {
+        busUtilization = (uint16_t)((uint64_t)statsWindowBusTime * 10000 / elapsed);
+        statsWindowStart = now;
+        statsWindowBusTime = 0;
+    }
+}
+
 /** Read a single bit from an 8-bit device register.
  * @param devAddr I2C slave device address
  * @param regAddr Register regAddr to read from
@@ -207,6 +443,8 @@ int8_t I2Cdev::readWord(uint8_t devAddr, uint8_t regAddr, uint16_t *data, uint16
  * @return Number of bytes read (-1 indicates failure)
  */
 int8_t I2Cdev::readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data, uint16_t timeout, void *wireObj) {
+    if (shadows != 0 && readShadow(devAddr, regAddr, length, data, 0, wireObj)) return length;
+
     #ifdef I2CDEV_SERIAL_DEBUG
         Serial.print("I2C (0x");
         Serial.print(devAddr, HEX);
@@ -218,6 +456,7 @@ int8_t I2Cdev::readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8
     #endif
 
     int8_t count = 0;
+    uint32_t statsStart = statsEnabled ? micros() : 0;
     uint32_t t1 = millis();
 
     #if (I2CDEV_IMPLEMENTATION == I2CDEV_ARDUINO_WIRE || I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_SBWIRE || I2CDEV_IMPLEMENTATION == I2CDEV_TEENSY_3X_WIRE)
@@ -306,10 +545,26 @@ int8_t I2Cdev::readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8
             count = -1; // error
         }
 
+    #elif (I2CDEV_IMPLEMENTATION == I2CDEV_ESP32_ASYNC)
+
+        // queued on the bus task; the synchronous call only waits for completion
+        count = I2CdevAsync.transfer(devAddr, regAddr, I2CDEV_TRANSACTION_READ, length, data, timeout) ? length : -1;
+
     #endif
 
     // check for timeout
-    if (timeout > 0 && millis() - t1 >= timeout && count < length) count = -1; // timeout
+    uint8_t outcome = I2CDEV_STATS_OK;
+    if (timeout > 0 && millis() - t1 >= timeout && count < length) {
+        count = -1; // timeout
+        readTimeouts++;
+        outcome = I2CDEV_STATS_TIMEOUT;
+    } else if (count < length) {
+        readFailures++;
+        outcome = I2CDEV_STATS_ERROR;
+    }
+    if (statsEnabled) recordStats(devAddr, regAddr, length, statsStart, outcome);
+    if (tap) tap(devAddr, regAddr, I2CDEV_TAP_READ | (count == length ? 0 : I2CDEV_TAP_FAILED), length, data, tapContext);
+    if (shadows != 0 && count == length) updateShadow(devAddr, regAddr, length, data, 0, true, wireObj);
 
     #ifdef I2CDEV_SERIAL_DEBUG
         Serial.print(". Done (");
@@ -329,6 +584,8 @@ int8_t I2Cdev::readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8
  * @return Number of words read (-1 indicates failure)
  */
 int8_t I2Cdev::readWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16_t *data, uint16_t timeout, void *wireObj) {
+    if (shadows != 0 && readShadow(devAddr, regAddr, length * 2, 0, data, wireObj)) return length;
+
     #ifdef I2CDEV_SERIAL_DEBUG
         Serial.print("I2C (0x");
         Serial.print(devAddr, HEX);
@@ -340,6 +597,7 @@ int8_t I2Cdev::readWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint1
     #endif
 
     int8_t count = 0;
+    uint32_t statsStart = statsEnabled ? micros() : 0;
     uint32_t t1 = millis();
 
 #if I2CDEV_IMPLEMENTATION == I2CDEV_ARDUINO_WIRE || I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_SBWIRE || I2CDEV_IMPLEMENTATION == I2CDEV_TEENSY_3X_WIRE
@@ -461,9 +719,25 @@ int8_t I2Cdev::readWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint1
             count = -1; // error
         }
 
+    #elif (I2CDEV_IMPLEMENTATION == I2CDEV_ESP32_ASYNC)
+
+        // queued on the bus task; the synchronous call only waits for completion
+        count = I2CdevAsync.transfer(devAddr, regAddr, I2CDEV_TRANSACTION_READ | I2CDEV_TRANSACTION_WORDS, length, data, timeout) ? length : -1;
+
     #endif
 
-    if (timeout > 0 && millis() - t1 >= timeout && count < length) count = -1; // timeout
+    uint8_t outcome = I2CDEV_STATS_OK;
+    if (timeout > 0 && millis() - t1 >= timeout && count < length) {
+        count = -1; // timeout
+        readTimeouts++;
+        outcome = I2CDEV_STATS_TIMEOUT;
+    } else if (count < length) {
+        readFailures++;
+        outcome = I2CDEV_STATS_ERROR;
+    }
+    if (statsEnabled) recordStats(devAddr, regAddr, length * 2, statsStart, outcome);
+    if (tap) tap(devAddr, regAddr, I2CDEV_TAP_READ | I2CDEV_TAP_WORDS | (count == length ? 0 : I2CDEV_TAP_FAILED), length, data, tapContext);
+    if (shadows != 0 && count == length) updateShadow(devAddr, regAddr, length * 2, 0, data, true, wireObj);
 
     #ifdef I2CDEV_SERIAL_DEBUG
         Serial.print(". Done (");
@@ -598,6 +872,7 @@ bool I2Cdev::writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_
         Serial.print("...");
     #endif
     uint8_t status = 0;
+    uint32_t statsStart = statsEnabled ? micros() : 0;
 
 #if I2CDEV_IMPLEMENTATION == I2CDEV_ARDUINO_WIRE || I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_SBWIRE || I2CDEV_IMPLEMENTATION == I2CDEV_TEENSY_3X_WIRE
     TwoWire *useWire = &Wire;
@@ -640,10 +915,16 @@ bool I2Cdev::writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_
     #elif (I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_FASTWIRE)
         Fastwire::stop();
         //status = Fastwire::endTransmission();
+    #elif (I2CDEV_IMPLEMENTATION == I2CDEV_ESP32_ASYNC)
+        status = I2CdevAsync.transfer(devAddr, regAddr, 0, length, data, readTimeout) ? 0 : 4;
     #endif
     #ifdef I2CDEV_SERIAL_DEBUG
         Serial.println(". Done.");
     #endif
+    if (status != 0) writeFailures++;
+    if (statsEnabled) recordStats(devAddr, regAddr, length, statsStart, status == 0 ? I2CDEV_STATS_OK : I2CDEV_STATS_ERROR);
+    if (tap) tap(devAddr, regAddr, status == 0 ? 0 : I2CDEV_TAP_FAILED, length, data, tapContext);
+    if (shadows != 0) updateShadow(devAddr, regAddr, length, data, 0, status == 0, wireObj);
     return status == 0;
 }
 
@@ -665,6 +946,7 @@ bool I2Cdev::writeWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16
         Serial.print("...");
     #endif
     uint8_t status = 0;
+    uint32_t statsStart = statsEnabled ? micros() : 0;
 
 #if I2CDEV_IMPLEMENTATION == I2CDEV_ARDUINO_WIRE || I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_SBWIRE || I2CDEV_IMPLEMENTATION == I2CDEV_TEENSY_3X_WIRE
     TwoWire *useWire = &Wire;
@@ -711,10 +993,16 @@ bool I2Cdev::writeWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16
     #elif (I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_FASTWIRE)
         Fastwire::stop();
         //status = Fastwire::endTransmission();
+    #elif (I2CDEV_IMPLEMENTATION == I2CDEV_ESP32_ASYNC)
+        status = I2CdevAsync.transfer(devAddr, regAddr, I2CDEV_TRANSACTION_WORDS, length, data, readTimeout) ? 0 : 4;
     #endif
     #ifdef I2CDEV_SERIAL_DEBUG
         Serial.println(". Done.");
     #endif
+    if (status != 0) writeFailures++;
+    if (statsEnabled) recordStats(devAddr, regAddr, length * 2, statsStart, status == 0 ? I2CDEV_STATS_OK : I2CDEV_STATS_ERROR);
+    if (tap) tap(devAddr, regAddr, I2CDEV_TAP_WORDS | (status == 0 ? 0 : I2CDEV_TAP_FAILED), length, data, tapContext);
+    if (shadows != 0) updateShadow(devAddr, regAddr, length * 2, 0, data, status == 0, wireObj);
     return status == 0;
 }
 
@@ -722,6 +1010,19 @@ bool I2Cdev::writeWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16
  * Set this to 0 to disable timeout detection.
  */
 uint16_t I2Cdev::readTimeout = I2CDEV_DEFAULT_READ_TIMEOUT;
+uint32_t I2Cdev::readFailures = 0;
+uint32_t I2Cdev::readTimeouts = 0;
+uint32_t I2Cdev::writeFailures = 0;
+uint32_t I2Cdev::shadowHits = 0;
+I2Cdev_Shadow *I2Cdev::shadows = 0;
+bool I2Cdev::statsEnabled = false;
+I2Cdev_StatsRange I2Cdev::statsRanges[I2CDEV_STATS_RANGES] = { { I2CDEV_STATS_ANY_DEVICE, 0x00, 0xFF, "other" } };
+uint8_t I2Cdev::statsRangeCount = 1;
+uint32_t I2Cdev::statsWindowStart = 0;
+uint32_t I2Cdev::statsWindowBusTime = 0;
+uint16_t I2Cdev::busUtilization = 0;
+I2Cdev_Tap I2Cdev::tap = 0;
+void *I2Cdev::tapContext = 0;
 
 #if I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_FASTWIRE
     // I2C library
@@ -3,6 +3,10 @@
 // 2013-06-05 by Jeff Rowberg <jeff@rowberg.net>
 //
 // Changelog:
+//      2026-10-18 - optional transaction tap (see I2CdevRecorder.h)
+//      2026-10-18 - optional bus usage counters per register range
+//      2026-10-18 - add I2CDEV_ESP32_ASYNC queued backend
+//      2026-10-18 - optional per-device shadow of configuration registers
 //      2021-09-28 - allow custom Wire object as transaction function argument
 //      2020-01-20 - hardija : complete support for Teensy 3.x
 //      2015-10-30 - simondlevy : support i2c_t3 for Teensy3.1
@@ -62,6 +66,7 @@ THE SOFTWARE.
 //#define I2CDEV_IMPLEMENTATION       I2CDEV_TEENSY_3X_WIRE
 //#define I2CDEV_IMPLEMENTATION       I2CDEV_BUILTIN_SBWIRE
 //#define I2CDEV_IMPLEMENTATION       I2CDEV_BUILTIN_FASTWIRE
+//#define I2CDEV_IMPLEMENTATION       I2CDEV_ESP32_ASYNC
 #endif // I2CDEV_IMPLEMENTATION
 
 // comment this out if you are using a non-optimal IDE/implementation setting
@@ -78,6 +83,7 @@ THE SOFTWARE.
 #define I2CDEV_I2CMASTER_LIBRARY    4 // I2C object from DSSCircuits I2C-Master Library at https://github.com/DSSCircuits/I2C-Master-Library
 #define I2CDEV_BUILTIN_SBWIRE	    5 // I2C object from Shuning (Steve) Bian's SBWire Library at https://github.com/freespace/SBWire 
 #define I2CDEV_TEENSY_3X_WIRE       6 // Teensy 3.x support using i2c_t3 library
+#define I2CDEV_ESP32_ASYNC          7 // Queued transactions on the ESP-IDF command link driver (I2CdevAsync.h)
 
 // -----------------------------------------------------------------------------
 // Arduino-style "Serial.print" debug constant (uncomment to enable)
@@ -129,6 +135,55 @@ THE SOFTWARE.
 // 1000ms default read timeout (modify with "I2Cdev::readTimeout = [ms];")
 #define I2CDEV_DEFAULT_READ_TIMEOUT     1000
 
+#ifndef I2CDEV_STATS_RANGES
+#define I2CDEV_STATS_RANGES         8       // register ranges with their own counters, range 0 included
+#endif
+#define I2CDEV_STATS_PERIOD         1000000 // bus utilization window (us)
+#define I2CDEV_STATS_ANY_DEVICE     0xFF    // device address of range 0 (traffic not matched by any other range)
+
+/** Bus usage counters of one register range of one device.
+ * Range 0 collects every transaction not matched by a registered range.
+ * Reads served from a register shadow never reach the bus and are not counted.
+ */
+struct I2Cdev_StatsRange {
+    uint8_t devAddr;
+    uint8_t firstReg;
+    uint8_t lastReg;
+    const char *name;
+    uint32_t transactions;  // transfers issued on the bus
+    uint32_t bytes;         // payload bytes (register address not included)
+    uint32_t busTime;       // time spent inside the transfers (us)
+    uint32_t errors;        // NACKs and short reads
+    uint32_t timeouts;      // reads aborted by readTimeout
+};
+
+#define I2CDEV_TAP_READ             0x01    // transaction was a read (otherwise a write)
+#define I2CDEV_TAP_FAILED           0x02    // NACK, short read or timeout
+#define I2CDEV_TAP_WORDS            0x04    // data is uint16_t[length] in host order, otherwise uint8_t[length]
+
+/** Called after every transaction that reached the bus, with the data as
+ * written or as read. Runs in the caller's context and must not block.
+ */
+typedef void (*I2Cdev_Tap)(uint8_t devAddr, uint8_t regAddr, uint8_t flags, uint16_t length, const void *data, void *context);
+
+/** RAM copy of the cacheable registers of one device.
+ * While attached, reads of cacheable registers are served from RAM once they
+ * are known, and writeBit/writeBits skip the read half of read-modify-write.
+ * Only valid while nothing else changes those registers behind the driver's back.
+ */
+struct I2Cdev_Shadow {
+    uint8_t devAddr;
+    void *wireObj;
+    const uint8_t *cacheable;           // 32-byte bitmap of registers that may be cached
+    const uint8_t (*selfClearing)[2];   // {register, mask} of bits the device clears by itself
+    uint8_t selfClearingCount;
+    uint8_t resetReg;                   // writing any resetMask bit here resets the whole device
+    uint8_t resetMask;
+    uint8_t valid[32];                  // bitmap of registers whose value is known
+    uint8_t value[256];
+    I2Cdev_Shadow *next;
+};
+
 class I2Cdev {
     public:
         I2Cdev();
@@ -151,7 +206,45 @@ class I2Cdev {
         static bool writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data, void *wireObj=0);
         static bool writeWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16_t *data, void *wireObj=0);
 
+        static void attachShadow(I2Cdev_Shadow *shadow);
+        static void detachShadow(I2Cdev_Shadow *shadow);
+        static void invalidateShadow(I2Cdev_Shadow *shadow);
+
+        static void setStatsEnabled(bool enabled);
+        static bool getStatsEnabled();
+        static int8_t addStatsRange(uint8_t devAddr, uint8_t firstReg, uint8_t lastReg, const char *name);
+        static uint8_t getStatsRangeCount();
+        static bool getStatsRange(uint8_t index, I2Cdev_StatsRange *range);
+        static uint16_t getBusUtilization();
+        static void resetStats();
+
+        static void setTap(I2Cdev_Tap tap, void *context=0);
+
         static uint16_t readTimeout;
+
+        static uint32_t readFailures;   // reads that returned fewer bytes than requested
+        static uint32_t readTimeouts;   // reads aborted by readTimeout
+        static uint32_t writeFailures;  // writes not acknowledged by the device
+        static uint32_t shadowHits;     // reads served from a register shadow
+
+    private:
+        static I2Cdev_Shadow *shadows;
+
+        static I2Cdev_Shadow *findShadow(uint8_t devAddr, void *wireObj);
+        static bool readShadow(uint8_t devAddr, uint8_t regAddr, uint16_t length, uint8_t *bytes, uint16_t *words, void *wireObj);
+        static void updateShadow(uint8_t devAddr, uint8_t regAddr, uint16_t length, const uint8_t *bytes, const uint16_t *words, bool success, void *wireObj);
+
+        static bool statsEnabled;
+        static I2Cdev_StatsRange statsRanges[I2CDEV_STATS_RANGES];
+        static uint8_t statsRangeCount;
+        static uint32_t statsWindowStart;
+        static uint32_t statsWindowBusTime;
+        static uint16_t busUtilization;
+
+        static void recordStats(uint8_t devAddr, uint8_t regAddr, uint16_t bytes, uint32_t start, uint8_t outcome);
+
+        static I2Cdev_Tap tap;
+        static void *tapContext;
 };
 
 #if I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_FASTWIRE
@@ -0,0 +1,198 @@
+/**
+ * @file I2CdevAsync.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Arquivo de implementação das funções das classes I2Cdev_IdfBus e I2CdevAsyncClass.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "I2CdevAsync.h"
+
+#if I2CDEV_IMPLEMENTATION == I2CDEV_ESP32_ASYNC
+
+I2CdevAsyncClass I2CdevAsync;
+
+I2Cdev_IdfBus::I2Cdev_IdfBus()
+{
+    m_port = I2C_NUM_0;
+}
+
+bool I2Cdev_IdfBus::begin(i2c_port_t port, int sda, int scl, uint32_t frequency)
+{
+    i2c_config_t config = {};
+    config.mode = I2C_MODE_MASTER;
+    config.sda_io_num = sda;
+    config.scl_io_num = scl;
+    config.sda_pullup_en = GPIO_PULLUP_ENABLE;
+    config.scl_pullup_en = GPIO_PULLUP_ENABLE;
+    config.master.clk_speed = frequency;
+
+    m_port = port;
+    if(i2c_param_config(port, &config) != ESP_OK)
+        return false;
+
+    return i2c_driver_install(port, I2C_MODE_MASTER, 0, 0, 0) == ESP_OK;
+}
+
+bool I2Cdev_IdfBus::transfer(uint8_t devAddr, uint8_t regAddr, bool read, uint8_t *data, uint16_t length)
+{
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(m_link, sizeof(m_link));
+    if(cmd == NULL)
+        return false;
+
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (devAddr << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_write_byte(cmd, regAddr, true);
+    if(read)
+    {
+        // Repeated start, como o Wire faz para o MPU6050.
+        i2c_master_start(cmd);
+        i2c_master_write_byte(cmd, (devAddr << 1) | I2C_MASTER_READ, true);
+        i2c_master_read(cmd, data, length, I2C_MASTER_LAST_NACK);
+    }
+    else if(length > 0)
+    {
+        i2c_master_write(cmd, data, length, true);
+    }
+    i2c_master_stop(cmd);
+
+    esp_err_t result = i2c_master_cmd_begin(m_port, cmd, pdMS_TO_TICKS(I2CDEV_ASYNC_BUS_TIMEOUT));
+    i2c_cmd_link_delete_static(cmd);
+
+    return result == ESP_OK;
+}
+
+I2CdevAsyncClass::I2CdevAsyncClass() : m_queue(&m_bus)
+{
+    m_mutex = NULL;
+    m_events = NULL;
+    m_task = NULL;
+    m_freeSlots = (1UL << I2CDEV_ASYNC_WAIT_SLOTS) - 1;
+}
+
+bool I2CdevAsyncClass::begin(i2c_port_t port, int sda, int scl, uint32_t frequency)
+{
+    if(m_task != NULL)
+        return true;
+
+    if(!m_bus.begin(port, sda, scl, frequency))
+        return false;
+
+    m_mutex = xSemaphoreCreateMutex();
+    m_events = xEventGroupCreate();
+    if(m_mutex == NULL || m_events == NULL)
+        return false;
+
+    return xTaskCreate(task, "I2CdevAsync", I2CDEV_ASYNC_TASK_STACK, this, I2CDEV_ASYNC_TASK_PRIORITY, &m_task) == pdPASS;
+}
+
+bool I2CdevAsyncClass::submit(I2Cdev_Transaction *transaction)
+{
+    if(m_task == NULL)
+        return false;
+
+    xSemaphoreTake(m_mutex, portMAX_DELAY);
+
+    // Sem callback, a conclusão é sinalizada por um bit do grupo de eventos.
+    transaction->tag = 0;
+    if(transaction->callback == NULL)
+    {
+        if(m_freeSlots == 0)
+        {
+            xSemaphoreGive(m_mutex);
+            return false;
+        }
+        transaction->tag = m_freeSlots & (~m_freeSlots + 1); // Bit livre mais baixo.
+        m_freeSlots &= ~transaction->tag;
+    }
+
+    bool queued = m_queue.submit(transaction);
+    if(!queued)
+    {
+        m_freeSlots |= transaction->tag;
+        transaction->tag = 0;
+    }
+
+    xSemaphoreGive(m_mutex);
+
+    if(queued)
+        xTaskNotifyGive(m_task);
+
+    return queued;
+}
+
+bool I2CdevAsyncClass::wait(I2Cdev_Transaction *transaction, uint32_t timeout)
+{
+    uint32_t tag = transaction->tag;
+    if(tag == 0)
+        return transaction->status == I2CDEV_TRANSACTION_DONE;
+
+    TickType_t ticks = (timeout == 0) ? portMAX_DELAY : pdMS_TO_TICKS(timeout);
+    if((xEventGroupWaitBits(m_events, tag, pdTRUE, pdTRUE, ticks) & tag) == 0)
+    {
+        xSemaphoreTake(m_mutex, portMAX_DELAY);
+        bool canceled = m_queue.cancel(transaction);
+        xSemaphoreGive(m_mutex);
+
+        // Já está no barramento: o buffer só pode ser liberado depois da conclusão.
+        if(!canceled)
+            xEventGroupWaitBits(m_events, tag, pdTRUE, pdTRUE, portMAX_DELAY);
+    }
+
+    xSemaphoreTake(m_mutex, portMAX_DELAY);
+    m_freeSlots |= tag;
+    transaction->tag = 0;
+    xSemaphoreGive(m_mutex);
+
+    return transaction->status == I2CDEV_TRANSACTION_DONE;
+}
+
+bool I2CdevAsyncClass::transfer(uint8_t devAddr, uint8_t regAddr, uint8_t flags, uint16_t length, void *data, uint32_t timeout)
+{
+    I2Cdev_Transaction transaction;
+    I2Cdev_Queue::prepare(&transaction, devAddr, regAddr, flags, length, data);
+
+    // Chamada de dentro de um callback: a task do barramento não pode esperar por si mesma.
+    if(m_task != NULL && xTaskGetCurrentTaskHandle() == m_task)
+        return m_queue.execute(&transaction);
+
+    if(!submit(&transaction))
+        return false;
+
+    return wait(&transaction, timeout);
+}
+
+uint8_t I2CdevAsyncClass::getHighWaterMark()
+{
+    return m_queue.getHighWaterMark();
+}
+
+void I2CdevAsyncClass::task(void *parameter)
+{
+    I2CdevAsyncClass *async = (I2CdevAsyncClass *)parameter;
+
+    for(;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        for(;;)
+        {
+            xSemaphoreTake(async->m_mutex, portMAX_DELAY);
+            I2Cdev_Transaction *transaction = async->m_queue.next();
+            xSemaphoreGive(async->m_mutex);
+
+            if(transaction == NULL)
+                break;
+
+            // Depois do bit de conclusão a transação pode deixar de existir: o tag é lido antes.
+            uint32_t tag = transaction->tag;
+            async->m_queue.complete(transaction, async->m_queue.execute(transaction));
+            if(tag != 0)
+                xEventGroupSetBits(async->m_events, tag);
+        }
+    }
+}
+
+#endif // I2CDEV_IMPLEMENTATION == I2CDEV_ESP32_ASYNC
@@ -0,0 +1,144 @@
+/**
+ * @file I2CdevAsync.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Backend assíncrono do I2Cdev (I2CDEV_IMPLEMENTATION = I2CDEV_ESP32_ASYNC): as
+ * transações entram em uma fila (I2Cdev_Queue) atendida por uma task própria que usa o
+ * driver de command link do ESP-IDF, em vez do Wire do Arduino.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Quem envia uma transação com submit() continua executando enquanto ela ocupa o
+ * barramento e é avisado pelo callback (na task do barramento) ou espera com wait().
+ * As funções síncronas do I2Cdev (readBytes, writeBytes...) passam a ser apenas
+ * submit() seguido de wait(). Callbacks não devem bloquear; chamadas síncronas feitas
+ * dentro deles são executadas diretamente, sem passar pela fila.
+ */
+#ifndef _I2CDEV_ASYNC_H_
+#define _I2CDEV_ASYNC_H_
+
+#include "I2Cdev.h"
+
+#if I2CDEV_IMPLEMENTATION == I2CDEV_ESP32_ASYNC
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <driver/i2c.h>
+
+#include "I2CdevQueue.h"
+
+#define I2CDEV_ASYNC_TASK_STACK 3072     // Pilha da task do barramento (bytes).
+#define I2CDEV_ASYNC_TASK_PRIORITY 5     // Acima da task de leitura do sensor.
+#define I2CDEV_ASYNC_WAIT_SLOTS 16       // Transações sem callback aguardando wait() ao mesmo tempo.
+#define I2CDEV_ASYNC_BUS_TIMEOUT 50      // Tempo limite de uma transação no driver (ms).
+#define I2CDEV_ASYNC_LINK_SIZE I2C_LINK_RECOMMENDED_SIZE(7) // Comandos de uma leitura com repeated start.
+
+/**
+ * @brief Barramento do ESP-IDF: uma transação por command link, com buffer estático.
+ *
+ */
+class I2Cdev_IdfBus : public I2Cdev_Bus
+{
+public:
+    I2Cdev_IdfBus();
+
+    /**
+     * @brief Instala o driver I2C mestre na porta informada.
+     *
+     * @param port Porta I2C do ESP32.
+     * @param sda Pino SDA.
+     * @param scl Pino SCL.
+     * @param frequency Frequência do barramento (Hz).
+     * @return true - Caso o driver tenha sido instalado.
+     * @return false - Caso contrário.
+     */
+    bool begin(i2c_port_t port, int sda, int scl, uint32_t frequency);
+
+    bool transfer(uint8_t devAddr, uint8_t regAddr, bool read, uint8_t *data, uint16_t length) override;
+
+private:
+    i2c_port_t m_port;                         // Porta do driver.
+    uint8_t m_link[I2CDEV_ASYNC_LINK_SIZE];    // Memória do command link (apenas a task do barramento usa).
+};
+
+/**
+ * @brief Classe que atende a fila de transações em uma task dedicada.
+ *
+ */
+class I2CdevAsyncClass
+{
+public:
+    I2CdevAsyncClass();
+
+    /**
+     * @brief Instala o driver e cria a task do barramento.
+     *
+     * @param port Porta I2C do ESP32.
+     * @param sda Pino SDA.
+     * @param scl Pino SCL.
+     * @param frequency Frequência do barramento (Hz).
+     * @return true - Caso o backend esteja pronto.
+     * @return false - Caso contrário.
+     */
+    bool begin(i2c_port_t port, int sda, int scl, uint32_t frequency);
+
+    /**
+     * @brief Envia uma transação sem esperar por ela. Sem callback, a conclusão
+     * deve ser consumida com wait().
+     * @param transaction Transação preparada por I2Cdev_Queue::prepare(); deve
+     * permanecer válida até a conclusão.
+     * @return true - Caso tenha entrado na fila.
+     * @return false - Caso a fila (ou as esperas) esteja cheia ou o backend não tenha sido iniciado.
+     */
+    bool submit(I2Cdev_Transaction *transaction);
+
+    /**
+     * @brief Espera a conclusão de uma transação enviada sem callback. Se o tempo
+     * acabar antes de ela ir para o barramento, ela é cancelada; se já estiver no
+     * barramento, a espera continua até o fim (limitado pelo driver).
+     * @param transaction Transação enviada por submit().
+     * @param timeout Tempo limite (ms, 0 para esperar indefinidamente).
+     * @return true - Caso tenha sido concluída com sucesso.
+     * @return false - Caso contrário.
+     */
+    bool wait(I2Cdev_Transaction *transaction, uint32_t timeout);
+
+    /**
+     * @brief Executa uma transação e espera o resultado (base das funções síncronas do I2Cdev).
+     *
+     * @return true - Caso tenha sido concluída com sucesso.
+     * @return false - Caso contrário.
+     */
+    bool transfer(uint8_t devAddr, uint8_t regAddr, uint8_t flags, uint16_t length, void *data, uint32_t timeout);
+
+    /**
+     * @brief Retorna o pico de ocupação da fila.
+     *
+     * @return uint8_t - Maior número de transações já visto na fila.
+     */
+    uint8_t getHighWaterMark();
+
+private:
+    /**
+     * @brief Task que atende a fila.
+     *
+     * @param parameter Ponteiro para o objeto da classe.
+     */
+    static void task(void *parameter);
+
+    I2Cdev_Queue m_queue;        // Transações aguardando o barramento.
+    I2Cdev_IdfBus m_bus;         // Driver do ESP-IDF.
+    SemaphoreHandle_t m_mutex;   // Protege a fila e os slots de espera.
+    EventGroupHandle_t m_events; // Um bit por slot de espera, marcado na conclusão.
+    TaskHandle_t m_task;         // Task do barramento.
+    uint32_t m_freeSlots;        // Bits de espera livres.
+};
+
+extern I2CdevAsyncClass I2CdevAsync;
+
+#endif // I2CDEV_IMPLEMENTATION == I2CDEV_ESP32_ASYNC
+
+#endif /* _I2CDEV_ASYNC_H_ */
@@ -0,0 +1,316 @@
+/**
+ * @file I2CdevRecorder.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Arquivo de implementação das funções das classes I2Cdev_Recorder,
+ * I2Cdev_LogReader e I2Cdev_Replayer.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <string.h>
+
+#include "I2CdevRecorder.h"
+
+#define I2CDEV_LOG_VARINT_MAX 5 // Bytes de um uint32 em LEB128.
+
+static const uint8_t g_logMagic[4] = {'I', '2', 'C', 'R'};
+
+/**
+ * @brief Escreve um inteiro em LEB128.
+ *
+ * @return size_t - Bytes escritos.
+ */
+static size_t putVarint(uint8_t *output, uint32_t value)
+{
+    size_t size = 0;
+    while(value >= 0x80)
+    {
+        output[size++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    output[size++] = (uint8_t)value;
+
+    return size;
+}
+
+/**
+ * @brief Lê um inteiro em LEB128.
+ *
+ * @return true - Caso o inteiro esteja completo dentro do log.
+ * @return false - Caso contrário.
+ */
+static bool getVarint(const uint8_t *data, size_t size, size_t &position, uint32_t &value)
+{
+    value = 0;
+    for(uint8_t shift = 0; shift < 7 * I2CDEV_LOG_VARINT_MAX; shift += 7)
+    {
+        if(position >= size)
+            return false;
+
+        uint8_t byte = data[position++];
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        if((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+I2Cdev_Recorder::I2Cdev_Recorder()
+{
+    m_buffer = NULL;
+    m_capacity = 0;
+    m_size = 0;
+    m_lastTime = 0;
+    m_records = 0;
+    m_full = false;
+    m_recording = false;
+}
+
+void I2Cdev_Recorder::begin(uint8_t *buffer, size_t capacity)
+{
+    m_recording = false;
+    m_buffer = buffer;
+    m_capacity = (buffer != NULL) ? capacity : 0;
+    m_size = 0;
+    m_records = 0;
+    m_full = false;
+
+    if(m_capacity >= I2CDEV_LOG_HEADER_SIZE)
+    {
+        memcpy(m_buffer, g_logMagic, sizeof(g_logMagic));
+        m_buffer[4] = I2CDEV_LOG_VERSION;
+        m_size = I2CDEV_LOG_HEADER_SIZE;
+    }
+}
+
+void I2Cdev_Recorder::start(uint32_t time)
+{
+    if(m_capacity < I2CDEV_LOG_HEADER_SIZE)
+        return;
+
+    m_recording = false;
+    m_size = I2CDEV_LOG_HEADER_SIZE;
+    m_records = 0;
+    m_full = false;
+    m_lastTime = time;
+    m_recording = true;
+}
+
+void I2Cdev_Recorder::stop()
+{
+    m_recording = false;
+}
+
+bool I2Cdev_Recorder::isRecording()
+{
+    return m_recording;
+}
+
+void I2Cdev_Recorder::record(uint32_t time, uint8_t devAddr, uint8_t regAddr, uint8_t flags, uint16_t length, const void *data)
+{
+    if(!m_recording)
+        return;
+
+    bool words = (flags & I2CDEV_LOG_WORDS) != 0;
+    uint32_t bytes = words ? 2UL * length : length;
+
+    // Pior caso do cabeçalho do registro: flags, delta, endereço, registrador e tamanho.
+    if(m_size + 3 + 2 * I2CDEV_LOG_VARINT_MAX + bytes > m_capacity)
+    {
+        m_full = true;
+        m_recording = false;
+        return;
+    }
+
+    uint8_t *output = &m_buffer[m_size];
+    size_t size = 0;
+    output[size++] = flags & (I2CDEV_LOG_READ | I2CDEV_LOG_FAILED);
+    size += putVarint(&output[size], time - m_lastTime);
+    output[size++] = devAddr;
+    output[size++] = regAddr;
+    size += putVarint(&output[size], bytes);
+
+    if(words)
+    {
+        const uint16_t *source = (const uint16_t *)data;
+        for(uint16_t i = 0; i < length; i++)
+        {
+            output[size++] = (uint8_t)(source[i] >> 8);
+            output[size++] = (uint8_t)source[i];
+        }
+    }
+    else
+    {
+        memcpy(&output[size], data, bytes);
+        size += bytes;
+    }
+
+    m_size += size;
+    m_lastTime = time;
+    m_records++;
+}
+
+const uint8_t *I2Cdev_Recorder::getData()
+{
+    return m_buffer;
+}
+
+size_t I2Cdev_Recorder::getSize()
+{
+    return m_size;
+}
+
+size_t I2Cdev_Recorder::getCapacity()
+{
+    return m_capacity;
+}
+
+uint32_t I2Cdev_Recorder::getRecords()
+{
+    return m_records;
+}
+
+bool I2Cdev_Recorder::isFull()
+{
+    return m_full;
+}
+
+I2Cdev_LogReader::I2Cdev_LogReader()
+{
+    m_data = NULL;
+    m_size = 0;
+    m_position = 0;
+    m_time = 0;
+    m_truncated = false;
+}
+
+bool I2Cdev_LogReader::begin(const uint8_t *data, size_t size)
+{
+    m_data = NULL;
+    m_size = 0;
+    rewind();
+
+    if(data == NULL || size < I2CDEV_LOG_HEADER_SIZE || memcmp(data, g_logMagic, sizeof(g_logMagic)) != 0
+       || data[4] != I2CDEV_LOG_VERSION)
+        return false;
+
+    m_data = data;
+    m_size = size;
+    return true;
+}
+
+bool I2Cdev_LogReader::next(I2Cdev_LogRecord *record)
+{
+    if(m_data == NULL || m_position >= m_size)
+        return false;
+
+    size_t position = m_position;
+    uint32_t delta, length;
+
+    record->flags = m_data[position++];
+    if(!getVarint(m_data, m_size, position, delta) || position + 2 > m_size)
+    {
+        m_truncated = true;
+        return false;
+    }
+    record->devAddr = m_data[position++];
+    record->regAddr = m_data[position++];
+    if(!getVarint(m_data, m_size, position, length) || length > 0xFFFF || position + length > m_size)
+    {
+        m_truncated = true;
+        return false;
+    }
+
+    record->length = (uint16_t)length;
+    record->data = &m_data[position];
+    m_time += delta;
+    record->time = m_time;
+    m_position = position + length;
+
+    return true;
+}
+
+void I2Cdev_LogReader::rewind()
+{
+    m_position = I2CDEV_LOG_HEADER_SIZE;
+    m_time = 0;
+    m_truncated = false;
+}
+
+bool I2Cdev_LogReader::isTruncated()
+{
+    return m_truncated;
+}
+
+I2Cdev_Replayer::I2Cdev_Replayer(const uint8_t *data, size_t size)
+{
+    memset(&m_last, 0, sizeof(m_last));
+    m_valid = m_reader.begin(data, size);
+    m_exhausted = !m_valid;
+    m_replayed = 0;
+    m_mismatches = 0;
+    m_firstMismatch = UINT32_MAX;
+}
+
+bool I2Cdev_Replayer::transfer(uint8_t devAddr, uint8_t regAddr, bool read, uint8_t *data, uint16_t length)
+{
+    I2Cdev_LogRecord record;
+    if(m_exhausted || !m_reader.next(&record))
+    {
+        m_exhausted = true;
+        return false;
+    }
+
+    bool recordedRead = (record.flags & I2CDEV_LOG_READ) != 0;
+    bool matches = record.devAddr == devAddr && record.regAddr == regAddr && recordedRead == read
+                   && record.length == length && (read || memcmp(record.data, data, length) == 0);
+
+    if(!matches)
+    {
+        if(m_mismatches == 0)
+            m_firstMismatch = m_replayed;
+        m_mismatches++;
+    }
+
+    // Mesmo divergente, a leitura recebe o que o sensor respondeu naquele ponto da captura.
+    if(read)
+        memcpy(data, record.data, (record.length < length) ? record.length : length);
+
+    m_last = record;
+    m_replayed++;
+
+    return (record.flags & I2CDEV_LOG_FAILED) == 0;
+}
+
+bool I2Cdev_Replayer::isValid()
+{
+    return m_valid;
+}
+
+bool I2Cdev_Replayer::isExhausted()
+{
+    return m_exhausted;
+}
+
+const I2Cdev_LogRecord &I2Cdev_Replayer::getLastRecord()
+{
+    return m_last;
+}
+
+uint32_t I2Cdev_Replayer::getReplayed()
+{
+    return m_replayed;
+}
+
+uint32_t I2Cdev_Replayer::getMismatches()
+{
+    return m_mismatches;
+}
+
+uint32_t I2Cdev_Replayer::getFirstMismatch()
+{
+    return m_firstMismatch;
+}
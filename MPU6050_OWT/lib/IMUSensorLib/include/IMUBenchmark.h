@@ -0,0 +1,168 @@
+/**
+ * @file IMUBenchmark.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Benchmark das arquiteturas do firmware (NOWT, OWT e NONT) usando
+ * um sensor simulado e uma carga de trabalho idêntica.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include "IMUSensorStructs.h"
+
+#define IMU_BENCHMARK_SAMPLE_PERIOD_US 10000  // Período do pacote simulado do DMP (100 Hz).
+#define IMU_BENCHMARK_CYCLE_SAMPLES 3000      // Amostras de um ciclo completo da carga de trabalho (30 s).
+#define IMU_BENCHMARK_BYTE_TIME_US 25         // Tempo aproximado de um byte no barramento I2C a 400 kHz.
+#ifdef IMU_DMP_MOTIONAPPS612
+#define IMU_BENCHMARK_SAMPLE_BYTES 32         // Bytes lidos por amostra (pacote de 28 bytes + contagem do FIFO e temperatura).
+#else
+#define IMU_BENCHMARK_SAMPLE_BYTES 58         // Bytes lidos por amostra (pacote de 42 bytes + 8 leituras de registradores).
+#endif
+#define IMU_BENCHMARK_REPORT_INTERVAL 5000    // Intervalo entre relatórios (ms).
+
+/**
+ * @brief Métrica acumulada (mínimo, média e máximo) em microssegundos.
+ *
+ */
+struct IMUBenchmarkMetric_t
+{
+public:
+    IMUBenchmarkMetric_t()
+    {
+        reset();
+    }
+
+    /**
+     * @brief Adiciona uma nova medida à métrica.
+     *
+     * @param value Valor medido.
+     */
+    void add(uint32_t value)
+    {
+        if(value < Min)
+            Min = value;
+        if(value > Max)
+            Max = value;
+        Sum += value;
+        Count++;
+    }
+
+    /**
+     * @brief Zera a métrica.
+     *
+     */
+    void reset()
+    {
+        Count = 0;
+        Min = UINT32_MAX;
+        Max = 0;
+        Sum = 0;
+    }
+
+    /**
+     * @brief Retorna a média das medidas.
+     *
+     * @return uint32_t - Média (0 caso não haja medidas).
+     */
+    uint32_t average() const
+    {
+        return (Count == 0) ? 0 : (uint32_t)(Sum / Count);
+    }
+
+    uint32_t Count; // Quantidade de medidas.
+    uint32_t Min;   // Menor valor medido.
+    uint32_t Max;   // Maior valor medido.
+    uint64_t Sum;   // Soma das medidas.
+};
+
+/**
+ * @brief Classe que gera as amostras simuladas do sensor e
+ * contabiliza as métricas de cada arquitetura.
+ */
+class BenchmarkClass
+{
+public:
+    /**
+     * @brief Inicia o benchmark.
+     *
+     * @param architecture Nome da arquitetura avaliada (NOWT, OWT ou NONT).
+     */
+    void begin(const char *architecture);
+
+    /**
+     * @brief Atrela a task responsável pela leitura do sensor
+     * para acompanhar o uso da sua pilha.
+     * @param task Handle da task.
+     * @param stackSize Tamanho da pilha alocada para a task (bytes).
+     */
+    void setTask(TaskHandle_t task, uint32_t stackSize);
+
+    /**
+     * @brief Aguarda o próximo pacote simulado, da mesma forma que a
+     * leitura do FIFO aguarda o DMP, e preenche a amostra.
+     * @param data Amostra simulada.
+     */
+    void readSample(IMUAxisData_t &data);
+
+    /**
+     * @brief Indica que a amostra atual terminou de ser processada.
+     *
+     */
+    void sampleProcessed();
+
+    /**
+     * @brief Indica que a amostra atual foi usada para atualizar
+     * o estado do dispositivo.
+     */
+    void stateUpdated();
+
+    /**
+     * @brief Registra o tempo em que o semáforo do sensor ficou ocupado.
+     *
+     * @param holdTime Tempo de posse do semáforo (us).
+     */
+    void addLockHold(uint32_t holdTime);
+
+    /**
+     * @brief Itera o benchmark, imprimindo o relatório periodicamente.
+     *
+     */
+    void handle();
+
+private:
+    /**
+     * @brief Simula o tempo gasto no barramento I2C.
+     *
+     * @param bytes Quantidade de bytes transferidos.
+     */
+    void busTransfer(uint16_t bytes);
+
+    /**
+     * @brief Gera a amostra correspondente ao número de sequência
+     * dentro da carga de trabalho.
+     * @param sequence Número de sequência do pacote.
+     * @param data Amostra gerada.
+     */
+    void generate(uint32_t sequence, IMUAxisData_t &data);
+
+    const char *m_architecture;         // Nome da arquitetura avaliada.
+    TaskHandle_t m_task;                // Task de leitura do sensor.
+    uint32_t m_stackSize;               // Tamanho da pilha da task de leitura.
+    unsigned long m_startTime;          // Micros() em que o sensor simulado começou a gerar pacotes.
+    unsigned long m_lastReport;         // Millis() do último relatório.
+    unsigned long m_sampleTime;         // Micros() em que o pacote atual ficou disponível.
+    unsigned long m_readTime;           // Micros() em que a espera pelo pacote atual terminou.
+    uint32_t m_lastSequence;            // Último pacote consumido.
+    uint32_t m_samples;                 // Pacotes consumidos.
+    uint32_t m_missed;                  // Pacotes descartados por não terem sido consumidos a tempo.
+    IMUBenchmarkMetric_t m_latency;     // Latência entre o pacote e a atualização de estado.
+    IMUBenchmarkMetric_t m_cpuTime;     // Tempo de processamento de cada amostra.
+    IMUBenchmarkMetric_t m_lockHold;    // Tempo de posse do semáforo.
+};
+
+extern BenchmarkClass Benchmark;
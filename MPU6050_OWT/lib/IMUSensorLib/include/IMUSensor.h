@@ -19,8 +19,13 @@
 #include "I2Cdev.h"
 #include "CircularBuffer.h"
 #include "IIMUObserver.h"
+#include "IMULogger.h"
 #include "IMUSensorStructs.h"
 
+#ifdef IMU_BENCHMARK
+#include "IMUBenchmark.h"
+#endif
+
 const int g_historySize = 100; // Tamanho do histórico de leituras do sensor.
 
 /**
@@ -51,6 +56,18 @@ protected:
      */
     void addMeasurement(IMUAxisData_t measurement);
 
+    /**
+     * @brief Toma o semáforo do sensor.
+     * 
+     */
+    void lock();
+
+    /**
+     * @brief Libera o semáforo do sensor.
+     * 
+     */
+    void unlock();
+
     /**
      * @brief Realiza a reinicialização do vetor de medidas
      * do sensor.
@@ -63,6 +80,9 @@ protected:
     bool m_semaphoreInitialized;           // Flag que indica o funcionamento do semáforo.
     int m_readFrequency;                   // Frequência da leitura do sensor.
     SemaphoreHandle_t m_imuSemaphore;      // Semaforização de processos sensíveis.
+#ifdef IMU_BENCHMARK
+    unsigned long m_lockTime;              // Micros() em que o semáforo foi tomado.
+#endif
 
 public:
     /**
@@ -194,6 +214,7 @@ public:
 
 private: 
     IMUTippingSettings_t m_tippingSettings;         // Configurações para a detecção de tombamento.
+    int32_t m_tippingLimit;                         // Limiar de tombamento sobre o eixo X da gravidade (Q30).
     IMUMovementSettings_t m_movementSettings;       // Configurações para a detecção de movimento.
     IMUStopSettings_t m_stopSettings;               // Configurações para a detecção de parada.
     std::vector<IIMUObserver *> m_subscribers;       // Vetor com observadores da classe.
@@ -28,4 +28,16 @@ enum IMUModel_e
 {
     // MPU6050
     IMU_MODEL_MPU6050 = 0
+};
+
+/**
+ * @brief Política do Logger quando o buffer de
+ * transmissão está cheio.
+ */
+enum LoggerPolicy_e
+{
+    // Descarta a mensagem nova inteira.
+    LOGGER_DROP_NEWEST = 0,
+    // Sobrescreve os bytes mais antigos ainda não enviados.
+    LOGGER_DROP_OLDEST
 };
\ No newline at end of file
@@ -37,7 +37,7 @@ public:
             ((MPU6050IMU *)sensor)->begin(wire);
             break;
         default:
-            Serial.printf("\nSensor não reconhecido.");
+            Logger.printf("\nSensor não reconhecido.");
             break;
         }
         
@@ -11,6 +11,8 @@
 #pragma once
 
 #include "IIMUObserver.h"
+#include "IMUBenchmark.h"
+#include "IMULogger.h"
 #include "IMUSensor.h"
 #include "IMUSensorEnums.h"
 #include "IMUSensorFactory.h"
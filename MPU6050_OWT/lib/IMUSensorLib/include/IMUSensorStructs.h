@@ -10,10 +10,13 @@
  */
 #pragma once
 
+#include <stdint.h>
 #include <vector>
 
 #include "IMUSensorEnums.h" 
 
+#define IMU_GRAVITY_ONE ((int32_t)1 << 30) // Módulo unitário da gravidade em ponto fixo Q30.
+
 /**
  * @brief Dados de leitura dos eixos do IMU.
  * 
@@ -27,6 +30,7 @@ public:
         Acc_X = Acc_Y = Acc_Z = 0.0;
         Gyro_X = Gyro_Y = Gyro_Z = 0.0;
         Yaw = Pitch = Roll = 0.0;
+        Gravity_X = Gravity_Y = Gravity_Z = 0;
     }
 
     /**
@@ -82,6 +86,24 @@ public:
      * Roll.
      */
     double Roll;
+
+    /**
+     * @brief Eixo X da direção da gravidade, em Q30 (IMU_GRAVITY_ONE = 1),
+     * na convenção de dmpGetGravity().
+     */
+    int32_t Gravity_X;
+
+    /**
+     * @brief Eixo Y da direção da gravidade, em Q30.
+     * 
+     */
+    int32_t Gravity_Y;
+
+    /**
+     * @brief Eixo Z da direção da gravidade, em Q30.
+     * 
+     */
+    int32_t Gravity_Z;
 };
 
 /**
@@ -11,7 +11,18 @@
 #pragma once
 
 #include "IMUSensor.h"
+
+// Firmware do DMP escolhido na compilação. O MotionApps 6.12 (IMU_DMP_MOTIONAPPS612) entrega
+// pacotes de 28 bytes com acelerômetro e giroscópio brutos; o 2.0 (padrão), pacotes de 42 bytes.
+#ifdef IMU_DMP_MOTIONAPPS612
+#include "MPU6050_6Axis_MotionApps612.h"
+#define MPU6050_DMP_FIRMWARE "MotionApps 6.12"
+#else
 #include "MPU6050_6Axis_MotionApps20.h"
+#define MPU6050_DMP_FIRMWARE "MotionApps 2.0"
+#endif
+
+#define MPU6050_READ_TASK_STACK 10000 // Tamanho da pilha da task de leitura (bytes)
 
 /**
  * @brief Classe com os métodos para o sensor
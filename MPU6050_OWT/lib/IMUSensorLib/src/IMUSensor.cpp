@@ -18,8 +18,27 @@ unsigned long g_firstTip = 0;       // Millis() em que ocorreu a primeira leitur
 unsigned long g_firstMovement = 0;  // Millis() em que ocorreu a primeira leitura de movimento.
 unsigned long g_firstStop = 0;      // Millis() em que ocorreu a primeira leitura de parada.
 
+/**
+ * @brief Converte o limiar de tombamento (graus) para o eixo X da gravidade.
+ * Nas fórmulas do DMP, |Roll| > 90 equivale à gravidade Z negativa, e então o Pitch
+ * vale ±180 menos o ângulo da gravidade X com o plano. Os dois ramos do critério em
+ * graus se reduzem a |gravidade X| > sen(180 - limiar).
+ * @return int32_t - Limiar em Q30 (INT32_MAX quando o limiar não pode ser atingido).
+ */
+static int32_t tippingLimit(double threshold)
+{
+    if(threshold <= 90)
+        return INT32_MAX;
+    if(threshold >= 180)
+        return 0;
+
+    return (int32_t)(sin((180 - threshold) * M_PI / 180) * IMU_GRAVITY_ONE);
+}
+
 bool IMUSensor::begin(TwoWire &wire)
 {
+    m_tippingLimit = INT32_MAX;
+
     m_imuSemaphore = xSemaphoreCreateMutex();
     m_semaphoreInitialized = m_imuSemaphore != NULL;
     
@@ -30,6 +49,7 @@ void IMUSensor::configureTipping(IMUTippingSettings_t settings)
 {
     m_tippingSettings.MinimumSamples = settings.MinimumSamples;
     m_tippingSettings.TippingStartThreshold = settings.TippingStartThreshold;
+    m_tippingLimit = tippingLimit(settings.TippingStartThreshold);
 }
 
 void IMUSensor::configureMovementDetection(IMUMovementSettings_t settings)
@@ -50,9 +70,9 @@ IMUAxisData_t IMUSensor::getAxisData()
 
     if(!m_axisData.isEmpty() && m_semaphoreInitialized)
     {
-        xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+        lock();
         lastData = m_axisData.last();
-        xSemaphoreGive(m_imuSemaphore);
+        unlock();
     }
 
     return lastData;
@@ -65,9 +85,9 @@ bool IMUSensor::isRunning()
 
     bool threadRunning = false;
 
-    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+    lock();
     threadRunning = m_threadRunning;
-    xSemaphoreGive(m_imuSemaphore);
+    unlock();
     
     return threadRunning;
 }
@@ -85,7 +105,7 @@ void IMUSensor::detach(IIMUObserver *observer)
 void IMUSensor::notifyTipping(IMUTippingData_t data)
 {  
     if(m_subscribers.empty())
-        Serial.printf("\n[IMUSensor] Sem observadores.");
+        Logger.printf("\n[IMUSensor] Sem observadores.");
     else
     {
         for(auto observers : m_subscribers)
@@ -96,7 +116,7 @@ void IMUSensor::notifyTipping(IMUTippingData_t data)
 void IMUSensor::notifyMovement(IMUMovementData_t data)
 {
     if(m_subscribers.empty())
-        Serial.printf("\n[IMUSensor] Sem observadores.");
+        Logger.printf("\n[IMUSensor] Sem observadores.");
     else
     {
         for(auto observer : m_subscribers)
@@ -107,7 +127,7 @@ void IMUSensor::notifyMovement(IMUMovementData_t data)
 void IMUSensor::notifyStop(IMUStopData_t data)
 {
     if(m_subscribers.empty())
-        Serial.printf("\n[IMUSensor] Sem observadores.");
+        Logger.printf("\n[IMUSensor] Sem observadores.");
     else
     {
         for(auto observer : m_subscribers)
@@ -122,9 +142,9 @@ bool IMUSensor::getTippedState()
 
     bool tipped = false;
 
-    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+    lock();
     tipped = m_tipped;
-    xSemaphoreGive(m_imuSemaphore);
+    unlock();
 
     return tipped;
 }
@@ -136,9 +156,9 @@ bool IMUSensor::getMovingState()
 
     bool moving = false;
 
-    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+    lock();
     moving = m_moving;
-    xSemaphoreGive(m_imuSemaphore);
+    unlock();
 
     return moving;
 }
@@ -150,42 +170,24 @@ void IMUSensor::detectTipping()
 
     IMUAxisData_t lastData = getAxisData();
 
-    /**
-     * Devido ao novo comportamento do sensor, o Roll deve ser analisado
-     * para definir se há um tombamento.
-     */
-    if(abs(lastData.Roll) > 90)
+    // Comparação inteira sobre a gravidade em Q30, sem Yaw, Pitch e Roll (ver tippingLimit()).
+    if(lastData.Gravity_X > m_tippingLimit || lastData.Gravity_X < -m_tippingLimit)
     {
-        if(abs(lastData.Pitch) < m_tippingSettings.TippingStartThreshold)
-        {
-            if(g_tippedCount == 0)
-                g_firstTip = lastData.Time;
-            g_tippedCount++;
-            Serial.printf("\n[IMUSensor] Tombamento detectado.");
-        }
-        else
-            g_tippedCount = 0;
+        if(g_tippedCount == 0)
+            g_firstTip = lastData.Time;
+        g_tippedCount++;
+        Logger.printf("\n[IMUSensor] Tombamento detectado.");
     }
     else
-    {
-        if(abs(lastData.Pitch) > (180 - m_tippingSettings.TippingStartThreshold))
-        {
-            if(g_tippedCount == 0)
-                g_firstTip = lastData.Time;
-            g_tippedCount++;
-            Serial.printf("\n[IMUSensor] Tombamento detectado.");
-        }
-        else
-            g_tippedCount = 0;
-    }
+        g_tippedCount = 0;
 
     if(g_tippedCount >= m_tippingSettings.MinimumSamples && m_axisData.isFull())
     {
         IMUTippingData_t tippedData;
 
-        xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+        lock();
         m_tipped = true;
-        xSemaphoreGive(m_imuSemaphore);
+        unlock();
 
         tippedData.Side = (lastData.Acc_X > 0) ? IMUTippingSide_e::IMU_TIP_SIDE_LEFT : IMUTippingSide_e::IMU_TIP_SIDE_RIGHT;
         tippedData.StartTime = g_firstTip;
@@ -197,9 +199,9 @@ void IMUSensor::detectTipping()
     }
     else
     {
-        xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+        lock();
         m_tipped = false;
-        xSemaphoreGive(m_imuSemaphore);
+        unlock();
     }
 }
 
@@ -214,7 +216,7 @@ void IMUSensor::detectMovement()
     {
         if(g_movementCount == 0)
             g_firstMovement = lastData.Time;
-        Serial.printf("\n[IMUSensor] Movimento detectado");
+        Logger.printf("\n[IMUSensor] Movimento detectado");
         g_movementCount++;
     }
     else
@@ -224,18 +226,18 @@ void IMUSensor::detectMovement()
     {
         IMUMovementData_t movementData;
 
-        xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+        lock();
         m_moving = true;
-        xSemaphoreGive(m_imuSemaphore);
+        unlock();
 
         movementData.StartTime = g_firstMovement;
         notifyMovement(movementData);
     }
     else
     {
-        xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+        lock();
         m_moving = false;
-        xSemaphoreGive(m_imuSemaphore);
+        unlock();
     }
 }
 
@@ -250,7 +252,7 @@ void IMUSensor::detectStop()
     {
         if(g_stopCount == 0)
             g_firstStop = lastData.Time;
-        Serial.printf("\n[IMUSensor] Parada detectada.");
+        Logger.printf("\n[IMUSensor] Parada detectada.");
         g_stopCount++;
     }
     else
@@ -260,9 +262,9 @@ void IMUSensor::detectStop()
     {
         IMUStopData_t stopData;
 
-        xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+        lock();
         m_moving = false;
-        xSemaphoreGive(m_imuSemaphore);
+        unlock();
 
         stopData.StartTime = g_firstStop;
         notifyStop(stopData);
@@ -274,12 +276,28 @@ void IMUSensor::addMeasurement(IMUAxisData_t measurement)
     if(!m_semaphoreInitialized)
         return;
 
-    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+    lock();
     m_axisData.push(measurement);
-    xSemaphoreGive(m_imuSemaphore);
+    unlock();
 }
 
 void IMUSensor::resetMeasurements()
 {
     m_axisData.clear();
+}
+
+void IMUSensor::lock()
+{
+    xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+#ifdef IMU_BENCHMARK
+    m_lockTime = micros();
+#endif
+}
+
+void IMUSensor::unlock()
+{
+#ifdef IMU_BENCHMARK
+    Benchmark.addLockHold(micros() - m_lockTime);
+#endif
+    xSemaphoreGive(m_imuSemaphore);
 }
\ No newline at end of file
@@ -10,12 +10,13 @@
  */
 
 #include "MPU6050_IMU.h"
+#include "I2CdevAsync.h"
 
-uint16_t g_fifoPacketSize;          // Tamanho esperado do pacote do DMP (Padrão: 42 bytes)
+uint16_t g_fifoPacketSize;          // Tamanho esperado do pacote do DMP (42 bytes no MotionApps 2.0, 28 no 6.12)
 uint16_t g_fifoCount;               // Quantos bytes o FIFO possui atualmente.
 uint8_t g_fifoBuffer[64];           // Buffer para armezamento do FIFO.
-VectorFloat g_gravity;              // [x, y, z]    Vetor para informações da gravidade.
-Quaternion g_quart;                 // [w, x, y, z] Vetor para informações de quaternion.
+VectorInt32 g_gravity;              // [x, y, z]    Direção da gravidade em Q30.
+QuaternionQ30 g_quart;              // [w, x, y, z] Quaternion do DMP em Q30.
 const float g_degreeRad = 180/M_PI; // Termo de conversão de radianos para graus.
 float g_YPR[3];                     // Buffer de leitura do Yaw, Pitch e Roll
 unsigned long g_timeLastRead = 0;   // Millis() em que foi feito último registro de leitura no histórico.
@@ -33,15 +34,42 @@ MPU6050IMU::MPU6050IMU()
 
 bool MPU6050IMU::begin(TwoWire &wire)
 {
+#ifdef IMU_BENCHMARK
+    // No benchmark o sensor é simulado, então o barramento não é utilizado.
+    m_dmpStatus = true;
+    return IMUSensor::begin(wire);
+#endif
+
+#if I2CDEV_IMPLEMENTATION == I2CDEV_ESP32_ASYNC
+    // Backend assíncrono: o driver do ESP-IDF ocupa a porta no lugar do Wire.
+    if(!I2CdevAsync.begin(I2C_NUM_0, 33, 32, 400000))
+        return false;
+#else
     wire.begin(33, 32, 400000);
+#endif
     m_mpu.initialize();
 
     if(!m_mpu.testConnection())
     {
-        Serial.printf("\n[MPU6050IMU] Conexao com a MPU falhou!");
+        Logger.printf("\n[MPU6050IMU] Conexao com a MPU falhou!");
         return false;
     }
 
+    // Registradores de configuração espelhados em RAM: setters de bits sem a leitura prévia
+    // e getters de configuração sem acesso ao barramento.
+    m_mpu.setShadowRegistersEnabled(true);
+
+    // Contadores de uso do barramento por faixa de registradores (as faixas mais estreitas
+    // primeiro, pois a primeira que contém o registrador é a utilizada).
+    if(I2Cdev::getStatsRangeCount() == 1)
+    {
+        I2Cdev::addStatsRange(MPU6050_DEFAULT_ADDRESS, MPU6050_RA_FIFO_COUNTH, MPU6050_RA_FIFO_R_W, "fifo");
+        I2Cdev::addStatsRange(MPU6050_DEFAULT_ADDRESS, MPU6050_RA_BANK_SEL, MPU6050_RA_MEM_R_W, "dmp mem");
+        I2Cdev::addStatsRange(MPU6050_DEFAULT_ADDRESS, MPU6050_RA_ACCEL_XOUT_H, MPU6050_RA_EXT_SENS_DATA_23, "dados");
+        I2Cdev::addStatsRange(MPU6050_DEFAULT_ADDRESS, 0x00, 0xFF, "config");
+    }
+    I2Cdev::setStatsEnabled(true);
+
     m_deviceStatus = m_mpu.dmpInitialize();
 
     // Mudar esses valores por Offsets default ou por Offsets lidos da memória.
@@ -54,7 +82,7 @@ bool MPU6050IMU::begin(TwoWire &wire)
 
     if(m_deviceStatus != 0)
     {
-        Serial.printf("\n[MPU6050IMU] Conexão com o DMP falhou!");
+        Logger.printf("\n[MPU6050IMU] Conexão com o DMP falhou!");
         return false;
     }
 
@@ -64,90 +92,144 @@ bool MPU6050IMU::begin(TwoWire &wire)
 
     if(!IMUSensor::begin(wire))
     {
-        Serial.printf("\n[MPU6050IMU] Falha na criacao do semaforo!");
+        Logger.printf("\n[MPU6050IMU] Falha na criacao do semaforo!");
         return false;
     }
 
-    Serial.printf("\n[MPU6050IMU] Conexao com a MPU iniciada.");
+    Logger.printf("\n[MPU6050IMU] Conexao com a MPU iniciada (DMP %s, pacote de %u bytes).", MPU6050_DMP_FIRMWARE,
+                  g_fifoPacketSize);
 
     return true;
 }
 
 bool MPU6050IMU::calibrate()
 {
-    Serial.printf("\n[MPU6050IMU] Iniciando processo de calibracao...");
-    m_mpu.CalibrateAccel(10);
-    m_mpu.CalibrateGyro(10);
-    Serial.printf("\n[MPU6050IMU] Calibracao concluida!");
+    MPU6050_CalibrationResult result;
 
-    // Depois adicionar verificações para checar se a calibração realmente funcionou.
-    return true;
+    Logger.printf("\n[MPU6050IMU] Iniciando processo de calibracao...");
+    if(m_mpu.CalibrateFast(result))
+    {
+        Logger.printf("\n[MPU6050IMU] Calibracao concluida em %u iteracoes (residuo acel %.1f, giro %.1f LSB).",
+                      result.iterations, result.accelResidual, result.gyroResidual);
+        return true;
+    }
+
+    Logger.printf("\n[MPU6050IMU] Calibracao rapida nao convergiu, usando a rotina completa.");
+    m_mpu.CalibrateAccel(6);
+    m_mpu.CalibrateGyro(6);
+
+    return false;
 }
 
 void MPU6050IMU::updateData()
 {
     if(!m_dmpStatus)
         return;
-    
+
+    IMUAxisData_t data;
+
+#ifdef IMU_BENCHMARK
+    Benchmark.readSample(data);
+#else
     g_fifoCount = m_mpu.getFIFOCount();
 
     if(g_fifoCount > 1023)
     {
         m_mpu.resetFIFO();
-        Serial.printf("\n[MPU6050IMU] FIFO overflow!");
+        Logger.printf("\n[MPU6050IMU] FIFO overflow!");
+        return;
     }
-    else
-    {
-        while (g_fifoCount < g_fifoPacketSize) 
-            g_fifoCount = m_mpu.getFIFOCount();
 
-        g_fifoCount -= g_fifoPacketSize;
-        m_mpu.dmpGetCurrentFIFOPacket(g_fifoBuffer);
-
-        m_mpu.dmpGetQuaternion(&g_quart, g_fifoBuffer);
-        m_mpu.dmpGetGravity(&g_gravity, &g_quart);
-        m_mpu.dmpGetYawPitchRoll(g_YPR, &g_quart, &g_gravity);
-        
-        IMUAxisData_t data;
+    while (g_fifoCount < g_fifoPacketSize) 
+        g_fifoCount = m_mpu.getFIFOCount();
+
+    g_fifoCount -= g_fifoPacketSize;
+    m_mpu.dmpGetCurrentFIFOPacket(g_fifoBuffer);
+
+    // Quaternion em Q30 direto do pacote: a gravidade sai só de multiplicações inteiras
+    // e os ângulos ficam para as amostras que entram no histórico.
+    int32_t quaternion[4];
+    m_mpu.dmpGetQuaternion(quaternion, g_fifoBuffer);
+    g_quart = QuaternionQ30(quaternion);
+    g_gravity = g_quart.getGravity();
+
+    data.Gravity_X = g_gravity.x;
+    data.Gravity_Y = g_gravity.y;
+    data.Gravity_Z = g_gravity.z;
+
+#ifdef IMU_DMP_MOTIONAPPS612
+    // O pacote do 6.12 já traz acelerômetro e giroscópio brutos (mesma escala dos registradores).
+    int16_t accel[3], gyro[3];
+    m_mpu.dmpGetAccel(accel, g_fifoBuffer);
+    m_mpu.dmpGetGyro(gyro, g_fifoBuffer);
+#else
+    // No pacote do 2.0 acelerômetro e giroscópio estão na escala do DMP: as leituras brutas
+    // continuam vindo dos registradores.
+    int16_t accel[3] = {m_mpu.getAccelerationX(), m_mpu.getAccelerationY(), m_mpu.getAccelerationZ()};
+    int16_t gyro[3] = {m_mpu.getRotationX(), m_mpu.getRotationY(), m_mpu.getRotationZ()};
+#endif
+    data.Acc_X = (double) accel[0]/16384;
+    data.Acc_Y = (double) accel[1]/16384;
+    data.Acc_Z = (double) accel[2]/16384;
+    data.Gyro_X = (double) gyro[0]/131;
+    data.Gyro_Y = (double) gyro[1]/131;
+    data.Gyro_Z = (double) gyro[2]/131;
+    data.Time = millis();
+#endif
+
+    if(abs(millis() - g_timeLastRead) > m_readFrequency)
+    {
+#ifndef IMU_BENCHMARK
+        // No benchmark os ângulos já vêm prontos na amostra gerada.
+        g_quart.getYawPitchRoll(g_YPR, &g_gravity);
         data.Yaw  = g_YPR[0] * g_degreeRad;
         data.Pitch = g_YPR[1] * g_degreeRad;
         data.Roll = g_YPR[2] * g_degreeRad;
-        data.Acc_X = (double) m_mpu.getAccelerationX()/16384;
-        data.Acc_Y = (double) m_mpu.getAccelerationY()/16384;
-        data.Acc_Z = (double) m_mpu.getAccelerationZ()/16384;
-        data.Gyro_X = (double) m_mpu.getRotationX()/131;
-        data.Gyro_Y = (double) m_mpu.getRotationY()/131;
-        data.Gyro_Z = (double) m_mpu.getRotationZ()/131;
-        data.Time = millis();
-
-        if(abs(millis() - g_timeLastRead) > m_readFrequency)
-        {
-            Serial.printf("\n\nYPR: [%.2f]   [%.2f]   [%.2f]", data.Yaw, data.Pitch, data.Roll);
-
-            g_timeLastRead = millis();
-            addMeasurement(data);
-
-            detectTipping();
-            if(m_moving)
-                detectStop();
-            else
-                detectMovement();
-        }
+#endif
+
+        Logger.printf("\n\nYPR: [%.2f]   [%.2f]   [%.2f]", data.Yaw, data.Pitch, data.Roll);
+
+        g_timeLastRead = millis();
+        addMeasurement(data);
+
+        detectTipping();
+        if(m_moving)
+            detectStop();
+        else
+            detectMovement();
+
+#ifdef IMU_BENCHMARK
+        Benchmark.stateUpdated();
+#endif
     }
+
+#ifdef IMU_BENCHMARK
+    Benchmark.sampleProcessed();
+#endif
 }
 
 void MPU6050IMU::start(int frequency)
 {
-    if(!m_threadRunning && m_dmpStatus && m_mpu.testConnection() && m_semaphoreInitialized)
+#ifdef IMU_BENCHMARK
+    bool connected = true;
+#else
+    bool connected = m_mpu.testConnection();
+#endif
+
+    if(!m_threadRunning && m_dmpStatus && connected && m_semaphoreInitialized)
     {
         m_readFrequency = frequency;
-        xTaskCreate(wrapper, "[MPU6050]readTask", 10000, this, 1, &g_readTaskHandle);
+        xTaskCreate(wrapper, "[MPU6050]readTask", MPU6050_READ_TASK_STACK, this, 1, &g_readTaskHandle);
+
+#ifdef IMU_BENCHMARK
+        Benchmark.setTask(g_readTaskHandle, MPU6050_READ_TASK_STACK);
+#endif
 
-        xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+        lock();
         m_threadRunning = true;
-        xSemaphoreGive(m_imuSemaphore);
+        unlock();
 
-        Serial.printf("\n[MPU6050IMU] Thread de leitura iniciada.");
+        Logger.printf("\n[MPU6050IMU] Thread de leitura iniciada.");
     }
 }
 
@@ -155,9 +237,9 @@ void MPU6050IMU::stop()
 {
     if(m_threadRunning && g_readTaskHandle != NULL && m_semaphoreInitialized)
     {
-        xSemaphoreTake(m_imuSemaphore, portMAX_DELAY);
+        lock();
         m_threadRunning = false;
-        xSemaphoreGive(m_imuSemaphore);
+        unlock();
 
         resetMeasurements();
 
@@ -330,7 +330,7 @@ uint8_t MPU6050_6Axis_MotionApps20::dmpInitialize() {
 	DEBUG_PRINT(F("Writing DMP code to MPU memory banks ("));
 	DEBUG_PRINT(MPU6050_DMP_CODE_SIZE);
 	DEBUG_PRINTLN(F(" bytes)"));
-	if (!writeProgMemoryBlock(dmpMemory, MPU6050_DMP_CODE_SIZE)) return 1; // Failed
+	if (!writeProgMemoryBlockFast(dmpMemory, MPU6050_DMP_CODE_SIZE)) return 1; // Failed
 	DEBUG_PRINTLN(F("Success! DMP code written and verified."));
 
 	// Set the FIFO Rate Divisor int the DMP Firmware Memory
@@ -376,6 +376,56 @@ uint8_t MPU6050_6Axis_MotionApps20::dmpInitialize() {
 
 	return 0; // success
 }
+
+// Program code starts at 0x0300 (DMP_CFG_1/DMP_CFG_2) and is never written by the DMP itself,
+// unlike the data banks below it, so a few chunks of it identify a loaded image.
+#define MPU6050_DMP_SIGNATURE_CHUNKS 4
+static const uint16_t dmpSignatureAddress[MPU6050_DMP_SIGNATURE_CHUNKS] = {
+	0x0300, 0x0480, 0x0600, MPU6050_DMP_CODE_SIZE - MPU6050_DMP_MEMORY_CHUNK_SIZE
+};
+
+/** Check whether the sensor kept power across a host reset with the DMP image and the
+ * configuration written by dmpInitialize() still in place. If so, re-arm the FIFO and the
+ * DMP without resetting the chip or uploading the firmware (a few ms instead of the full
+ * initialization). The DMP is left disabled, as after dmpInitialize().
+ * @return 0 on success, 1 if the configuration registers differ, 2 if the image differs
+ */
+uint8_t MPU6050_6Axis_MotionApps20::dmpWarmStart() {
+	// configuration left by dmpInitialize() and by the application (DMP enabled)
+	if (getSleepEnabled() || getClockSource() != MPU6050_CLOCK_PLL_ZGYRO || !getDMPEnabled() ||
+		getDMPConfig1() != 0x03 || getDMPConfig2() != 0x00 || getRate() != 4 ||
+		getDLPFMode() != MPU6050_DLPF_BW_42 || getFullScaleGyroRange() != MPU6050_GYRO_FS_2000 ||
+		getFullScaleAccelRange() != MPU6050_ACCEL_FS_2) {
+		DEBUG_PRINTLN(F("Warm start: configuration registers differ."));
+		return 1;
+	}
+
+	uint8_t chunk[MPU6050_DMP_MEMORY_CHUNK_SIZE];
+	for (uint8_t i = 0; i < MPU6050_DMP_SIGNATURE_CHUNKS; i++) {
+		uint16_t address = dmpSignatureAddress[i];
+		readMemoryBlock(chunk, MPU6050_DMP_MEMORY_CHUNK_SIZE, address >> 8, address & 0xFF);
+		for (uint8_t j = 0; j < MPU6050_DMP_MEMORY_CHUNK_SIZE; j++) {
+			if (chunk[j] != pgm_read_byte(dmpMemory + address + j)) {
+				DEBUG_PRINTLN(F("Warm start: DMP image differs."));
+				return 2;
+			}
+		}
+	}
+
+	// the FIFO rate divisor lives in a data bank, so it is simply written again
+	unsigned char dmpUpdate[] = {0x00, MPU6050_DMP_FIFO_RATE_DIVISOR};
+	writeMemoryBlock(dmpUpdate, 0x02, 0x02, 0x16, false);
+
+	setDMPEnabled(false);
+	setFIFOEnabled(true);
+	resetFIFO();
+	resetDMP();
+	dmpPacketSize = 42;
+	getIntStatus();
+
+	DEBUG_PRINTLN(F("Warm start: DMP image reused."));
+	return 0; // success
+}
 // Nothing else changed
 
 bool MPU6050_6Axis_MotionApps20::dmpPacketAvailable() {
@@ -362,7 +362,7 @@ uint8_t MPU6050::dmpInitialize() { // Lets get it over with fast Write everythin
 	I2Cdev::writeBytes(devAddr,0x6B, 1, &(val = 0x01), wireObj); // 0000 0001 PWR_MGMT_1: Clock Source Select PLL_X_gyro
 	I2Cdev::writeBytes(devAddr,0x19, 1, &(val = 0x04), wireObj); // 0000 0100 SMPLRT_DIV: Divides the internal sample rate 400Hz ( Sample Rate = Gyroscope Output Rate / (1 + SMPLRT_DIV))
 	I2Cdev::writeBytes(devAddr,0x1A, 1, &(val = 0x01), wireObj); // 0000 0001 CONFIG: Digital Low Pass Filter (DLPF) Configuration 188HZ  //Im betting this will be the beat
-	if (!writeProgMemoryBlock(dmpMemory, MPU6050_DMP_CODE_SIZE)) return 1; // Loads the DMP image into the MPU6050 Memory // Should Never Fail
+	if (!writeProgMemoryBlockFast(dmpMemory, MPU6050_DMP_CODE_SIZE)) return 1; // Loads the DMP image into the MPU6050 Memory // Should Never Fail
 	I2Cdev::writeWords(devAddr, 0x70, 1, &(ival = 0x0400), wireObj); // DMP Program Start Address
 	I2Cdev::writeBytes(devAddr,0x1B, 1, &(val = 0x18), wireObj); // 0001 1000 GYRO_CONFIG: 3 = +2000 Deg/sec
 	I2Cdev::writeBytes(devAddr,0x6A, 1, &(val = 0xC0), wireObj); // 1100 1100 USER_CTRL: Enable Fifo and Reset Fifo
@@ -379,6 +379,52 @@ uint8_t MPU6050::dmpInitialize() { // Lets get it over with fast Write everythin
 	return 0;
 }
 
+// Program code starts at 0x0400 (written to DMP_CFG_1/DMP_CFG_2 above) and is never written by
+// the DMP itself, unlike the data banks below it, so a few chunks of it identify a loaded image.
+#define MPU6050_DMP_SIGNATURE_CHUNKS 4
+static const uint16_t dmpSignatureAddress[MPU6050_DMP_SIGNATURE_CHUNKS] = {
+	0x0400, 0x0700, 0x0A00, MPU6050_DMP_CODE_SIZE - MPU6050_DMP_MEMORY_CHUNK_SIZE
+};
+
+/** Check whether the sensor kept power across a host reset with the DMP image and the
+ * configuration written by dmpInitialize() still in place. If so, re-arm the FIFO and the
+ * DMP without resetting the chip or uploading the firmware. The DMP is left disabled, as
+ * after dmpInitialize(). The FIFO rate is part of the image, so nothing else is rewritten.
+ * @return 0 on success, 1 if the configuration registers differ, 2 if the image differs
+ */
+uint8_t MPU6050::dmpWarmStart() {
+	// configuration left by dmpInitialize() and by the application (DMP enabled)
+	if (getSleepEnabled() || getClockSource() != MPU6050_CLOCK_PLL_XGYRO || !getDMPEnabled() ||
+		getDMPConfig1() != 0x04 || getDMPConfig2() != 0x00 || getRate() != 4 ||
+		getDLPFMode() != MPU6050_DLPF_BW_188 || getFullScaleGyroRange() != MPU6050_GYRO_FS_2000 ||
+		getFullScaleAccelRange() != MPU6050_ACCEL_FS_2) {
+		DEBUG_PRINTLN(F("Warm start: configuration registers differ."));
+		return 1;
+	}
+
+	uint8_t chunk[MPU6050_DMP_MEMORY_CHUNK_SIZE];
+	for (uint8_t i = 0; i < MPU6050_DMP_SIGNATURE_CHUNKS; i++) {
+		uint16_t address = dmpSignatureAddress[i];
+		readMemoryBlock(chunk, MPU6050_DMP_MEMORY_CHUNK_SIZE, address >> 8, address & 0xFF);
+		for (uint8_t j = 0; j < MPU6050_DMP_MEMORY_CHUNK_SIZE; j++) {
+			if (chunk[j] != pgm_read_byte(dmpMemory + address + j)) {
+				DEBUG_PRINTLN(F("Warm start: DMP image differs."));
+				return 2;
+			}
+		}
+	}
+
+	setDMPEnabled(false);
+	setFIFOEnabled(true);
+	resetFIFO();
+	resetDMP();
+	dmpPacketSize = 28;
+	getIntStatus();
+
+	DEBUG_PRINTLN(F("Warm start: DMP image reused."));
+	return 0; // success
+}
+
 bool MPU6050::dmpPacketAvailable() {
     return getFIFOCount() >= dmpGetFIFOPacketSize();
 }
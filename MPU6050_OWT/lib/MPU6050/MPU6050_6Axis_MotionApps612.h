@@ -38,8 +38,12 @@ THE SOFTWARE.
 #ifndef _MPU6050_6AXIS_MOTIONAPPS612_H_
 #define _MPU6050_6AXIS_MOTIONAPPS612_H_
 
-// take ownership of the "MPU6050" typedef
+// take ownership of the "MPU6050" typedef, unless another MotionApps header already did
+// (several firmware classes can then be used in the same translation unit)
+#ifndef I2CDEVLIB_MPU6050_TYPEDEF
 #define I2CDEVLIB_MPU6050_TYPEDEF
+#define I2CDEVLIB_MPU6050_TYPEDEF_MOTIONAPPS612
+#endif
 
 #include "MPU6050.h"
 
@@ -48,6 +52,7 @@ class MPU6050_6Axis_MotionApps612 : public MPU6050_Base {
         MPU6050_6Axis_MotionApps612(uint8_t address=MPU6050_DEFAULT_ADDRESS, void *wireObj=0) : MPU6050_Base(address, wireObj) { }
 
         uint8_t dmpInitialize();
+        uint8_t dmpWarmStart(); // Re-arm a DMP that survived a host reset (0 = success)
         bool dmpPacketAvailable();
 
         uint8_t dmpSetFIFORate(uint8_t fifoRate);
@@ -148,6 +153,8 @@ class MPU6050_6Axis_MotionApps612 : public MPU6050_Base {
         uint16_t dmpPacketSize;
 };
 
+#ifdef I2CDEVLIB_MPU6050_TYPEDEF_MOTIONAPPS612
 typedef MPU6050_6Axis_MotionApps612 MPU6050;
+#endif
 
 #endif /* _MPU6050_6AXIS_MOTIONAPPS612_H_ */
@@ -0,0 +1,101 @@
+/**
+ * @file MPU6050_Calibration.h
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Controlador PI da calibração rápida dos offsets do MPU6050, com os seis
+ * eixos calibrados juntos e parada por convergência. Não depende do Arduino nem
+ * do barramento para poder ser executado também contra o simulador do host.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Ordem dos eixos em todos os vetores: acelerômetro X, Y, Z e giroscópio X, Y, Z.
+ * Leituras em LSB nas escalas padrão (±2 g e ±250 °/s); offsets nas unidades
+ * dos registradores (1 LSB = 8 LSB de leitura no acelerômetro e 4 no giroscópio).
+ */
+#ifndef _MPU6050_CALIBRATION_H_
+#define _MPU6050_CALIBRATION_H_
+
+#include <stdint.h>
+
+#define MPU6050_CALIBRATION_AXES 6
+#define MPU6050_CALIBRATION_PERIOD_US 1000        // Período de cada iteração (1 kHz).
+#define MPU6050_CALIBRATION_MAX_ITERATIONS 1500   // Limite de iterações sem convergência.
+#define MPU6050_CALIBRATION_MIN_ITERATIONS 30     // Iterações antes de avaliar a convergência.
+#define MPU6050_CALIBRATION_SETTLE_ITERATIONS 20  // Iterações consecutivas dentro da tolerância.
+#define MPU6050_CALIBRATION_ACCEL_TOLERANCE 8.0f  // Erro médio aceito no acelerômetro (LSB, ~0.5 mg).
+#define MPU6050_CALIBRATION_GYRO_TOLERANCE 2.0f   // Erro médio aceito no giroscópio (LSB, ~0.015 °/s).
+#define MPU6050_CALIBRATION_AVERAGE_WEIGHT 0.05f  // Peso da nova leitura na média móvel do erro.
+
+/**
+ * @brief Resultado da calibração rápida.
+ *
+ */
+struct MPU6050_CalibrationResult
+{
+    uint16_t iterations;  // Iterações executadas.
+    float accelResidual;  // Maior erro médio restante no acelerômetro (LSB).
+    float gyroResidual;   // Maior erro médio restante no giroscópio (LSB).
+    bool converged;       // Os seis eixos ficaram dentro da tolerância.
+};
+
+/**
+ * @brief Controlador PI dos seis offsets.
+ *
+ */
+class MPU6050_Calibrator
+{
+public:
+    /**
+     * @brief Inicia o controlador a partir dos offsets atuais.
+     *
+     * @param offsets Offsets atuais dos registradores.
+     * @param gravity Leitura de 1 g no eixo Z do acelerômetro (LSB).
+     * @param keepAccelBitZero Preserva o bit 0 dos offsets do acelerômetro (MPU6050).
+     */
+    void begin(const int16_t *offsets, uint16_t gravity, bool keepAccelBitZero);
+
+    /**
+     * @brief Executa uma iteração do controlador.
+     *
+     * @param reading Leituras brutas dos seis eixos.
+     * @param offsets Novos offsets que devem ser escritos nos registradores.
+     * @return true - Caso a calibração tenha convergido.
+     * @return false - Caso contrário.
+     */
+    bool update(const int16_t *reading, int16_t *offsets);
+
+    /**
+     * @brief Retorna os offsets finais (apenas o termo integral, sem o ruído do termo proporcional).
+     *
+     * @param offsets Offsets que devem ser escritos ao fim da calibração.
+     */
+    void getOffsets(int16_t *offsets);
+
+    /**
+     * @brief Retorna o resultado da calibração até o momento.
+     *
+     * @return MPU6050_CalibrationResult - Iterações e erro residual.
+     */
+    MPU6050_CalibrationResult getResult();
+
+private:
+    /**
+     * @brief Converte os termos do controlador em offsets.
+     *
+     * @param withProportional Inclui o termo proporcional.
+     * @param offsets Offsets calculados.
+     */
+    void computeOffsets(bool withProportional, int16_t *offsets);
+
+    float iTerm[MPU6050_CALIBRATION_AXES];   // Termo integral (unidades do registrador x escala).
+    float pTerm[MPU6050_CALIBRATION_AXES];   // Termo proporcional da última iteração.
+    float average[MPU6050_CALIBRATION_AXES]; // Média móvel do erro (LSB).
+    int16_t bitZero[3];                      // Bit 0 original dos offsets do acelerômetro.
+    bool keepBitZero;
+    uint16_t gravity;
+    uint16_t iterations;
+    uint16_t settled;
+};
+
+#endif /* _MPU6050_CALIBRATION_H_ */
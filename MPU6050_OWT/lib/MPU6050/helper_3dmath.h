@@ -213,4 +213,83 @@ class VectorFloat {
         }
 };
 
+class VectorInt32 {
+    public:
+        int32_t x;
+        int32_t y;
+        int32_t z;
+
+        VectorInt32() {
+            x = 0;
+            y = 0;
+            z = 0;
+        }
+
+        VectorInt32(int32_t nx, int32_t ny, int32_t nz) {
+            x = nx;
+            y = ny;
+            z = nz;
+        }
+};
+
+// Quaternion in the DMP's Q30 fixed point (1.0 = 1 << 30), as returned by
+// dmpGetQuaternion(int32_t *). The gravity vector is computed with integer
+// multiplies only (64-bit intermediates), so per-sample tilt checks need no
+// float conversion; floats are only used when the Euler angles are requested.
+class QuaternionQ30 {
+    public:
+        int32_t w;
+        int32_t x;
+        int32_t y;
+        int32_t z;
+
+        QuaternionQ30() {
+            w = (int32_t)1 << 30;
+            x = 0;
+            y = 0;
+            z = 0;
+        }
+
+        QuaternionQ30(const int32_t *data) {
+            w = data[0];
+            x = data[1];
+            y = data[2];
+            z = data[3];
+        }
+
+        // Same formulas as dmpGetGravity(VectorFloat *, Quaternion *), result in Q30.
+        VectorInt32 getGravity() {
+            return VectorInt32(
+                (int32_t)(((int64_t)x*z - (int64_t)w*y) >> 29),
+                (int32_t)(((int64_t)w*x + (int64_t)y*z) >> 29),
+                (int32_t)(((int64_t)w*w - (int64_t)x*x - (int64_t)y*y + (int64_t)z*z) >> 30));
+        }
+
+        Quaternion getQuaternion() {
+            const float scale = 1.0f / (float)((int32_t)1 << 30);
+            return Quaternion(w * scale, x * scale, y * scale, z * scale);
+        }
+
+        // Same convention as dmpGetYawPitchRoll(); gravity from getGravity().
+        // atan2 does not depend on scale, so pitch and roll use the raw Q30 values.
+        void getYawPitchRoll(float *data, VectorInt32 *gravity) {
+            Quaternion q = getQuaternion();
+            float gx = gravity -> x, gy = gravity -> y, gz = gravity -> z;
+
+            // yaw: (about Z axis)
+            data[0] = atan2f(2*q.x*q.y - 2*q.w*q.z, 2*q.w*q.w + 2*q.x*q.x - 1);
+            // pitch: (nose up/down, about Y axis)
+            data[1] = atan2f(gx, sqrtf(gy*gy + gz*gz));
+            // roll: (tilt left/right, about X axis)
+            data[2] = atan2f(gy, gz);
+            if (gz < 0) {
+                if (data[1] > 0) {
+                    data[1] = PI - data[1];
+                } else {
+                    data[1] = -PI - data[1];
+                }
+            }
+        }
+};
+
 #endif /* _HELPER_3DMATH_H_ */
\ No newline at end of file
@@ -12,34 +12,34 @@
 
 void WatcherClass::OnTipping(IMUTippingData_t data)
 {
-    Serial.printf("\n\n--- Tipping Data ---");
-    Serial.printf("\nTime: %d", data.StartTime);
-    Serial.printf("\nSide: %s", (data.Side == 0) ? "left" : "right");
+    Logger.printf("\n\n--- Tipping Data ---");
+    Logger.printf("\nTime: %d", data.StartTime);
+    Logger.printf("\nSide: %s", (data.Side == 0) ? "left" : "right");
     
     // for(auto axisData : data.AxisMeasurements)
     // {
-    //     Serial.printf("\n\n--- Axis data ---");
-    //     Serial.printf("\nAccX: %.2f", axisData.Acc_X);
-    //     Serial.printf("\nAccY: %.2f", axisData.Acc_Y);
-    //     Serial.printf("\nAccZ: %.2f", axisData.Acc_Z);
-    //     Serial.printf("\nGyroX: %.2f", axisData.Gyro_X);
-    //     Serial.printf("\nGyroY: %.2f", axisData.Gyro_Y);
-    //     Serial.printf("\nGyroZ: %.2f", axisData.Gyro_Z);
-    //     Serial.printf("\nYaw: %.2f", axisData.Yaw);
-    //     Serial.printf("\nPitch: %.2f", axisData.Pitch);
-    //     Serial.printf("\nRoll: %.2f", axisData.Roll);
-    //     Serial.printf("\nTime: %d", axisData.Time);
+    //     Logger.printf("\n\n--- Axis data ---");
+    //     Logger.printf("\nAccX: %.2f", axisData.Acc_X);
+    //     Logger.printf("\nAccY: %.2f", axisData.Acc_Y);
+    //     Logger.printf("\nAccZ: %.2f", axisData.Acc_Z);
+    //     Logger.printf("\nGyroX: %.2f", axisData.Gyro_X);
+    //     Logger.printf("\nGyroY: %.2f", axisData.Gyro_Y);
+    //     Logger.printf("\nGyroZ: %.2f", axisData.Gyro_Z);
+    //     Logger.printf("\nYaw: %.2f", axisData.Yaw);
+    //     Logger.printf("\nPitch: %.2f", axisData.Pitch);
+    //     Logger.printf("\nRoll: %.2f", axisData.Roll);
+    //     Logger.printf("\nTime: %d", axisData.Time);
     // }
 }
 
 void WatcherClass::OnMovement(IMUMovementData_t data)
 {
-    Serial.printf("\n\n--- Movement Data ---");
-    Serial.printf("\nTime: %d", data.StartTime);
+    Logger.printf("\n\n--- Movement Data ---");
+    Logger.printf("\nTime: %d", data.StartTime);
 }
 
 void WatcherClass::OnStop(IMUStopData_t data)
 {
-    Serial.printf("\n\n--- Stop Data ---");
-    Serial.printf("\nTime: %d", data.StartTime);
+    Logger.printf("\n\n--- Stop Data ---");
+    Logger.printf("\nTime: %d", data.StartTime);
 }
\ No newline at end of file
@@ -16,6 +16,11 @@ IMUSensor *imu;
 void setup() 
 {
     Serial.begin(115200);
+    Logger.begin(&Serial);
+
+#ifdef IMU_BENCHMARK
+    Benchmark.begin("OWT");
+#endif
     
     WatcherClass* watcher = new WatcherClass();
 
@@ -43,6 +48,12 @@ void setup()
 
 void loop() 
 { 
+#ifdef IMU_BENCHMARK
+    // A carga de trabalho volta a ficar parada, então a leitura não é interrompida.
+    Benchmark.handle();
+    delay(10);
+#else
     if(imu->getTippedState())
         imu->stop();
+#endif
 }
\ No newline at end of file
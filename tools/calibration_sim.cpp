@@ -0,0 +1,124 @@
+/**
+ * @file calibration_sim.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Executa, no host, o controlador da calibração rápida (MPU6050_Calibrator)
+ * contra um sensor simulado com bias, gravidade, ruído e filtro passa-baixas,
+ * imprimindo as iterações até a convergência e o erro residual de cada eixo.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Compilação:
+ *   g++ -O2 -I../MPU6050_NOWT/lib/MPU6050 calibration_sim.cpp \
+ *       ../MPU6050_NOWT/lib/MPU6050/MPU6050_Calibration.cpp -o calibration_sim
+ *
+ * Uso:
+ *   ./calibration_sim [ruído em LSB] [semente] [execuções]
+ */
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "MPU6050_Calibration.h"
+
+#define SIM_GRAVITY 16384     // 1 g em ±2 g (LSB).
+#define SIM_FILTER_WEIGHT 0.5 // Peso da nova amostra no filtro passa-baixas (DLPF).
+
+const double g_offsetScale[MPU6050_CALIBRATION_AXES] = {8, 8, 8, 4, 4, 4}; // LSB de leitura por LSB de offset.
+
+/**
+ * @brief Sensor simulado: a leitura é o bias mais a gravidade (eixo Z), corrigida
+ * pelos offsets escritos, com ruído gaussiano e filtrada como pelo DLPF.
+ */
+class SimulatedSensor
+{
+public:
+    SimulatedSensor(double noise, unsigned seed) : m_random(seed), m_noise(0, noise)
+    {
+        std::uniform_real_distribution<double> accelBias(-2000, 2000);
+        std::uniform_real_distribution<double> gyroBias(-300, 300);
+
+        for(int i = 0; i < MPU6050_CALIBRATION_AXES; i++)
+        {
+            m_bias[i] = (i < 3) ? accelBias(m_random) : gyroBias(m_random);
+            m_offsets[i] = 0;
+            m_filtered[i] = m_bias[i] + ((i == 2) ? SIM_GRAVITY : 0);
+        }
+    }
+
+    void read(int16_t *reading)
+    {
+        for(int i = 0; i < MPU6050_CALIBRATION_AXES; i++)
+        {
+            double value = m_bias[i] + m_offsets[i] * g_offsetScale[i] + m_noise(m_random);
+            if(i == 2)
+                value += SIM_GRAVITY;
+
+            m_filtered[i] += (value - m_filtered[i]) * SIM_FILTER_WEIGHT;
+            reading[i] = (int16_t)lround(m_filtered[i]);
+        }
+    }
+
+    void write(const int16_t *offsets)
+    {
+        for(int i = 0; i < MPU6050_CALIBRATION_AXES; i++)
+            m_offsets[i] = offsets[i];
+    }
+
+    double getError(int axis) const
+    {
+        return m_bias[axis] + m_offsets[axis] * g_offsetScale[axis];
+    }
+
+private:
+    std::mt19937 m_random;
+    std::normal_distribution<double> m_noise;
+    double m_bias[MPU6050_CALIBRATION_AXES];
+    double m_offsets[MPU6050_CALIBRATION_AXES];
+    double m_filtered[MPU6050_CALIBRATION_AXES];
+};
+
+int main(int argc, char **argv)
+{
+    double noise = (argc > 1) ? atof(argv[1]) : 4.0;
+    unsigned seed = (argc > 2) ? (unsigned)atoi(argv[2]) : 1;
+    int runs = (argc > 3) ? atoi(argv[3]) : 10;
+    int failures = 0;
+
+    printf("execucao iteracoes convergiu residuo_acel residuo_giro erro_final (ax ay az gx gy gz)\n");
+
+    for(int run = 0; run < runs; run++)
+    {
+        SimulatedSensor sensor(noise, seed + run);
+        MPU6050_Calibrator calibrator;
+        int16_t offsets[MPU6050_CALIBRATION_AXES] = {0};
+        int16_t reading[MPU6050_CALIBRATION_AXES];
+
+        calibrator.begin(offsets, SIM_GRAVITY, true);
+        for(int n = 0; n < MPU6050_CALIBRATION_MAX_ITERATIONS; n++)
+        {
+            sensor.read(reading);
+            bool done = calibrator.update(reading, offsets);
+            sensor.write(offsets);
+            if(done)
+                break;
+        }
+
+        calibrator.getOffsets(offsets);
+        sensor.write(offsets);
+
+        MPU6050_CalibrationResult result = calibrator.getResult();
+        if(!result.converged)
+            failures++;
+
+        printf("%8d %9u %9s %12.2f %12.2f ", run, result.iterations, result.converged ? "sim" : "nao",
+               result.accelResidual, result.gyroResidual);
+        for(int i = 0; i < MPU6050_CALIBRATION_AXES; i++)
+            printf(" %7.1f", sensor.getError(i));
+        printf("\n");
+    }
+
+    return (failures == 0) ? 0 : 2;
+}
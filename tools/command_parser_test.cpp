@@ -0,0 +1,117 @@
+/**
+ * @file command_parser_test.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Confere, no host, o CommandParser consultado como no
+ * MessageServiceClass::handle(): os bytes chegam em lotes a cada período do loop
+ * (200 ms no NOWT, 500 ms no NONT), e quadros divididos entre duas consultas não
+ * podem ser descartados por tempo.
+ * @version 0.1
+ * @date 19-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Compilação:
+ *   g++ -O2 -I../MPU6050_NOWT/lib/Framing/src command_parser_test.cpp \
+ *       ../MPU6050_NOWT/lib/Framing/src/Framing.cpp \
+ *       ../MPU6050_NOWT/lib/Framing/src/CommandParser.cpp -o command_parser_test
+ *
+ * Uso:
+ *   ./command_parser_test
+ */
+#include <cstdio>
+#include <cstring>
+
+#include "CommandParser.h"
+
+static int g_failures = 0;
+
+static void check(bool condition, const char *name)
+{
+    printf("%-52s %s\n", name, condition ? "ok" : "FALHOU");
+    if(!condition)
+        g_failures++;
+}
+
+/**
+ * @brief Uma chamada do handle(): entrega os bytes recebidos desde a anterior
+ * ou, sem bytes, informa a consulta vazia.
+ * @return int - Quadros válidos concluídos na chamada.
+ */
+static int poll(CommandParser &parser, const uint8_t *bytes, size_t count, uint32_t now)
+{
+    if(count == 0)
+    {
+        parser.idle(now);
+        return 0;
+    }
+
+    int frames = 0;
+    for(size_t i = 0; i < count; i++)
+        frames += parser.feed(bytes[i]) ? 1 : 0;
+
+    return frames;
+}
+
+int main()
+{
+    const uint8_t command[] = {0x90, 0x01, 17, 140};
+    uint8_t frame[sizeof(command) + COMMAND_FRAME_OVERHEAD];
+    size_t size = commandEncode(command, sizeof(command), frame);
+    const size_t half = size / 2;
+
+    // Quadro dividido entre duas chamadas no período do loop do NOWT e do NONT.
+    const uint32_t periods[] = {200, 500};
+    for(uint32_t period : periods)
+    {
+        CommandParser parser;
+        int frames = poll(parser, frame, half, 1000);
+        frames += poll(parser, frame + half, size - half, 1000 + period);
+
+        char name[64];
+        snprintf(name, sizeof(name), "quadro dividido com chamadas a %u ms", period);
+        check(frames == 1 && parser.getFramingErrors() == 0, name);
+        check(parser.getLength() == sizeof(command) && memcmp(parser.getPayload(), command, sizeof(command)) == 0,
+              "comando recebido intacto");
+    }
+
+    // Uma consulta vazia no meio do quadro ainda não o descarta.
+    {
+        CommandParser parser;
+        int frames = poll(parser, frame, half, 0);
+        frames += poll(parser, NULL, 0, 200);
+        frames += poll(parser, frame + half, size - half, 250);
+        check(frames == 1 && parser.getFramingErrors() == 0, "quadro retomado apos uma consulta vazia");
+    }
+
+    // Quadro abandonado: descartado após o silêncio, e o seguinte é aceito.
+    {
+        CommandParser parser;
+        int frames = poll(parser, frame, half, 0);
+        frames += poll(parser, NULL, 0, 200);
+        frames += poll(parser, NULL, 0, 400);
+        check(frames == 0 && parser.getFramingErrors() == 1, "quadro abandonado descartado");
+
+        frames = poll(parser, frame, size, 600);
+        check(frames == 1, "quadro seguinte aceito");
+    }
+
+    // Consultas vazias fora de um quadro não contam erro.
+    {
+        CommandParser parser;
+        for(uint32_t now = 0; now < 2000; now += 200)
+            poll(parser, NULL, 0, now);
+        check(parser.getFramingErrors() == 0, "silencio fora de quadro ignorado");
+    }
+
+    // CRC inválido.
+    {
+        CommandParser parser;
+        uint8_t corrupted[sizeof(frame)];
+        memcpy(corrupted, frame, size);
+        corrupted[2] ^= 0x01;
+        int frames = poll(parser, corrupted, size, 0);
+        check(frames == 0 && parser.getCRCErrors() == 1, "CRC invalido descartado");
+    }
+
+    return (g_failures == 0) ? 0 : 2;
+}
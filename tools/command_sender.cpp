@@ -0,0 +1,158 @@
+/**
+ * @file command_sender.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Monta, no host, o quadro de um comando do MessageService (NOWT e NONT).
+ * Sem porta informada o quadro é escrito na saída padrão; com a porta, o comando
+ * é enviado e a resposta do protocolo de configuração é aguardada e impressa.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Compilação:
+ *   g++ -O2 -I../MPU6050_NOWT/lib/Framing/src command_sender.cpp \
+ *       ../MPU6050_NOWT/lib/Framing/src/Framing.cpp \
+ *       ../MPU6050_NOWT/lib/Framing/src/CommandParser.cpp -o command_sender
+ *
+ * Uso (bytes do comando em hexadecimal):
+ *   stty -F /dev/ttyUSB0 115200 raw -echo
+ *   ./command_sender 70 03 > /dev/ttyUSB0
+ *   ./command_sender -p /dev/ttyUSB0 60 01 02 07
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "CommandParser.h"
+#include "ConfigProtocol.h"
+#include "Framing.h"
+
+#define RESPONSE_TIMEOUT 1000 // Tempo máximo de espera pela resposta (ms).
+
+const char *g_statusNames[] = {"ok", "versao_nao_suportada", "operacao_desconhecida", "malformado",
+                               "parametro_desconhecido", "fora_da_faixa", "nao_pronto"};
+
+/**
+ * @brief Retorna o tempo atual em milissegundos.
+ *
+ * @return uint32_t - Tempo atual (ms).
+ */
+uint32_t now()
+{
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Aguarda a resposta do protocolo de configuração com a sequência
+ * informada e a imprime em hexadecimal.
+ * @param port Descritor da porta serial.
+ * @param sequence Sequência do comando enviado.
+ * @return int - 0 caso a resposta tenha status OK.
+ */
+int waitResponse(int port, uint8_t sequence)
+{
+    CommandParser parser;
+    uint32_t start = now();
+
+    while(now() - start < RESPONSE_TIMEOUT)
+    {
+        uint8_t buffer[64];
+        ssize_t count = read(port, buffer, sizeof(buffer));
+
+        if(count <= 0)
+            parser.idle(now());
+
+        for(ssize_t i = 0; i < count; i++)
+        {
+            if(!parser.feed(buffer[i]))
+                continue;
+
+            const uint8_t *payload = parser.getPayload();
+            uint8_t length = parser.getLength();
+            if(length < CONFIG_HEADER_SIZE + 1 || payload[0] != CONFIG_RESPONSE || payload[3] != sequence)
+                continue;
+
+            uint8_t status = payload[4];
+            printf("status=%s", (status <= CONFIG_STATUS_NOT_READY) ? g_statusNames[status] : "?");
+            for(uint8_t j = CONFIG_HEADER_SIZE + 1; j < length; j++)
+                printf(" %02x", payload[j]);
+            printf("\n");
+
+            return (status == CONFIG_STATUS_OK) ? 0 : 2;
+        }
+
+        if(count <= 0)
+            usleep(1000);
+    }
+
+    fprintf(stderr, "Sem resposta.\n");
+    return 3;
+}
+
+int main(int argc, char **argv)
+{
+    const char *portName = NULL;
+    int first = 1;
+
+    if(argc > 2 && strcmp(argv[1], "-p") == 0)
+    {
+        portName = argv[2];
+        first = 3;
+    }
+
+    int length = argc - first;
+    if(length < 1 || length > COMMAND_MAX_PAYLOAD)
+    {
+        fprintf(stderr, "Uso: %s [-p porta] <byte hex> [byte hex ...] (até %d bytes)\n", argv[0], COMMAND_MAX_PAYLOAD);
+        return 1;
+    }
+
+    uint8_t payload[COMMAND_MAX_PAYLOAD];
+    for(int i = 0; i < length; i++)
+    {
+        char *end;
+        unsigned long value = strtoul(argv[first + i], &end, 16);
+        if(*end != '\0' || value > 0xFF)
+        {
+            fprintf(stderr, "Byte inválido: %s\n", argv[first + i]);
+            return 1;
+        }
+        payload[i] = (uint8_t)value;
+    }
+
+    uint8_t frame[COMMAND_MAX_PAYLOAD + COMMAND_FRAME_OVERHEAD];
+    size_t size = commandEncode(payload, (uint8_t)length, frame);
+
+    if(portName == NULL)
+    {
+        fwrite(frame, 1, size, stdout);
+        fflush(stdout);
+        return 0;
+    }
+
+    int port = open(portName, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if(port < 0)
+    {
+        perror(portName);
+        return 1;
+    }
+
+    if(write(port, frame, size) != (ssize_t)size)
+    {
+        perror("write");
+        close(port);
+        return 1;
+    }
+
+    // Apenas os comandos de configuração possuem resposta.
+    int result = 0;
+    if(payload[0] == CONFIG_COMMAND && length >= CONFIG_HEADER_SIZE)
+        result = waitResponse(port, payload[3]);
+
+    close(port);
+    return result;
+}
@@ -0,0 +1,327 @@
+/**
+ * @file fusion_bench.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Compara, no host, a fusão por software (IMUFusion.h, Madgwick e Mahony) com o
+ * DMP: o filtro roda sobre o acelerômetro e o giroscópio brutos dos pacotes do
+ * MotionApps 6.12 de um log I2C gravado pelo firmware, e o Yaw, Pitch e Roll resultantes
+ * são comparados com os do quaternion do DMP no mesmo pacote. Também mede o custo de
+ * cada filtro e da conversão do quaternion do DMP por amostra.
+ * @version 0.1
+ * @date 19-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Compilação:
+ *   g++ -O2 -I../MPU6050_NOWT/lib/I2Cdev -I../MPU6050_NOWT/lib/IMUSensorLib/include fusion_bench.cpp \
+ *       ../MPU6050_NOWT/lib/I2Cdev/I2CdevRecorder.cpp ../MPU6050_NOWT/lib/IMUSensorLib/src/IMUFusion.cpp \
+ *       -o fusion_bench
+ *
+ * Uso (log gravado com -D IMU_I2C_RECORD -D IMU_DMP_MOTIONAPPS612, extraído com i2c_replay):
+ *   ./fusion_bench campo.i2c [beta] [kp] [ki] [LSB do giroscópio por °/s]
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "I2CdevRecorder.h"
+#include "IMUFusion.h"
+
+#define MPU6050_ADDRESS 0x68
+#define REG_FIFO_R_W 0x74
+#define PACKET_SIZE 28          // Pacote do MotionApps 6.12: quaternion Q30, acelerômetro e giroscópio.
+#define GYRO_SCALE 16.4         // LSB por °/s do giroscópio em ±2000 °/s (configurado pelo DMP).
+#define SETTLE_TIME 1.0         // Tempo inicial fora das estatísticas (s).
+#define EULER_LIMIT 60.0        // Pitch ou Roll do DMP acima do qual os ângulos de Euler ficam fora das estatísticas (graus).
+#define BENCH_REPETITIONS 100   // Passadas sobre os pacotes no benchmark de tempo.
+
+static const double g_degree = 180 / M_PI;
+
+/**
+ * @brief Amostra de um pacote: ângulos do DMP e leituras brutas.
+ *
+ */
+struct Sample
+{
+    double time;           // Tempo da leitura do FIFO (s).
+    double q[4];           // Quaternion do DMP (W, X, Y, Z).
+    float acc[3];          // Acelerômetro (LSB).
+    float gyro[3];         // Giroscópio (rad/s).
+};
+
+/**
+ * @brief Erro acumulado de um ângulo.
+ *
+ */
+struct Error
+{
+    double sum = 0;
+    double max = 0;
+    unsigned count = 0;
+
+    void add(double value)
+    {
+        sum += value * value;
+        count++;
+        if(fabs(value) > max)
+            max = fabs(value);
+    }
+
+    double rms() const
+    {
+        return (count > 0) ? sqrt(sum / count) : 0;
+    }
+};
+
+/**
+ * @brief Lê um arquivo inteiro.
+ *
+ */
+static bool readFile(const char *path, std::vector<uint8_t> &data)
+{
+    FILE *file = fopen(path, "rb");
+    if(file == NULL)
+        return false;
+
+    uint8_t buffer[4096];
+    size_t length;
+    while((length = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        data.insert(data.end(), buffer, buffer + length);
+
+    fclose(file);
+    return true;
+}
+
+static inline int32_t be32(const uint8_t *data)
+{
+    return (int32_t)(((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3]);
+}
+
+static inline int16_t be16(const uint8_t *data)
+{
+    return (int16_t)((data[0] << 8) | data[1]);
+}
+
+/**
+ * @brief Yaw, Pitch e Roll como dmpGetGravity() e dmpGetYawPitchRoll() (rad).
+ *
+ */
+template <typename T>
+static void yawPitchRoll(const T *q, T *ypr)
+{
+    T gx = 2 * (q[1] * q[3] - q[0] * q[2]);
+    T gy = 2 * (q[0] * q[1] + q[2] * q[3]);
+    T gz = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+
+    ypr[0] = atan2(2 * q[1] * q[2] - 2 * q[0] * q[3], 2 * q[0] * q[0] + 2 * q[1] * q[1] - 1);
+    ypr[1] = atan2(gx, sqrt(gy * gy + gz * gz));
+    ypr[2] = atan2(gy, gz);
+    if(gz < 0)
+        ypr[1] = (ypr[1] > 0) ? M_PI - ypr[1] : -M_PI - ypr[1];
+}
+
+/**
+ * @brief Gravidade de um quaternion, como dmpGetGravity() (normalizada).
+ *
+ */
+template <typename T>
+static void gravity(const T *q, double *g)
+{
+    g[0] = 2 * (q[1] * q[3] - q[0] * q[2]);
+    g[1] = 2 * (q[0] * q[1] + q[2] * q[3]);
+    g[2] = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+
+    double norm = sqrt(g[0] * g[0] + g[1] * g[1] + g[2] * g[2]);
+    for(int i = 0; i < 3; i++)
+        g[i] /= norm;
+}
+
+/**
+ * @brief Diferença entre dois ângulos em (-180, 180] graus.
+ *
+ */
+static double wrap(double angle)
+{
+    while(angle > 180)
+        angle -= 360;
+    while(angle <= -180)
+        angle += 360;
+    return angle;
+}
+
+/**
+ * @brief Roda um algoritmo sobre as amostras e imprime o erro em relação ao DMP.
+ *
+ */
+static void compare(const char *name, IMUFusionAlgorithm_e algorithm, const IMUFusionGains_t &gains,
+                    const std::vector<Sample> &samples, float period)
+{
+    IMUFusion fusion;
+    fusion.setAlgorithm(algorithm);
+    fusion.setGains(gains);
+    fusion.reset(samples[0].acc);
+
+    Error errors[3], tilt;
+    double yawOffset = 0;
+    bool aligned = false;
+    float ypr[3], q[4];
+    double dmp[3], filterGravity[3], dmpGravity[3];
+
+    for(const Sample &sample : samples)
+    {
+        fusion.update(sample.gyro, sample.acc, period);
+        if(sample.time - samples[0].time < SETTLE_TIME)
+            continue;
+
+        // Inclinação: ângulo entre as gravidades, sem as singularidades dos ângulos de Euler.
+        fusion.getQuaternion(q);
+        gravity(q, filterGravity);
+        gravity(sample.q, dmpGravity);
+        double dot = filterGravity[0] * dmpGravity[0] + filterGravity[1] * dmpGravity[1] + filterGravity[2] * dmpGravity[2];
+        tilt.add(acos(fmin(1.0, fmax(-1.0, dot))) * g_degree);
+
+        fusion.getYawPitchRoll(ypr);
+        yawPitchRoll(sample.q, dmp);
+
+        // Perto de ±90° de pitch o Yaw e o Roll não são definidos, e perto de ±90° de roll
+        // a correção do pitch de dmpGetYawPitchRoll() troca de lado com o sinal da gravidade.
+        if(fabs(dmp[1] * g_degree) > EULER_LIMIT || fabs(dmp[2] * g_degree) > EULER_LIMIT)
+            continue;
+
+        // O Yaw não tem referência absoluta: os dois são comparados a partir do primeiro
+        // instante fora do tempo de acomodação.
+        if(!aligned)
+        {
+            yawOffset = wrap((ypr[0] - dmp[0]) * g_degree);
+            aligned = true;
+        }
+
+        errors[0].add(wrap((ypr[0] - dmp[0]) * g_degree - yawOffset));
+        errors[1].add(wrap((ypr[1] - dmp[1]) * g_degree));
+        errors[2].add(wrap((ypr[2] - dmp[2]) * g_degree));
+    }
+
+    printf("%-8s erro (graus, rms/max): inclinacao %.2f/%.2f | yaw %.2f/%.2f | pitch %.2f/%.2f | roll %.2f/%.2f (%u de %u amostras com |pitch| e |roll| < %.0f)\n",
+           name, tilt.rms(), tilt.max, errors[0].rms(), errors[0].max, errors[1].rms(), errors[1].max, errors[2].rms(),
+           errors[2].max, errors[1].count, tilt.count, EULER_LIMIT);
+}
+
+/**
+ * @brief Mede o tempo por amostra de um algoritmo (passo do filtro e Yaw, Pitch e Roll).
+ *
+ */
+static void benchmark(const char *name, IMUFusionAlgorithm_e algorithm, const IMUFusionGains_t &gains,
+                      const std::vector<Sample> &samples, float period)
+{
+    IMUFusion fusion;
+    fusion.setAlgorithm(algorithm);
+    fusion.setGains(gains);
+    fusion.reset(samples[0].acc);
+
+    float ypr[3];
+    double checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(int r = 0; r < BENCH_REPETITIONS; r++)
+        for(const Sample &sample : samples)
+        {
+            fusion.update(sample.gyro, sample.acc, period);
+            fusion.getYawPitchRoll(ypr);
+            checksum += ypr[0];
+        }
+    double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%-8s %.1f ns por amostra (checksum %.3f)\n", name, elapsed / ((double)BENCH_REPETITIONS * samples.size()), checksum);
+}
+
+int main(int argc, char **argv)
+{
+    if(argc < 2)
+    {
+        fprintf(stderr, "uso: %s <log> [beta] [kp] [ki] [LSB do giroscopio por grau/s]\n", argv[0]);
+        return 1;
+    }
+
+    IMUFusionGains_t gains;
+    gains.Beta = (argc > 2) ? atof(argv[2]) : IMU_FUSION_MADGWICK_BETA;
+    gains.Kp = (argc > 3) ? atof(argv[3]) : IMU_FUSION_MAHONY_KP;
+    gains.Ki = (argc > 4) ? atof(argv[4]) : IMU_FUSION_MAHONY_KI;
+    double gyroScale = (argc > 5) ? atof(argv[5]) : GYRO_SCALE;
+
+    std::vector<uint8_t> log;
+    I2Cdev_LogReader reader;
+    if(!readFile(argv[1], log) || !reader.begin(log.data(), log.size()))
+    {
+        fprintf(stderr, "%s nao e um log I2C (versao %d)\n", argv[1], I2CDEV_LOG_VERSION);
+        return 1;
+    }
+
+    std::vector<Sample> samples;
+    I2Cdev_LogRecord record;
+    uint32_t firstRead = 0, lastRead = 0, firstPackets = 0;
+
+    while(reader.next(&record))
+    {
+        if(record.devAddr != MPU6050_ADDRESS || record.regAddr != REG_FIFO_R_W || (record.flags & I2CDEV_LOG_READ) == 0
+           || (record.flags & I2CDEV_LOG_FAILED) != 0 || record.length % PACKET_SIZE != 0)
+            continue;
+
+        if(samples.empty())
+        {
+            firstRead = record.time;
+            firstPackets = record.length / PACKET_SIZE;
+        }
+        lastRead = record.time;
+
+        for(uint16_t offset = 0; offset < record.length; offset += PACKET_SIZE)
+        {
+            const uint8_t *packet = &record.data[offset];
+            Sample sample;
+            sample.time = record.time / 1e6;
+            for(int i = 0; i < 4; i++)
+                sample.q[i] = be32(&packet[4 * i]) / 1073741824.0;
+            for(int i = 0; i < 3; i++)
+            {
+                sample.acc[i] = be16(&packet[16 + 2 * i]);
+                sample.gyro[i] = be16(&packet[22 + 2 * i]) / gyroScale / g_degree;
+            }
+            samples.push_back(sample);
+        }
+    }
+
+    if(samples.size() <= firstPackets || lastRead == firstRead)
+    {
+        fprintf(stderr, "o log nao tem pacotes de %d bytes suficientes (gravado com o MotionApps 6.12?)\n", PACKET_SIZE);
+        return 2;
+    }
+
+    // Os pacotes são espaçados pelo relógio do sensor: o período vem da média da captura.
+    float period = (lastRead - firstRead) / 1e6 / (samples.size() - firstPackets);
+    printf("pacotes: %zu em %.1f s (%.1f Hz)\n", samples.size(), (lastRead - firstRead) / 1e6, 1 / period);
+    printf("ganhos: beta %.3f | kp %.3f | ki %.3f | giroscopio %.2f LSB/(grau/s)\n", gains.Beta, gains.Kp, gains.Ki, gyroScale);
+
+    compare("Madgwick", IMU_FUSION_MADGWICK, gains, samples, period);
+    compare("Mahony", IMU_FUSION_MAHONY, gains, samples, period);
+
+    benchmark("Madgwick", IMU_FUSION_MADGWICK, gains, samples, period);
+    benchmark("Mahony", IMU_FUSION_MAHONY, gains, samples, period);
+
+    // Referência: o caminho do DMP no firmware (quaternion para float, gravidade e YPR com a libm).
+    float q[4], ypr[3];
+    double checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(int r = 0; r < BENCH_REPETITIONS; r++)
+        for(const Sample &sample : samples)
+        {
+            for(int i = 0; i < 4; i++)
+                q[i] = (float)sample.q[i];
+            yawPitchRoll(q, ypr);
+            checksum += ypr[0];
+        }
+    double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    printf("DMP      %.1f ns por amostra (so a conversao do quaternion, checksum %.3f)\n",
+           elapsed / ((double)BENCH_REPETITIONS * samples.size()), checksum);
+
+    return 0;
+}
@@ -0,0 +1,202 @@
+/**
+ * @file i2c_queue_sim.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Executa, no host, a fila de transações do backend assíncrono do I2Cdev
+ * (I2Cdev_Queue) contra um barramento simulado com o mapa de registradores de um
+ * MPU6050, tempo de barramento a 400 kHz e falhas injetadas, conferindo ordem,
+ * callbacks, palavras de 16 bits, cancelamento e fila cheia.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Compilação:
+ *   g++ -O2 -I../MPU6050_NOWT/lib/I2Cdev i2c_queue_sim.cpp \
+ *       ../MPU6050_NOWT/lib/I2Cdev/I2CdevQueue.cpp -o i2c_queue_sim
+ *
+ * Uso:
+ *   ./i2c_queue_sim [amostras] [processamento por amostra em us]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "I2CdevQueue.h"
+
+#define SIM_BUS_FREQUENCY 400000 // Hz
+#define SIM_DEVICE 0x68          // Endereço do MPU6050.
+#define SIM_PACKET_SIZE 42       // Pacote do DMP (MotionApps 2.0).
+
+/**
+ * @brief Barramento simulado: 256 registradores de um único dispositivo, tempo
+ * de cada transação em bits de clock e falha (NACK) a cada failEvery transações.
+ */
+class SimulatedBus : public I2Cdev_Bus
+{
+public:
+    SimulatedBus()
+    {
+        memset(registers, 0, sizeof(registers));
+        transactions = 0;
+        busTime = 0;
+        failEvery = 0;
+    }
+
+    bool transfer(uint8_t devAddr, uint8_t regAddr, bool read, uint8_t *data, uint16_t length) override
+    {
+        transactions++;
+
+        // START, endereço, registrador, (repeated START, endereço), dados e STOP: 9 clocks por byte.
+        uint32_t bytes = 2 + (read ? 1 : 0) + length;
+        busTime += bytes * 9 * 1000000.0 / SIM_BUS_FREQUENCY;
+
+        if(devAddr != SIM_DEVICE || (failEvery > 0 && transactions % failEvery == 0))
+            return false;
+
+        for(uint16_t i = 0; i < length; i++)
+        {
+            uint8_t reg = (uint8_t)(regAddr + i);
+            if(read) data[i] = registers[reg];
+            else registers[reg] = data[i];
+        }
+
+        return true;
+    }
+
+    uint8_t registers[256];
+    uint32_t transactions;
+    double busTime;      // Tempo total ocupado (us).
+    uint32_t failEvery;  // 0 = sem falhas.
+};
+
+static int g_failures = 0;
+
+static void check(bool condition, const char *name)
+{
+    printf("%-52s %s\n", name, condition ? "ok" : "FALHOU");
+    if(!condition)
+        g_failures++;
+}
+
+static void countCallback(I2Cdev_Transaction *, void *context)
+{
+    (*(int *)context)++;
+}
+
+struct OrderLog
+{
+    uint8_t order[8];
+    uint8_t count;
+};
+
+static void orderCallback(I2Cdev_Transaction *transaction, void *context)
+{
+    OrderLog *log = (OrderLog *)context;
+    log->order[log->count++] = transaction->regAddr;
+}
+
+int main(int argc, char **argv)
+{
+    int samples = (argc > 1) ? atoi(argv[1]) : 1000;
+    double compute = (argc > 2) ? atof(argv[2]) : 900.0;
+
+    SimulatedBus bus;
+    I2Cdev_Queue queue(&bus);
+
+    // Escrita e leitura de bytes.
+    uint8_t config[3] = {0x03, 0x18, 0x00};
+    uint8_t readBack[3] = {0};
+    I2Cdev_Transaction write, read;
+    I2Cdev_Queue::prepare(&write, SIM_DEVICE, 0x1A, 0, 3, config);
+    I2Cdev_Queue::prepare(&read, SIM_DEVICE, 0x1A, I2CDEV_TRANSACTION_READ, 3, readBack);
+    queue.submit(&write);
+    queue.submit(&read);
+    check(queue.service() == 2, "duas transacoes atendidas");
+    check(read.status == I2CDEV_TRANSACTION_DONE && memcmp(config, readBack, 3) == 0, "leitura devolve o que foi escrito");
+
+    // Palavras de 16 bits: MSB primeiro no barramento, buffer de escrita intacto.
+    uint16_t offsets[3] = {0x1234, 0xFF38, 0x0007};
+    uint16_t offsetsBack[3] = {0};
+    I2Cdev_Queue::prepare(&write, SIM_DEVICE, 0x06, I2CDEV_TRANSACTION_WORDS, 3, offsets);
+    I2Cdev_Queue::prepare(&read, SIM_DEVICE, 0x06, I2CDEV_TRANSACTION_READ | I2CDEV_TRANSACTION_WORDS, 3, offsetsBack);
+    queue.submit(&write);
+    queue.submit(&read);
+    queue.service();
+    check(bus.registers[0x06] == 0x12 && bus.registers[0x07] == 0x34 && bus.registers[0x09] == 0x38, "palavras em ordem MSB primeiro");
+    check(offsets[0] == 0x1234 && offsets[1] == 0xFF38, "buffer de escrita restaurado");
+    check(memcmp(offsets, offsetsBack, sizeof(offsets)) == 0, "palavras lidas de volta");
+
+    // Ordem de envio e callbacks.
+    OrderLog log = {{0}, 0};
+    uint8_t values[5];
+    I2Cdev_Transaction batch[5];
+    for(int i = 0; i < 5; i++)
+    {
+        I2Cdev_Queue::prepare(&batch[i], SIM_DEVICE, 0x20 + i, I2CDEV_TRANSACTION_READ, 1, &values[i], orderCallback, &log);
+        queue.submit(&batch[i]);
+    }
+    queue.service();
+    bool ordered = log.count == 5;
+    for(int i = 0; i < log.count; i++)
+        ordered = ordered && log.order[i] == 0x20 + i;
+    check(ordered, "callbacks na ordem de envio");
+
+    // Cancelamento: a posição é descartada sem tocar na transação.
+    int callbacks = 0;
+    I2Cdev_Transaction first, canceled, last;
+    I2Cdev_Queue::prepare(&first, SIM_DEVICE, 0x1A, I2CDEV_TRANSACTION_READ, 1, values, countCallback, &callbacks);
+    I2Cdev_Queue::prepare(&canceled, SIM_DEVICE, 0x1B, I2CDEV_TRANSACTION_READ, 1, values, countCallback, &callbacks);
+    I2Cdev_Queue::prepare(&last, SIM_DEVICE, 0x1C, I2CDEV_TRANSACTION_READ, 1, values, countCallback, &callbacks);
+    queue.submit(&first);
+    queue.submit(&canceled);
+    queue.submit(&last);
+    check(queue.cancel(&canceled), "cancelamento de transacao pendente");
+    memset(&canceled, 0xA5, sizeof(canceled)); // Simula a liberação da pilha de quem cancelou.
+    check(queue.service() == 2 && callbacks == 2, "transacao cancelada nao executada");
+    check(!queue.cancel(&first), "transacao concluida nao pode ser cancelada");
+
+    // Fila cheia e reenvio de transação pendente.
+    I2Cdev_Transaction full[I2CDEV_QUEUE_LENGTH + 1];
+    int accepted = 0;
+    for(int i = 0; i <= I2CDEV_QUEUE_LENGTH; i++)
+    {
+        I2Cdev_Queue::prepare(&full[i], SIM_DEVICE, 0x3B, I2CDEV_TRANSACTION_READ, 1, values);
+        accepted += queue.submit(&full[i]) ? 1 : 0;
+    }
+    check(accepted == I2CDEV_QUEUE_LENGTH, "fila recusa alem da capacidade");
+    check(!queue.submit(&full[0]), "transacao pendente nao entra duas vezes");
+    queue.service();
+    check(queue.pending() == 0 && queue.getHighWaterMark() == I2CDEV_QUEUE_LENGTH, "fila vazia e pico registrado");
+
+    // Falhas do barramento chegam ao status.
+    bus.failEvery = 2;
+    bus.transactions = 0;
+    int failed = 0;
+    for(int i = 0; i < 4; i++)
+    {
+        I2Cdev_Queue::prepare(&batch[i], SIM_DEVICE, 0x3B, I2CDEV_TRANSACTION_READ, 1, values);
+        queue.submit(&batch[i]);
+    }
+    queue.service();
+    for(int i = 0; i < 4; i++)
+        failed += (batch[i].status == I2CDEV_TRANSACTION_FAILED) ? 1 : 0;
+    check(failed == 2, "falhas injetadas reportadas");
+    bus.failEvery = 0;
+
+    // Leitura do pacote seguinte sobreposta ao processamento do anterior.
+    uint8_t packets[2][SIM_PACKET_SIZE];
+    double before = bus.busTime;
+    I2Cdev_Transaction fifo;
+    I2Cdev_Queue::prepare(&fifo, SIM_DEVICE, 0x74, I2CDEV_TRANSACTION_READ, SIM_PACKET_SIZE, packets[0]);
+    queue.submit(&fifo);
+    queue.service();
+    double packetTime = bus.busTime - before;
+
+    double blocking = samples * (packetTime + compute);
+    double overlapped = packetTime + (samples - 1) * (packetTime > compute ? packetTime : compute) + compute;
+    printf("\npacote de %d bytes: %.1f us no barramento; processamento: %.1f us\n", SIM_PACKET_SIZE, packetTime, compute);
+    printf("%d amostras: bloqueante %.1f ms, sobreposto %.1f ms (%.0f%% do tempo)\n", samples, blocking / 1000,
+           overlapped / 1000, 100.0 * overlapped / blocking);
+
+    return (g_failures == 0) ? 0 : 2;
+}
@@ -0,0 +1,339 @@
+/**
+ * @file i2c_replay.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Reproduz, no host, um log de transações I2C gravado pelo firmware
+ * (I2CdevRecorder.h): o log é o barramento (I2Cdev_Replayer) de uma fila I2Cdev_Queue,
+ * e as respostas do sensor são analisadas (carga do DMP, contagem e overflows do FIFO,
+ * pacotes corrompidos) e usadas para medir o tempo do decodificador de pacotes.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Compilação:
+ *   g++ -O2 -I../MPU6050_NOWT/lib/I2Cdev -I../MPU6050_NOWT/lib/Framing/src i2c_replay.cpp \
+ *       ../MPU6050_NOWT/lib/I2Cdev/I2CdevRecorder.cpp ../MPU6050_NOWT/lib/I2Cdev/I2CdevQueue.cpp \
+ *       ../MPU6050_NOWT/lib/Framing/src/Framing.cpp -o i2c_replay
+ *
+ * Uso:
+ *   stty -F /dev/ttyUSB0 115200 raw -echo
+ *   cat /dev/ttyUSB0 > captura.bin            (enquanto o comando [70][08] envia o log)
+ *   ./i2c_replay extract captura.bin campo.i2c
+ *   ./i2c_replay campo.i2c [tamanho do pacote] [repetições do benchmark]
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "Framing.h"
+#include "I2CLogProtocol.h"
+#include "I2CdevQueue.h"
+#include "I2CdevRecorder.h"
+
+#define MPU6050_ADDRESS 0x68
+#define REG_INT_STATUS 0x3A
+#define REG_USER_CTRL 0x6A
+#define REG_MEM_R_W 0x6F
+#define REG_FIFO_COUNTH 0x72
+#define REG_FIFO_R_W 0x74
+
+#define INT_STATUS_FIFO_OFLOW 0x10 // Bit de overflow do FIFO no INT_STATUS.
+#define USER_CTRL_FIFO_RESET 0x04  // Bit de reset do FIFO no USER_CTRL.
+#define FIFO_SIZE 1024             // Tamanho do FIFO do MPU6050 (bytes).
+#define QUATERNION_TOLERANCE 0.02  // Desvio máximo da norma do quaternion de um pacote íntegro.
+
+/**
+ * @brief Lê um arquivo inteiro.
+ *
+ */
+static bool readFile(const char *path, std::vector<uint8_t> &data)
+{
+    FILE *file = fopen(path, "rb");
+    if(file == NULL)
+        return false;
+
+    uint8_t buffer[4096];
+    size_t length;
+    while((length = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        data.insert(data.end(), buffer, buffer + length);
+
+    fclose(file);
+    return true;
+}
+
+/**
+ * @brief Remonta o log a partir dos quadros I2CLOG_FRAME_BLOCK de uma captura da serial.
+ *
+ * @return int - 0 se o log estiver completo, 2 caso contrário.
+ */
+static int extract(const char *capturePath, const char *logPath)
+{
+    std::vector<uint8_t> capture;
+    if(!readFile(capturePath, capture))
+    {
+        fprintf(stderr, "nao foi possivel abrir %s\n", capturePath);
+        return 1;
+    }
+
+    std::vector<std::vector<uint8_t>> blocks;
+    uint32_t frames = 0, invalid = 0;
+    uint8_t frame[FRAMING_COBS_MAX_SIZE(I2CLOG_MAX_FRAME_SIZE)];
+
+    size_t start = 0;
+    for(size_t i = 0; i < capture.size(); i++)
+    {
+        if(capture[i] != FRAMING_DELIMITER)
+            continue;
+
+        size_t length = i - start;
+        size_t offset = start;
+        start = i + 1;
+        if(length == 0)
+            continue;
+
+        // Texto do Logger e quadros de telemetria também chegam aqui e são ignorados.
+        size_t size = (length <= sizeof(frame)) ? cobsDecode(&capture[offset], length, frame) : 0;
+        if(size < I2CLOG_HEADER_SIZE + I2CLOG_CRC_SIZE || frame[0] != I2CLOG_FRAME_BLOCK)
+            continue;
+
+        uint16_t crc = frame[size - 2] | (frame[size - 1] << 8);
+        if(crc16CCITT(frame, size - I2CLOG_CRC_SIZE) != crc)
+        {
+            invalid++;
+            continue;
+        }
+
+        uint16_t block = frame[1] | (frame[2] << 8);
+        uint16_t total = frame[3] | (frame[4] << 8);
+        if(blocks.size() != total)
+            blocks.assign(total, std::vector<uint8_t>());
+        if(block < total)
+            blocks[block].assign(frame + I2CLOG_HEADER_SIZE, frame + size - I2CLOG_CRC_SIZE);
+        frames++;
+    }
+
+    uint32_t missing = 0;
+    std::vector<uint8_t> log;
+    for(size_t i = 0; i < blocks.size(); i++)
+    {
+        if(blocks[i].empty())
+        {
+            if(missing++ < 10)
+                fprintf(stderr, "bloco %zu ausente\n", i);
+            continue;
+        }
+        log.insert(log.end(), blocks[i].begin(), blocks[i].end());
+    }
+
+    printf("quadros: %u validos, %u com CRC invalido; blocos: %zu, ausentes: %u\n", frames, invalid, blocks.size(), missing);
+    if(blocks.empty() || missing > 0)
+    {
+        fprintf(stderr, "log incompleto: repita o envio ([70][08])\n");
+        return 2;
+    }
+
+    FILE *file = fopen(logPath, "wb");
+    if(file == NULL || fwrite(log.data(), 1, log.size(), file) != log.size())
+    {
+        fprintf(stderr, "nao foi possivel gravar %s\n", logPath);
+        return 1;
+    }
+    fclose(file);
+
+    printf("log de %zu bytes gravado em %s\n", log.size(), logPath);
+    return 0;
+}
+
+/**
+ * @brief Quaternion de um pacote do DMP (MotionApps 2.0), como MPU6050::dmpGetQuaternion.
+ *
+ */
+struct Quaternion
+{
+    double w, x, y, z;
+};
+
+static inline Quaternion decodePacket(const uint8_t *packet)
+{
+    Quaternion q;
+    q.w = (int16_t)((packet[0] << 8) | packet[1]) / 16384.0;
+    q.x = (int16_t)((packet[4] << 8) | packet[5]) / 16384.0;
+    q.y = (int16_t)((packet[8] << 8) | packet[9]) / 16384.0;
+    q.z = (int16_t)((packet[12] << 8) | packet[13]) / 16384.0;
+    return q;
+}
+
+/**
+ * @brief Estatísticas de um intervalo de tempo.
+ *
+ */
+struct Interval
+{
+    uint32_t count = 0;
+    uint32_t min = UINT32_MAX;
+    uint32_t max = 0;
+    uint64_t sum = 0;
+
+    void add(uint32_t value)
+    {
+        count++;
+        sum += value;
+        if(value < min)
+            min = value;
+        if(value > max)
+            max = value;
+    }
+};
+
+int main(int argc, char **argv)
+{
+    if(argc >= 4 && strcmp(argv[1], "extract") == 0)
+        return extract(argv[2], argv[3]);
+
+    if(argc < 2)
+    {
+        fprintf(stderr, "uso: %s extract <captura> <log> | %s <log> [tamanho do pacote] [repeticoes]\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    size_t packetSize = (argc > 2) ? atoi(argv[2]) : 42;
+    int repetitions = (argc > 3) ? atoi(argv[3]) : 100;
+
+    std::vector<uint8_t> log;
+    if(!readFile(argv[1], log))
+    {
+        fprintf(stderr, "nao foi possivel abrir %s\n", argv[1]);
+        return 1;
+    }
+
+    I2Cdev_LogReader reader;
+    I2Cdev_Replayer replayer(log.data(), log.size());
+    if(!reader.begin(log.data(), log.size()) || !replayer.isValid())
+    {
+        fprintf(stderr, "%s nao e um log I2C (versao %d)\n", argv[1], I2CDEV_LOG_VERSION);
+        return 1;
+    }
+
+    // O log é o barramento: cada transação gravada é reenviada pela fila e recebe
+    // a resposta que o sensor deu em campo.
+    I2Cdev_Queue queue(&replayer);
+    I2Cdev_LogRecord record;
+    I2Cdev_Transaction transaction;
+    std::vector<uint8_t> buffer;
+    std::vector<uint8_t> packets;
+
+    uint32_t transactions = 0, failures = 0, divergent = 0;
+    uint32_t dmpBytes = 0, dmpFirst = 0, dmpLast = 0;
+    uint32_t fifoResets = 0, overflowFlags = 0, fullCounts = 0, misaligned = 0, maxCount = 0;
+    uint32_t lastFifoRead = 0, corrupted = 0, firstCorrupted = UINT32_MAX;
+    Interval fifoInterval;
+    uint32_t lastTime = 0;
+
+    while(reader.next(&record))
+    {
+        bool read = (record.flags & I2CDEV_LOG_READ) != 0;
+        buffer.assign(record.length, 0);
+        if(!read)
+            memcpy(buffer.data(), record.data, record.length);
+
+        I2Cdev_Queue::prepare(&transaction, record.devAddr, record.regAddr, read ? I2CDEV_TRANSACTION_READ : 0,
+                              record.length, buffer.data());
+        queue.submit(&transaction);
+        queue.service();
+
+        transactions++;
+        lastTime = record.time;
+        bool success = transaction.status == I2CDEV_TRANSACTION_DONE;
+        if(!success)
+            failures++;
+        if(read && memcmp(buffer.data(), record.data, record.length) != 0)
+            divergent++;
+
+        if(record.devAddr != MPU6050_ADDRESS || !success)
+            continue;
+
+        const uint8_t *data = buffer.data();
+        if(!read && record.regAddr == REG_MEM_R_W)
+        {
+            if(dmpBytes == 0)
+                dmpFirst = record.time;
+            dmpBytes += record.length;
+            dmpLast = record.time;
+        }
+        else if(!read && record.regAddr == REG_USER_CTRL && record.length > 0 && (data[0] & USER_CTRL_FIFO_RESET))
+        {
+            fifoResets++;
+        }
+        else if(read && record.regAddr == REG_INT_STATUS && record.length > 0 && (data[0] & INT_STATUS_FIFO_OFLOW))
+        {
+            overflowFlags++;
+        }
+        else if(read && record.regAddr == REG_FIFO_COUNTH && record.length == 2)
+        {
+            uint32_t count = (data[0] << 8) | data[1];
+            if(count > maxCount)
+                maxCount = count;
+            if(count >= FIFO_SIZE)
+                fullCounts++;
+            else if(count % packetSize != 0)
+                misaligned++;
+        }
+        else if(read && record.regAddr == REG_FIFO_R_W)
+        {
+            if(lastFifoRead != 0)
+                fifoInterval.add(record.time - lastFifoRead);
+            lastFifoRead = record.time;
+
+            for(size_t offset = 0; offset + packetSize <= record.length; offset += packetSize)
+            {
+                Quaternion q = decodePacket(&data[offset]);
+                double norm = sqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+                if(fabs(norm - 1.0) > QUATERNION_TOLERANCE)
+                {
+                    if(corrupted++ == 0)
+                        firstCorrupted = record.time;
+                }
+                packets.insert(packets.end(), &data[offset], &data[offset] + packetSize);
+            }
+        }
+    }
+
+    uint32_t packetCount = packets.size() / packetSize;
+
+    printf("transacoes: %u em %.3f s (%zu bytes de log)%s\n", transactions, lastTime / 1e6, log.size(),
+           reader.isTruncated() ? ", ultimo registro truncado" : "");
+    printf("falhas gravadas: %u | reproducao: %u divergencias, %u leituras diferentes do log\n", failures,
+           replayer.getMismatches(), divergent);
+    if(dmpBytes > 0)
+        printf("carga do DMP: %u bytes em %.1f ms\n", dmpBytes, (dmpLast - dmpFirst) / 1000.0);
+    printf("FIFO: %u resets, %u flags de overflow, %u contagens >= %d, %u contagens fora do pacote de %zu bytes, maior contagem %u\n",
+           fifoResets, overflowFlags, fullCounts, FIFO_SIZE, misaligned, packetSize, maxCount);
+    if(fifoInterval.count > 0)
+        printf("intervalo entre leituras do FIFO (us): min %u | med %.0f | max %u\n", fifoInterval.min,
+               (double)fifoInterval.sum / fifoInterval.count, fifoInterval.max);
+    printf("pacotes: %u, suspeitos de corrupcao: %u", packetCount, corrupted);
+    if(corrupted > 0)
+        printf(" (primeiro em %.6f s)", firstCorrupted / 1e6);
+    printf("\n");
+
+    // Benchmark do decodificador sobre os pacotes reais da captura.
+    if(packetCount > 0 && repetitions > 0)
+    {
+        double checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for(int r = 0; r < repetitions; r++)
+            for(uint32_t i = 0; i < packetCount; i++)
+            {
+                Quaternion q = decodePacket(&packets[i * packetSize]);
+                checksum += q.w + q.x + q.y + q.z;
+            }
+        double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        printf("decodificador: %.1f ns por pacote (%d repeticoes, checksum %.3f)\n",
+               elapsed / ((double)repetitions * packetCount), repetitions, checksum);
+    }
+
+    return (replayer.getMismatches() == 0 && divergent == 0) ? 0 : 2;
+}
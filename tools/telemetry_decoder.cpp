@@ -0,0 +1,162 @@
+/**
+ * @file telemetry_decoder.cpp
+ * @author Carlos Eduardo Marques Assunção Torres (carlos.torres@vido-la.com.br)
+ * @brief Decodificador, para o host, da telemetria binária do firmware NOWT.
+ * Lê o fluxo da serial (ou de um arquivo capturado) e imprime as amostras em CSV.
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Compilação:
+ *   g++ -O2 -I../MPU6050_NOWT/lib/Framing/src telemetry_decoder.cpp \
+ *       ../MPU6050_NOWT/lib/Framing/src/Framing.cpp -o telemetry_decoder
+ *
+ * Uso:
+ *   stty -F /dev/ttyUSB0 115200 raw -echo
+ *   ./telemetry_decoder /dev/ttyUSB0 > amostras.csv
+ */
+#include <cstdio>
+#include <cstring>
+
+#include "Framing.h"
+#include "TelemetryProtocol.h"
+
+const char *g_stateNames[] = {"parado", "em_movimento", "tombado", "tamper"};
+
+/**
+ * @brief Lê um inteiro em little-endian.
+ * 
+ * @param frame Quadro.
+ * @param index Posição de leitura (avança com a leitura).
+ * @param size Quantidade de bytes.
+ * @return uint32_t - Valor lido.
+ */
+uint32_t getLE(const uint8_t *frame, size_t &index, uint8_t size)
+{
+    uint32_t value = 0;
+
+    for(uint8_t i = 0; i < size; i++)
+        value |= (uint32_t)frame[index++] << (8 * i);
+
+    return value;
+}
+
+/**
+ * @brief Retorna o tamanho esperado de um quadro com a máscara informada.
+ * 
+ * @param mask Máscara de campos.
+ * @return size_t - Tamanho do quadro, incluindo o CRC.
+ */
+size_t expectedSize(uint8_t mask)
+{
+    size_t size = TELEMETRY_HEADER_SIZE + TELEMETRY_CRC_SIZE;
+
+    if(mask & TELEMETRY_FIELD_YPR)
+        size += 6;
+    if(mask & TELEMETRY_FIELD_ACC)
+        size += 6;
+    if(mask & TELEMETRY_FIELD_GYRO)
+        size += 6;
+    if(mask & TELEMETRY_FIELD_TEMPERATURE)
+        size += 2;
+    if(mask & TELEMETRY_FIELD_STATE)
+        size += 1;
+
+    return size;
+}
+
+/**
+ * @brief Imprime um valor com escala ou deixa a coluna vazia
+ * caso o campo não esteja presente.
+ */
+void printField(bool present, const uint8_t *frame, size_t &index, double scale)
+{
+    if(present)
+        printf(",%.4f", (int16_t)getLE(frame, index, 2) / scale);
+    else
+        printf(",");
+}
+
+int main(int argc, char **argv)
+{
+    FILE *input = (argc > 1) ? fopen(argv[1], "rb") : stdin;
+
+    if(input == NULL)
+    {
+        fprintf(stderr, "Nao foi possivel abrir %s\n", argv[1]);
+        return 1;
+    }
+
+    uint8_t encoded[256];
+    uint8_t frame[256];
+    size_t encodedSize = 0;
+    bool overflow = false;
+    bool firstFrame = true;
+    uint16_t lastSequence = 0;
+    unsigned long frames = 0, lost = 0, invalid = 0;
+
+    printf("seq,time_ms,yaw,pitch,roll,acc_x,acc_y,acc_z,gyro_x,gyro_y,gyro_z,temperature,state\n");
+
+    int byte;
+    while((byte = fgetc(input)) != EOF)
+    {
+        if(byte != FRAMING_DELIMITER)
+        {
+            // Textos ASCII misturados ao fluxo geram quadros longos, descartados aqui.
+            if(encodedSize < sizeof(encoded))
+                encoded[encodedSize++] = byte;
+            else
+                overflow = true;
+            continue;
+        }
+
+        size_t size = overflow ? 0 : cobsDecode(encoded, encodedSize, frame);
+        encodedSize = 0;
+        overflow = false;
+
+        if(size < TELEMETRY_HEADER_SIZE + TELEMETRY_CRC_SIZE || frame[0] != TELEMETRY_FRAME_SAMPLE ||
+           size != expectedSize(frame[7]) || crc16CCITT(frame, size - TELEMETRY_CRC_SIZE) != (frame[size - 2] | (frame[size - 1] << 8)))
+        {
+            invalid++;
+            continue;
+        }
+
+        size_t index = 1;
+        uint16_t sequence = getLE(frame, index, 2);
+        uint32_t time = getLE(frame, index, 4);
+        uint8_t mask = getLE(frame, index, 1);
+
+        if(!firstFrame)
+            lost += (uint16_t)(sequence - lastSequence - 1);
+        firstFrame = false;
+        lastSequence = sequence;
+        frames++;
+
+        printf("%u,%u", sequence, time);
+        for(uint8_t i = 0; i < 3; i++)
+            printField(mask & TELEMETRY_FIELD_YPR, frame, index, TELEMETRY_YPR_SCALE);
+        for(uint8_t i = 0; i < 3; i++)
+            printField(mask & TELEMETRY_FIELD_ACC, frame, index, TELEMETRY_ACC_SCALE);
+        for(uint8_t i = 0; i < 3; i++)
+            printField(mask & TELEMETRY_FIELD_GYRO, frame, index, TELEMETRY_GYRO_SCALE);
+        printField(mask & TELEMETRY_FIELD_TEMPERATURE, frame, index, TELEMETRY_TEMPERATURE_SCALE);
+
+        if(mask & TELEMETRY_FIELD_STATE)
+        {
+            uint8_t state = getLE(frame, index, 1);
+            printf(",%s\n", (state < 4) ? g_stateNames[state] : "desconhecido");
+        }
+        else
+            printf(",\n");
+
+        fflush(stdout);
+    }
+
+    fprintf(stderr, "Quadros: %lu | Perdidos: %lu | Invalidos: %lu\n", frames, lost, invalid);
+
+    if(input != stdin)
+        fclose(input);
+
+    return 0;
+}